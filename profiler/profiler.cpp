@@ -6,12 +6,33 @@
 #include <sstream>
 #include <string>
 #include <set>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
 
 #include "profiler.hpp"
 
 #include "avl.hpp"
 #include "splay.hpp"
 #include "cartesian.hpp"
+#include "btree.hpp"
+#include "rb.hpp"
+#include "scapegoat.hpp"
+#include "weight_balanced.hpp"
+#include "concurrent_skiplist.hpp"
+#include "art.hpp"
+#include "int_successor_set.hpp"
+#include "zip.hpp"
+#include "wavl.hpp"
+#include "weighted_static.hpp"
+#include "sharded.hpp"
+#include "rcu_avl.hpp"
+#include "concurrent_avl.hpp"
+#include "combining.hpp"
+#include "seqlocked.hpp"
+#include "concurrent_splay.hpp"
+#include "static_set.hpp"
+#include "simd_static_set.hpp"
 
 void write_csv(const std::string& csv_filename,
                const std::vector<profiler::profile_statistic>& result
@@ -35,6 +56,178 @@ void write_csv(const std::string& csv_filename,
     }
 }
 
+void write_memory_csv(const std::string& csv_filename,
+                      const std::vector<profiler::memory_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "tree_size,bytes_per_key,find_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.size          << "," <<
+                     statistic.bytes_per_key << "," <<
+                     statistic.find_time     << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_concurrent_csv(const std::string& csv_filename,
+                          const std::vector<profiler::concurrent_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "threads,throughput\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.threads    << "," <<
+                     statistic.throughput << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_latency_csv(const std::string& csv_filename,
+                       const std::vector<profiler::latency_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "tree_size,p50_insert_time,p99_insert_time,max_insert_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.size            << "," <<
+                     statistic.p50_insert_time << "," <<
+                     statistic.p99_insert_time << "," <<
+                     statistic.max_insert_time << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_read_latency_csv(const std::string& csv_filename,
+                            const std::vector<profiler::read_latency_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "threads,p50_find_time,p99_find_time,max_find_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.threads       << "," <<
+                     statistic.p50_find_time << "," <<
+                     statistic.p99_find_time << "," <<
+                     statistic.max_find_time << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_traversal_csv(const std::string& csv_filename,
+                         const std::vector<profiler::traversal_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "threads,for_each_time,reduce_time,clone_time,iterate_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.threads       << "," <<
+                     statistic.for_each_time << "," <<
+                     statistic.reduce_time   << "," <<
+                     statistic.clone_time    << "," <<
+                     statistic.iterate_time  << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_build_csv(const std::string& csv_filename,
+                     const std::vector<profiler::build_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "threads,build_time,insert_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.threads    << "," <<
+                     statistic.build_time << "," <<
+                     statistic.insert_time << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_batch_csv(const std::string& csv_filename,
+                     const std::vector<profiler::batch_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "batch_size,threads,one_by_one_time,batch_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.batch_size      << "," <<
+                     statistic.threads         << "," <<
+                     statistic.one_by_one_time << "," <<
+                     statistic.batch_time      << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
+void write_access_csv(const std::string& csv_filename,
+                      const std::vector<profiler::access_statistic>& result
+)
+{
+    std::ofstream csv_file(csv_filename, std::ios::out | std::ios::trunc);
+    if (csv_file.is_open())
+    {
+        csv_file << "tree_size,average_depth,find_time\n";
+        for (const auto& statistic : result)
+        {
+            csv_file << statistic.size          << "," <<
+                     statistic.average_depth << "," <<
+                     statistic.find_time     << "\n";
+        }
+    }
+    else
+    {
+        throw std::runtime_error("failed to open a file");
+    }
+}
+
 void profile_avl()
 {
     using profiler::profile;
@@ -52,6 +245,32 @@ void profile_avl()
     write_csv(filename_prefix + "avl.csv", results);
 }
 
+void profile_avl_latency()
+{
+    using profiler::profile_insert_latency;
+    using Tree = tree::avl<int>;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto strict = profile_insert_latency<Tree>([](Tree&) { }, [](Tree&) { },
+                                                     size_start, size_end, size_step,
+                                                     operations_per_step);
+    write_latency_csv(filename_prefix + "avl_latency.csv", strict);
+
+    // the bursts go in unbalanced, the tree is repaired between them
+    auto setup = [](Tree& tree) { tree.set_relaxed(true); };
+    auto idle = [](Tree& tree) { tree.rebalance_step(std::numeric_limits<std::size_t>::max()); };
+    const auto relaxed = profile_insert_latency<Tree>(setup, idle,
+                                                      size_start, size_end, size_step,
+                                                      operations_per_step);
+    write_latency_csv(filename_prefix + "avl_relaxed_latency.csv", relaxed);
+}
+
 void profile_splay()
 {
     using profiler::profile;
@@ -86,6 +305,23 @@ void profile_cartesian()
     write_csv(filename_prefix + "cartesian.csv", results);
 }
 
+void profile_btree()
+{
+    using profiler::profile;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::btree<int>>(size_start, size_end, size_step,
+                                                   operations_per_step);
+
+    write_csv(filename_prefix + "btree.csv", results);
+}
+
 void profile_rb()
 {
     using profiler::profile;
@@ -97,12 +333,588 @@ void profile_rb()
 
     std::string filename_prefix = "results/";
 
+    const auto results = profile<tree::rb<int>>(size_start, size_end, size_step,
+                                                operations_per_step);
+
+    write_csv(filename_prefix + "rb.csv", results);
+}
+
+void profile_scapegoat()
+{
+    using profiler::profile;
+    using profiler::profile_memory;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::scapegoat<int>>(size_start, size_end, size_step,
+                                                       operations_per_step);
+
+    write_csv(filename_prefix + "scapegoat.csv", results);
+
+    // with 4-byte keys the avl balance byte hides in the padding after the key,
+    // 8-byte keys show what it costs
+    const auto avl_memory = profile_memory<tree::avl<std::int64_t>>(size_start, size_end, size_step,
+                                                                     operations_per_step);
+    write_memory_csv(filename_prefix + "avl_memory.csv", avl_memory);
+
+    const auto scapegoat_memory = profile_memory<tree::scapegoat<std::int64_t>>(size_start, size_end, size_step,
+                                                                                operations_per_step);
+    write_memory_csv(filename_prefix + "scapegoat_memory.csv", scapegoat_memory);
+}
+
+void profile_weight_balanced()
+{
+    using profiler::profile;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::weight_balanced<int>>(size_start, size_end, size_step,
+                                                             operations_per_step);
+
+    write_csv(filename_prefix + "weight_balanced.csv", results);
+}
+
+void profile_skiplist()
+{
+    using profiler::profile;
+    using profiler::profile_concurrent;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::concurrent_skiplist<int>>(size_start, size_end, size_step,
+                                                                 operations_per_step);
+
+    write_csv(filename_prefix + "skiplist.csv", results);
+
+    // scaling against the global mutex around avl used so far
+    std::size_t size = 100'000;
+    std::size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+    std::size_t operations_per_thread = 200'000;
+
+    const auto skiplist_results = profile_concurrent<tree::concurrent_skiplist<int>>(size, max_threads,
+                                                                                     operations_per_thread);
+    write_concurrent_csv(filename_prefix + "skiplist_threads.csv", skiplist_results);
+
+    const auto avl_results = profile_concurrent<profiler::mutex_guarded<tree::avl<int>>>(size, max_threads,
+                                                                                         operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_mutex_threads.csv", avl_results);
+}
+
+// every tree behind per-range locks against the one global mutex around avl
+void profile_sharded()
+{
+    using profiler::profile_concurrent;
+
+    std::size_t size = 100'000;
+    std::size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+    std::size_t operations_per_thread = 200'000;
+
+    std::string filename_prefix = "results/";
+
+    const auto avl_results = profile_concurrent<tree::sharded<tree::avl<int>>>(size, max_threads,
+                                                                               operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_sharded_threads.csv", avl_results);
+
+    const auto splay_results = profile_concurrent<tree::sharded<tree::splay<int>>>(size, max_threads,
+                                                                                   operations_per_thread);
+    write_concurrent_csv(filename_prefix + "splay_sharded_threads.csv", splay_results);
+
+    const auto cartesian_results = profile_concurrent<tree::sharded<tree::cartesian<int>>>(size, max_threads,
+                                                                                           operations_per_thread);
+    write_concurrent_csv(filename_prefix + "cartesian_sharded_threads.csv", cartesian_results);
+
+    const auto mutex_results = profile_concurrent<profiler::mutex_guarded<tree::avl<int>>>(size, max_threads,
+                                                                                           operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_mutex_threads.csv", mutex_results);
+}
+
+void profile_rcu()
+{
+    using profiler::profile_readers;
+
+    std::size_t size = 100'000;
+    std::size_t max_readers = std::max(4u, std::thread::hardware_concurrency());
+    std::size_t operations_per_reader = 500'000;
+
+    std::string filename_prefix = "results/";
+
+    const auto rcu_results = profile_readers<tree::rcu_avl<int>>(size, max_readers, operations_per_reader);
+    write_concurrent_csv(filename_prefix + "avl_rcu_readers.csv", rcu_results);
+
+    const auto rw_results = profile_readers<profiler::rw_guarded<tree::avl<int>>>(size, max_readers,
+                                                                                  operations_per_reader);
+    write_concurrent_csv(filename_prefix + "avl_rwlock_readers.csv", rw_results);
+}
+
+void profile_concurrent_avl()
+{
+    using profiler::profile_concurrent;
+
+    std::size_t size = 100'000;
+    std::size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+    std::size_t operations_per_thread = 200'000;
+
+    std::string filename_prefix = "results/";
+
+    const auto concurrent_results = profile_concurrent<tree::concurrent_avl<int>>(size, max_threads,
+                                                                                  operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_concurrent_threads.csv", concurrent_results);
+
+    const auto mutex_results = profile_concurrent<profiler::mutex_guarded<tree::avl<int>>>(size, max_threads,
+                                                                                           operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_mutex_threads.csv", mutex_results);
+}
+
+void profile_combining()
+{
+    using profiler::profile_concurrent;
+
+    // combining pays off with many threads on one lock, so the thread count goes well past the cores
+    std::size_t size = 100'000;
+    std::size_t max_threads = 64;
+    std::size_t operations_per_thread = 10'000;
+
+    std::string filename_prefix = "results/";
+
+    const auto avl_results = profile_concurrent<tree::combining<tree::avl<int>>>(size, max_threads,
+                                                                                 operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_combining_threads.csv", avl_results);
+
+    const auto cartesian_results = profile_concurrent<tree::combining<tree::cartesian<int>>>(size, max_threads,
+                                                                                             operations_per_thread);
+    write_concurrent_csv(filename_prefix + "cartesian_combining_threads.csv", cartesian_results);
+
+    const auto avl_mutex_results = profile_concurrent<profiler::mutex_guarded<tree::avl<int>>>(size, max_threads,
+                                                                                               operations_per_thread);
+    write_concurrent_csv(filename_prefix + "avl_mutex_64_threads.csv", avl_mutex_results);
+
+    const auto cartesian_mutex_results = profile_concurrent<profiler::mutex_guarded<tree::cartesian<int>>>(
+        size, max_threads, operations_per_thread);
+    write_concurrent_csv(filename_prefix + "cartesian_mutex_64_threads.csv", cartesian_mutex_results);
+}
+
+void profile_seqlocked()
+{
+    using profiler::profile_read_latency;
+
+    std::size_t size = 100'000;
+    std::size_t max_readers = std::max(4u, std::thread::hardware_concurrency());
+    std::size_t operations_per_reader = 200'000;
+
+    std::string filename_prefix = "results/";
+
+    const auto avl_results = profile_read_latency<tree::seqlocked<tree::avl<int>>>(size, max_readers,
+                                                                                   operations_per_reader);
+    write_read_latency_csv(filename_prefix + "avl_seqlocked_read_latency.csv", avl_results);
+
+    const auto cartesian_results = profile_read_latency<tree::seqlocked<tree::cartesian<int>>>(size, max_readers,
+                                                                                               operations_per_reader);
+    write_read_latency_csv(filename_prefix + "cartesian_seqlocked_read_latency.csv", cartesian_results);
+
+    const auto rw_results = profile_read_latency<profiler::rw_guarded<tree::avl<int>>>(size, max_readers,
+                                                                                       operations_per_reader);
+    write_read_latency_csv(filename_prefix + "avl_rwlock_read_latency.csv", rw_results);
+}
+
+void profile_concurrent_splay()
+{
+    using profiler::profile_readers;
+
+    std::size_t size = 100'000;
+    std::size_t max_readers = std::max(4u, std::thread::hardware_concurrency());
+    std::size_t operations_per_reader = 500'000;
+
+    std::string filename_prefix = "results/";
+
+    const auto deferred_results = profile_readers<tree::concurrent_splay<int>>(size, max_readers,
+                                                                               operations_per_reader);
+    write_concurrent_csv(filename_prefix + "splay_deferred_readers.csv", deferred_results);
+
+    // a splay tree restructures on every find, so a mutex is the only other way to share it
+    const auto mutex_results = profile_readers<profiler::mutex_guarded<tree::splay<int>>>(size, max_readers,
+                                                                                          operations_per_reader);
+    write_concurrent_csv(filename_prefix + "splay_mutex_readers.csv", mutex_results);
+}
+
+// apply_batch against the same operations one by one, serially and on every core
+void profile_batch()
+{
+    using profiler::profile_batch;
+
+    std::size_t size = 1'000'000;
+    std::size_t batch_size_start = 1000;
+    std::size_t batch_size_end = 1'000'000;
+    std::size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+    std::string filename_prefix = "results/";
+
+    for (std::size_t threads : {std::size_t(1), max_threads})
+    {
+        const auto suffix = "_batch_" + std::to_string(threads) + "_threads.csv";
+
+        const auto avl_results = profile_batch<tree::avl<int>>(size, batch_size_start, batch_size_end, threads);
+        write_batch_csv(filename_prefix + "avl" + suffix, avl_results);
+
+        const auto cartesian_results = profile_batch<tree::cartesian<int>>(size, batch_size_start, batch_size_end,
+                                                                           threads);
+        write_batch_csv(filename_prefix + "cartesian" + suffix, cartesian_results);
+    }
+}
+
+// from_unsorted on 1 to 32 threads against as many inserts one by one; several GB and
+// minutes of inserts, so it only runs on its own kind, not with all
+void profile_from_unsorted()
+{
+    using profiler::profile_build;
+
+    std::size_t size = 100'000'000;
+    std::size_t max_threads = 32;
+
+    std::string filename_prefix = "results/";
+
+    const auto avl_results = profile_build<tree::avl<int>>(size, max_threads);
+    write_build_csv(filename_prefix + "avl_from_unsorted.csv", avl_results);
+
+    const auto cartesian_results = profile_build<tree::cartesian<int>>(size, max_threads);
+    write_build_csv(filename_prefix + "cartesian_from_unsorted.csv", cartesian_results);
+
+    const auto splay_results = profile_build<tree::splay<int>>(size, max_threads);
+    write_build_csv(filename_prefix + "splay_from_unsorted.csv", splay_results);
+}
+
+// full scans of 50M keys on 1 to 32 threads against a range-for; like from_unsorted
+// too large for all, it only runs on its own kind
+void profile_traversal()
+{
+    using profiler::profile_traversal;
+
+    std::size_t size = 50'000'000;
+    std::size_t max_threads = 32;
+
+    std::string filename_prefix = "results/";
+
+    const auto avl_results = profile_traversal<tree::avl<int>>(size, max_threads);
+    write_traversal_csv(filename_prefix + "avl_traversal.csv", avl_results);
+
+    const auto cartesian_results = profile_traversal<tree::cartesian<int>>(size, max_threads);
+    write_traversal_csv(filename_prefix + "cartesian_traversal.csv", cartesian_results);
+
+    const auto splay_results = profile_traversal<tree::splay<int>>(size, max_threads);
+    write_traversal_csv(filename_prefix + "splay_traversal.csv", splay_results);
+}
+
+void profile_art()
+{
+    using profiler::profile;
+    using profiler::profile_strings;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::art<int>>(size_start, size_end, size_step,
+                                                 operations_per_step);
+
+    write_csv(filename_prefix + "art.csv", results);
+
+    // short string keys, against the comparison-based std::set
+    std::size_t key_length = 16;
+
+    const auto art_string_results = profile_strings<tree::art<std::string>>(size_start, size_end, size_step,
+                                                                            operations_per_step, key_length);
+    write_csv(filename_prefix + "art_string.csv", art_string_results);
+
+    const auto set_string_results = profile_strings<std::set<std::string>>(size_start, size_end, size_step,
+                                                                           operations_per_step, key_length);
+    write_csv(filename_prefix + "set_string.csv", set_string_results);
+}
+
+void profile_int_successor_set()
+{
+    using profiler::profile;
+    using profiler::profile_memory;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    // the random ints of the other trees, reinterpreted as 32-bit ids
+    const auto results = profile<tree::int_successor_set<32>>(size_start, size_end, size_step,
+                                                              operations_per_step);
+
+    write_csv(filename_prefix + "int_successor_set.csv", results);
+
+    const auto memory = profile_memory<tree::int_successor_set<32>>(size_start, size_end, size_step,
+                                                                    operations_per_step);
+    write_memory_csv(filename_prefix + "int_successor_set_memory.csv", memory);
+}
+
+void profile_zip()
+{
+    using profiler::profile;
+    using profiler::profile_memory;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::zip<int>>(size_start, size_end, size_step,
+                                                 operations_per_step);
+
+    write_csv(filename_prefix + "zip.csv", results);
+
+    // byte ranks against the int priorities of cartesian: with 4-byte keys
+    // a zip node is 24 bytes and a cartesian one 32
+    const auto cartesian_memory = profile_memory<tree::cartesian<int>>(size_start, size_end, size_step,
+                                                                       operations_per_step);
+    write_memory_csv(filename_prefix + "cartesian_memory.csv", cartesian_memory);
+
+    const auto zip_memory = profile_memory<tree::zip<int>>(size_start, size_end, size_step,
+                                                           operations_per_step);
+    write_memory_csv(filename_prefix + "zip_memory.csv", zip_memory);
+}
+
+void profile_wavl()
+{
+    using profiler::profile;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    const auto results = profile<tree::wavl<int>>(size_start, size_end, size_step,
+                                                  operations_per_step);
+
+    write_csv(filename_prefix + "wavl.csv", results);
+}
+
+void profile_weighted_static()
+{
+    using profiler::profile_access_depth;
+    using Keys = std::vector<int>;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 50000;
+    std::size_t operations_per_step = 100'000;
+    double exponent = 1.0;
+
+    std::string filename_prefix = "results/";
+
+    auto build_avl = [](const Keys& keys, const Keys&)
+    {
+        tree::avl<int> tree;
+        for (const auto& key : keys)
+        {
+            tree.insert(key);
+        }
+        return tree;
+    };
+
+    // splay adapts while the training lookups run
+    auto build_splay = [](const Keys& keys, const Keys& training)
+    {
+        tree::splay<int> tree;
+        for (const auto& key : keys)
+        {
+            tree.insert(key);
+        }
+        for (const auto& key : training)
+        {
+            tree.find(key);
+        }
+        return tree;
+    };
+
+    // the training lookups are counted by an avl and its weights shape the static tree
+    auto build_weighted_static = [](const Keys& keys, const Keys& training)
+    {
+        tree::avl<int> counted;
+        for (const auto& key : keys)
+        {
+            counted.insert(key);
+        }
+        counted.set_access_counting(true);
+        for (const auto& key : training)
+        {
+            counted.find(key);
+        }
+        const auto weights = counted.access_weights();
+        return tree::weighted_static<int>(weights.begin(), weights.end());
+    };
+
+    const auto avl_results = profile_access_depth<tree::avl<int>>(build_avl, size_start, size_end, size_step,
+                                                                  operations_per_step, exponent);
+    write_access_csv(filename_prefix + "avl_access.csv", avl_results);
+
+    const auto splay_results = profile_access_depth<tree::splay<int>>(build_splay, size_start, size_end, size_step,
+                                                                      operations_per_step, exponent);
+    write_access_csv(filename_prefix + "splay_access.csv", splay_results);
+
+    const auto weighted_results = profile_access_depth<tree::weighted_static<int>>(build_weighted_static,
+                                                                                  size_start, size_end, size_step,
+                                                                                  operations_per_step, exponent);
+    write_access_csv(filename_prefix + "weighted_static_access.csv", weighted_results);
+}
+
+// finds drawn from a Zipf law on the plain treap, the frequency-biased one and splay;
+// every tree sees the same number of training finds before the measured ones
+void profile_cartesian_frequency()
+{
+    using profiler::profile_access_depth;
+    using Keys = std::vector<int>;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 50000;
+    std::size_t operations_per_step = 100'000;
+    double exponent = 1.0;
+
+    std::string filename_prefix = "results/";
+
+    auto build_cartesian = [](const Keys& keys, const Keys&)
+    {
+        tree::cartesian<int> tree;
+        for (const auto& key : keys)
+        {
+            tree.insert(key);
+        }
+        return tree;
+    };
+
+    auto build_frequency_biased = [](const Keys& keys, const Keys& training)
+    {
+        tree::cartesian<int> tree;
+        for (const auto& key : keys)
+        {
+            tree.insert(key);
+        }
+        tree.set_frequency_biased(true);
+        for (const auto& key : training)
+        {
+            tree.find(key);
+        }
+        return tree;
+    };
+
+    auto build_splay = [](const Keys& keys, const Keys& training)
+    {
+        tree::splay<int> tree;
+        for (const auto& key : keys)
+        {
+            tree.insert(key);
+        }
+        for (const auto& key : training)
+        {
+            tree.find(key);
+        }
+        return tree;
+    };
+
+    const auto cartesian_results = profile_access_depth<tree::cartesian<int>>(build_cartesian,
+                                                                              size_start, size_end, size_step,
+                                                                              operations_per_step, exponent);
+    write_access_csv(filename_prefix + "cartesian_zipf.csv", cartesian_results);
+
+    const auto biased_results = profile_access_depth<tree::cartesian<int>>(build_frequency_biased,
+                                                                           size_start, size_end, size_step,
+                                                                           operations_per_step, exponent);
+    write_access_csv(filename_prefix + "cartesian_frequency_zipf.csv", biased_results);
+
+    const auto splay_results = profile_access_depth<tree::splay<int>>(build_splay, size_start, size_end, size_step,
+                                                                      operations_per_step, exponent);
+    write_access_csv(filename_prefix + "splay_zipf.csv", splay_results);
+}
+
+void profile_set()
+{
+    using profiler::profile;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
     const auto results = profile<std::set<int>>(size_start, size_end, size_step,
                                                 operations_per_step);
 
     write_csv(filename_prefix + "set.csv", results);
 }
 
+void profile_static()
+{
+    using profiler::profile_frozen;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    auto freeze = [](const tree::avl<int>& source) { return source.freeze(); };
+    const auto results = profile_frozen<tree::avl<int>>(freeze, size_start, size_end, size_step,
+                                                        operations_per_step);
+
+    write_csv(filename_prefix + "static.csv", results);
+}
+
+void profile_simd()
+{
+    using profiler::profile_frozen;
+    using profiler::profile_frozen_batch;
+
+    std::size_t size_start = 10000;
+    std::size_t size_end = 1'000'000;
+    std::size_t size_step = 10000;
+    std::size_t operations_per_step = 1000;
+
+    std::string filename_prefix = "results/";
+
+    // built from the same tree as avl.csv measures, so the curves are directly comparable
+    auto freeze = [](const tree::avl<int>& source)
+    {
+        return tree::simd_static_set<int>(source.begin(), source.end());
+    };
+
+    const auto results = profile_frozen<tree::avl<int>>(freeze, size_start, size_end, size_step,
+                                                        operations_per_step);
+    write_csv(filename_prefix + "simd.csv", results);
+
+    const auto batch_results = profile_frozen_batch<tree::avl<int>>(freeze, size_start, size_end, size_step,
+                                                                    operations_per_step);
+    write_csv(filename_prefix + "simd_batch.csv", batch_results);
+}
+
 int main(int argc, char* argv[])
 {
     std::string what_tree;
@@ -122,6 +934,7 @@ int main(int argc, char* argv[])
     if (what_tree == "avl")
     {
         profile_avl();
+        profile_avl_latency();
     }
     else if(what_tree == "splay")
     {
@@ -131,17 +944,123 @@ int main(int argc, char* argv[])
     else if(what_tree == "cartesian")
     {
         profile_cartesian();
+        profile_cartesian_frequency();
+    }
+    else if(what_tree == "zip")
+    {
+        profile_zip();
+    }
+    else if(what_tree == "wavl")
+    {
+        profile_wavl();
+    }
+    else if(what_tree == "weighted_static")
+    {
+        profile_weighted_static();
+    }
+    else if(what_tree == "btree")
+    {
+        profile_btree();
     }
     else if(what_tree == "rb")
     {
         profile_rb();
     }
+    else if(what_tree == "scapegoat")
+    {
+        profile_scapegoat();
+    }
+    else if(what_tree == "weight_balanced")
+    {
+        profile_weight_balanced();
+    }
+    else if(what_tree == "skiplist")
+    {
+        profile_skiplist();
+    }
+    else if(what_tree == "sharded")
+    {
+        profile_sharded();
+    }
+    else if(what_tree == "rcu")
+    {
+        profile_rcu();
+    }
+    else if(what_tree == "concurrent_avl")
+    {
+        profile_concurrent_avl();
+    }
+    else if(what_tree == "combining")
+    {
+        profile_combining();
+    }
+    else if(what_tree == "seqlocked")
+    {
+        profile_seqlocked();
+    }
+    else if(what_tree == "concurrent_splay")
+    {
+        profile_concurrent_splay();
+    }
+    else if(what_tree == "batch")
+    {
+        profile_batch();
+    }
+    else if(what_tree == "from_unsorted")
+    {
+        profile_from_unsorted();
+    }
+    else if(what_tree == "traversal")
+    {
+        profile_traversal();
+    }
+    else if(what_tree == "art")
+    {
+        profile_art();
+    }
+    else if(what_tree == "int_successor_set")
+    {
+        profile_int_successor_set();
+    }
+    else if(what_tree == "set")
+    {
+        profile_set();
+    }
+    else if(what_tree == "static")
+    {
+        profile_static();
+    }
+    else if(what_tree == "simd")
+    {
+        profile_simd();
+    }
     else if(what_tree == "all")
     {
         profile_avl();
+        profile_avl_latency();
         profile_splay();
         profile_cartesian();
+        profile_cartesian_frequency();
+        profile_btree();
         profile_rb();
+        profile_set();
+        profile_scapegoat();
+        profile_weight_balanced();
+        profile_skiplist();
+        profile_sharded();
+        profile_rcu();
+        profile_concurrent_avl();
+        profile_combining();
+        profile_seqlocked();
+        profile_concurrent_splay();
+        profile_batch();
+        profile_art();
+        profile_int_successor_set();
+        profile_zip();
+        profile_wavl();
+        profile_weighted_static();
+        profile_static();
+        profile_simd();
     }
     else
     {
@@ -5,8 +5,24 @@
 #include <optional>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include <random>
 #include <limits>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "detail/batch.hpp"
+#include "execution.hpp"
 
 namespace profiler
 {
@@ -50,6 +66,179 @@ namespace profiler
         double erase_time;
     };
 
+    struct memory_statistic
+    {
+        std::size_t size;
+        double bytes_per_key;
+        double find_time;
+    };
+
+    struct latency_statistic
+    {
+        std::size_t size;
+        double p50_insert_time;
+        double p99_insert_time;
+        double max_insert_time;
+    };
+
+    struct access_statistic
+    {
+        std::size_t size;
+        double average_depth; // nodes visited per lookup, the root included
+        double find_time;
+    };
+
+    struct concurrent_statistic
+    {
+        std::size_t threads;
+        double throughput; // operations per second, all threads together
+    };
+
+    struct read_latency_statistic
+    {
+        std::size_t threads;
+        double p50_find_time;
+        double p99_find_time;
+        double max_find_time;
+    };
+
+    struct build_statistic
+    {
+        std::size_t threads;
+        double build_time;  // from_unsorted
+        double insert_time; // the same keys one by one, on one thread
+    };
+
+    struct traversal_statistic
+    {
+        std::size_t threads;
+        double for_each_time;
+        double reduce_time;
+        double clone_time;
+        double iterate_time; // a range-for over the same tree, on one thread
+    };
+
+    struct batch_statistic
+    {
+        std::size_t batch_size;
+        std::size_t threads;
+        double one_by_one_time; // per operation
+        double batch_time;      // per operation
+    };
+
+    // Serializes a sequential tree behind one mutex, the baseline for concurrent containers.
+    template <typename Tree>
+    class mutex_guarded
+    {
+    public:
+        using key_type = typename Tree::key_type;
+
+        void insert(const key_type& key)
+        {
+            std::lock_guard lock(mutex);
+            tree.insert(key);
+        }
+
+        void erase(const key_type& key)
+        {
+            std::lock_guard lock(mutex);
+            tree.erase(key);
+        }
+
+        bool contains(const key_type& key)
+        {
+            std::lock_guard lock(mutex);
+            return tree.find(key) != tree.end();
+        }
+
+        std::size_t size()
+        {
+            std::lock_guard lock(mutex);
+            return tree.size();
+        }
+
+    private:
+        std::mutex mutex;
+        Tree tree;
+    };
+
+    // The same behind a reader-writer lock: lookups share it, so Tree's const find must not write.
+    template <typename Tree>
+    class rw_guarded
+    {
+    public:
+        using key_type = typename Tree::key_type;
+
+        void insert(const key_type& key)
+        {
+            std::unique_lock lock(mutex);
+            tree.insert(key);
+        }
+
+        void erase(const key_type& key)
+        {
+            std::unique_lock lock(mutex);
+            tree.erase(key);
+        }
+
+        bool contains(const key_type& key)
+        {
+            std::shared_lock lock(mutex);
+            const Tree& shared = tree;
+            return shared.find(key) != shared.end();
+        }
+
+        std::size_t size()
+        {
+            std::shared_lock lock(mutex);
+            return tree.size();
+        }
+
+    private:
+        std::shared_mutex mutex;
+        Tree tree;
+    };
+
+    // Ranks 0..n-1 drawn with probability proportional to 1 / (rank + 1)^exponent.
+    class zipf_distribution
+    {
+    public:
+        zipf_distribution(std::size_t n, double exponent) : cdf(n)
+        {
+            double total = 0;
+            for (std::size_t rank = 0; rank < n; rank++)
+            {
+                total += 1.0 / std::pow(static_cast<double>(rank + 1), exponent);
+                cdf[rank] = total;
+            }
+            for (auto& value : cdf)
+            {
+                value /= total;
+            }
+        }
+
+        template <typename Generator>
+        std::size_t operator () (Generator& gen) const
+        {
+            const double value = std::uniform_real_distribution<>(0.0, 1.0)(gen);
+            const auto rank = std::upper_bound(cdf.begin(), cdf.end(), value) - cdf.begin();
+            return std::min(static_cast<std::size_t>(rank), cdf.size() - 1);
+        }
+
+    private:
+        std::vector<double> cdf;
+    };
+
+    // bytes handed out by malloc including its chunk headers and rounding, 0 if unknown
+    inline std::size_t heap_in_use()
+    {
+#if defined(__GLIBC__)
+        return mallinfo2().uordblks;
+#else
+        return 0;
+#endif
+    }
+
     template <typename Tree>
     std::vector<profile_statistic> profile(std::size_t size_start,
                                            std::size_t size_end,
@@ -116,4 +305,917 @@ namespace profiler
         return results;
     }
 
+    // Same as profile, on random strings of key_length lowercase letters
+    // that share a common first half, like keys with a common namespace.
+    template <typename Tree>
+    std::vector<profile_statistic> profile_strings(std::size_t size_start,
+                                                   std::size_t size_end,
+                                                   std::size_t size_step,
+                                                   std::size_t operations_per_step,
+                                                   std::size_t key_length
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        std::uniform_int_distribution<> char_dist('a', 'z');
+        const std::string common(key_length / 2, 'k');
+        auto get_random_key = [&]()
+        {
+            std::string key = common;
+            while (key.size() < key_length)
+            {
+                key.push_back(static_cast<char>(char_dist(gen)));
+            }
+            return key;
+        };
+
+        Tree tree;
+
+        auto update_size = [&](std::size_t new_size)
+        {
+            while (tree.size() != new_size)
+            {
+                auto key = get_random_key();
+                tree.insert(key);
+            }
+        };
+
+        std::vector<profile_statistic> results;
+
+        for (std::size_t size = size_start; size < size_end; size += size_step)
+        {
+            update_size(size);
+            double total_insert_time = 0;
+            double total_erase_time = 0;
+            double total_find_time = 0;
+
+            for (std::size_t i = 0; i < operations_per_step; i++)
+            {
+                auto key = get_random_key();
+
+                {
+                    ACCUMULATE_DURATION(total_insert_time);
+                    tree.insert(key);
+                }
+
+                {
+                    ACCUMULATE_DURATION(total_find_time);
+                    tree.find(key);
+                }
+
+                {
+                    ACCUMULATE_DURATION(total_erase_time);
+                    tree.erase(key);
+                }
+            }
+            double average_insert_time = total_insert_time / operations_per_step;
+            double average_find_time = total_find_time / operations_per_step;
+            double average_erase_time = total_erase_time / operations_per_step;
+
+            results.push_back({size, average_insert_time, average_find_time, average_erase_time});
+        }
+
+        return results;
+    }
+
+    // Immutable snapshots cannot be updated in place: the mutable Tree is grown to each size,
+    // converted with freeze(tree) and only lookups are timed; insert and erase times stay zero.
+    template <typename Tree, typename Freeze>
+    std::vector<profile_statistic> profile_frozen(Freeze freeze,
+                                                  std::size_t size_start,
+                                                  std::size_t size_end,
+                                                  std::size_t size_step,
+                                                  std::size_t operations_per_step
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+        auto get_random_key = [&]() { return key_dist(gen); };
+
+        Tree tree;
+
+        auto update_size = [&](std::size_t new_size)
+        {
+            while (tree.size() != new_size)
+            {
+                auto key = get_random_key();
+                tree.insert(key);
+            }
+        };
+
+        std::vector<profile_statistic> results;
+
+        for (std::size_t size = size_start; size < size_end; size += size_step)
+        {
+            update_size(size);
+            const auto frozen = freeze(tree);
+            double total_find_time = 0;
+
+            for (std::size_t i = 0; i < operations_per_step; i++)
+            {
+                auto key = get_random_key();
+
+                {
+                    ACCUMULATE_DURATION(total_find_time);
+                    frozen.find(key);
+                }
+            }
+            double average_find_time = total_find_time / operations_per_step;
+
+            results.push_back({size, 0.0, average_find_time, 0.0});
+        }
+
+        return results;
+    }
+
+    // Same as profile_frozen, but the keys of a step are looked up with one batch_contains call.
+    template <typename Tree, typename Freeze>
+    std::vector<profile_statistic> profile_frozen_batch(Freeze freeze,
+                                                        std::size_t size_start,
+                                                        std::size_t size_end,
+                                                        std::size_t size_step,
+                                                        std::size_t operations_per_step
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+        auto get_random_key = [&]() { return key_dist(gen); };
+
+        Tree tree;
+
+        auto update_size = [&](std::size_t new_size)
+        {
+            while (tree.size() != new_size)
+            {
+                auto key = get_random_key();
+                tree.insert(key);
+            }
+        };
+
+        std::vector<profile_statistic> results;
+        std::vector<int> keys(operations_per_step);
+        std::unique_ptr<bool[]> found(new bool[operations_per_step]);
+
+        for (std::size_t size = size_start; size < size_end; size += size_step)
+        {
+            update_size(size);
+            const auto frozen = freeze(tree);
+            double total_find_time = 0;
+
+            for (auto& key : keys)
+            {
+                key = get_random_key();
+            }
+
+            {
+                ACCUMULATE_DURATION(total_find_time);
+                frozen.batch_contains(keys.data(), keys.size(), found.get());
+            }
+            double average_find_time = total_find_time / operations_per_step;
+
+            results.push_back({size, 0.0, average_find_time, 0.0});
+        }
+
+        return results;
+    }
+
+    // Heap bytes per key of a Tree grown to each size, with the lookup time at that size.
+    template <typename Tree>
+    std::vector<memory_statistic> profile_memory(std::size_t size_start,
+                                                 std::size_t size_end,
+                                                 std::size_t size_step,
+                                                 std::size_t operations_per_step
+    )
+    {
+        using key_type = typename Tree::key_type;
+
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+        auto get_random_key = [&]() { return static_cast<key_type>(key_dist(gen)); };
+
+        std::vector<memory_statistic> results;
+        results.reserve((size_end - size_start) / size_step + 1);
+
+        const std::size_t heap_start = heap_in_use();
+        Tree tree;
+
+        auto update_size = [&](std::size_t new_size)
+        {
+            while (tree.size() != new_size)
+            {
+                auto key = get_random_key();
+                tree.insert(key);
+            }
+        };
+
+        for (std::size_t size = size_start; size < size_end; size += size_step)
+        {
+            update_size(size);
+            const double bytes_per_key = static_cast<double>(heap_in_use() - heap_start) / size;
+            double total_find_time = 0;
+
+            for (std::size_t i = 0; i < operations_per_step; i++)
+            {
+                auto key = get_random_key();
+
+                {
+                    ACCUMULATE_DURATION(total_find_time);
+                    tree.find(key);
+                }
+            }
+            double average_find_time = total_find_time / operations_per_step;
+
+            results.push_back({size, bytes_per_key, average_find_time});
+        }
+
+        return results;
+    }
+
+    // Insert latency percentiles of a Tree at each size: every step is a burst of
+    // operations_per_step inserts timed one by one, then erased again untimed and followed
+    // by idle(tree), the place for deferred work such as rebalancing between bursts.
+    template <typename Tree, typename Setup, typename Idle>
+    std::vector<latency_statistic> profile_insert_latency(Setup setup,
+                                                          Idle idle,
+                                                          std::size_t size_start,
+                                                          std::size_t size_end,
+                                                          std::size_t size_step,
+                                                          std::size_t operations_per_step
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+        auto get_random_key = [&]() { return key_dist(gen); };
+
+        Tree tree;
+        setup(tree);
+
+        auto update_size = [&](std::size_t new_size)
+        {
+            while (tree.size() != new_size)
+            {
+                auto key = get_random_key();
+                tree.insert(key);
+            }
+        };
+
+        std::vector<latency_statistic> results;
+        std::vector<int> keys(operations_per_step);
+        std::vector<double> insert_times(operations_per_step);
+
+        for (std::size_t size = size_start; size < size_end; size += size_step)
+        {
+            update_size(size);
+            idle(tree);
+
+            for (auto& key : keys)
+            {
+                key = get_random_key();
+            }
+
+            for (std::size_t i = 0; i < operations_per_step; i++)
+            {
+                insert_times[i] = 0;
+                {
+                    ACCUMULATE_DURATION(insert_times[i]);
+                    tree.insert(keys[i]);
+                }
+            }
+
+            for (const auto& key : keys)
+            {
+                tree.erase(key);
+            }
+            idle(tree);
+
+            auto percentile = [&](double fraction)
+            {
+                const auto index = static_cast<std::size_t>(fraction * static_cast<double>(operations_per_step - 1));
+                std::nth_element(insert_times.begin(), insert_times.begin() + index, insert_times.end());
+                return insert_times[index];
+            };
+
+            const double p50 = percentile(0.5);
+            const double p99 = percentile(0.99);
+            const double max = *std::max_element(insert_times.begin(), insert_times.end());
+            results.push_back({size, p50, p99, max});
+        }
+
+        return results;
+    }
+
+    // Average depth and lookup time of Tree under Zipf-distributed lookups of its keys. At each size
+    // build(keys, training) makes the tree from shuffled keys, where training is a sample
+    // of the same lookups for trees that adapt to them or count them.
+    template <typename Tree, typename Build>
+    std::vector<access_statistic> profile_access_depth(Build build,
+                                                       std::size_t size_start,
+                                                       std::size_t size_end,
+                                                       std::size_t size_step,
+                                                       std::size_t operations_per_step,
+                                                       double exponent
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+
+        std::vector<access_statistic> results;
+        std::vector<int> training(operations_per_step);
+        std::vector<int> lookups(operations_per_step);
+
+        for (std::size_t size = size_start; size < size_end; size += size_step)
+        {
+            std::vector<int> keys;
+            while (keys.size() != size)
+            {
+                while (keys.size() != size)
+                {
+                    keys.push_back(key_dist(gen));
+                }
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            }
+
+            // popularity independent of the insertion order, or the hot keys would be inserted first
+            std::vector<int> by_rank = keys;
+            std::shuffle(by_rank.begin(), by_rank.end(), gen);
+            std::shuffle(keys.begin(), keys.end(), gen);
+
+            const zipf_distribution zipf(size, exponent);
+            for (auto& key : training)
+            {
+                key = by_rank[zipf(gen)];
+            }
+            for (auto& key : lookups)
+            {
+                key = by_rank[zipf(gen)];
+            }
+
+            Tree tree = build(keys, training);
+
+            double total_depth = 0;
+            double total_find_time = 0;
+            for (const auto& key : lookups)
+            {
+                total_depth += static_cast<double>(tree.depth(key));
+                {
+                    ACCUMULATE_DURATION(total_find_time);
+                    tree.find(key);
+                }
+            }
+
+            results.push_back({size, total_depth / operations_per_step, total_find_time / operations_per_step});
+        }
+
+        return results;
+    }
+
+    // Throughput of Tree shared by 1..max_threads threads, each running operations_per_thread
+    // random operations (half lookups, a quarter inserts, a quarter erases) on a tree of about size keys.
+    template <typename Tree>
+    std::vector<concurrent_statistic> profile_concurrent(std::size_t size,
+                                                         std::size_t max_threads,
+                                                         std::size_t operations_per_thread
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+
+        // keys are drawn from twice the size, so inserts and erases balance out
+        const int key_max = static_cast<int>(2 * size);
+
+        std::vector<concurrent_statistic> results;
+
+        for (std::size_t threads_count = 1; threads_count <= max_threads; threads_count++)
+        {
+            Tree tree;
+            {
+                std::mt19937 gen(seed);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                while (tree.size() < size)
+                {
+                    tree.insert(key_dist(gen));
+                }
+            }
+
+            std::atomic<std::size_t> ready{0};
+            std::atomic<bool> start{false};
+
+            auto worker = [&](std::size_t index)
+            {
+                std::mt19937 gen(seed + static_cast<unsigned>(index) + 1);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                std::uniform_int_distribution<> operation_dist(0, 3);
+
+                ready++;
+                while (!start.load())
+                { }
+
+                for (std::size_t i = 0; i < operations_per_thread; i++)
+                {
+                    const auto key = key_dist(gen);
+                    switch (operation_dist(gen))
+                    {
+                        case 0:
+                            tree.insert(key);
+                            break;
+                        case 1:
+                            tree.erase(key);
+                            break;
+                        default:
+                            tree.contains(key);
+                            break;
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (std::size_t index = 0; index < threads_count; index++)
+            {
+                threads.emplace_back(worker, index);
+            }
+            while (ready.load() != threads_count)
+            { }
+
+            double total_time = 0;
+            {
+                ACCUMULATE_DURATION(total_time);
+                start.store(true);
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            }
+
+            const double operations = static_cast<double>(threads_count * operations_per_thread);
+            results.push_back({threads_count, operations / total_time});
+        }
+
+        return results;
+    }
+
+    // Lookup throughput of 1..max_readers threads, each running operations_per_reader finds,
+    // while one more thread keeps inserting and erasing random keys in a tree of about size keys.
+    template <typename Tree>
+    std::vector<concurrent_statistic> profile_readers(std::size_t size,
+                                                      std::size_t max_readers,
+                                                      std::size_t operations_per_reader
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+
+        const int key_max = static_cast<int>(2 * size);
+
+        std::vector<concurrent_statistic> results;
+
+        for (std::size_t readers_count = 1; readers_count <= max_readers; readers_count++)
+        {
+            Tree tree;
+            {
+                std::mt19937 gen(seed);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                while (tree.size() < size)
+                {
+                    tree.insert(key_dist(gen));
+                }
+            }
+
+            std::atomic<std::size_t> ready{0};
+            std::atomic<bool> start{false};
+            std::atomic<bool> is_done{false};
+
+            // the writer runs from before the readers start until after they finish
+            std::thread writer([&]()
+            {
+                std::mt19937 gen(seed);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                while (!is_done.load())
+                {
+                    const auto key = key_dist(gen);
+                    tree.insert(key);
+                    tree.erase(key_dist(gen));
+                }
+            });
+
+            auto reader = [&](std::size_t index)
+            {
+                std::mt19937 gen(seed + static_cast<unsigned>(index) + 1);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+
+                ready++;
+                while (!start.load())
+                { }
+
+                for (std::size_t i = 0; i < operations_per_reader; i++)
+                {
+                    tree.contains(key_dist(gen));
+                }
+            };
+
+            std::vector<std::thread> readers;
+            for (std::size_t index = 0; index < readers_count; index++)
+            {
+                readers.emplace_back(reader, index);
+            }
+            while (ready.load() != readers_count)
+            { }
+
+            double total_time = 0;
+            {
+                ACCUMULATE_DURATION(total_time);
+                start.store(true);
+                for (auto& thread : readers)
+                {
+                    thread.join();
+                }
+            }
+            is_done.store(true);
+            writer.join();
+
+            const double operations = static_cast<double>(readers_count * operations_per_reader);
+            results.push_back({readers_count, operations / total_time});
+        }
+
+        return results;
+    }
+
+    // Lookup latency percentiles of 1..max_readers threads, each timing operations_per_reader finds
+    // one by one, while one more thread keeps inserting and erasing random keys in a tree of about
+    // size keys. The tail shows how long readers wait for the writer.
+    template <typename Tree>
+    std::vector<read_latency_statistic> profile_read_latency(std::size_t size,
+                                                             std::size_t max_readers,
+                                                             std::size_t operations_per_reader
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+
+        const int key_max = static_cast<int>(2 * size);
+
+        std::vector<read_latency_statistic> results;
+
+        for (std::size_t readers_count = 1; readers_count <= max_readers; readers_count++)
+        {
+            Tree tree;
+            {
+                std::mt19937 gen(seed);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                while (tree.size() < size)
+                {
+                    tree.insert(key_dist(gen));
+                }
+            }
+
+            std::atomic<std::size_t> ready{0};
+            std::atomic<bool> start{false};
+            std::atomic<bool> is_done{false};
+
+            std::thread writer([&]()
+            {
+                std::mt19937 gen(seed);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                while (!is_done.load())
+                {
+                    const auto key = key_dist(gen);
+                    tree.insert(key);
+                    tree.erase(key_dist(gen));
+                }
+            });
+
+            std::vector<double> find_times(readers_count * operations_per_reader);
+            auto reader = [&](std::size_t index)
+            {
+                std::mt19937 gen(seed + static_cast<unsigned>(index) + 1);
+                std::uniform_int_distribution<> key_dist(0, key_max);
+                double* times = find_times.data() + index * operations_per_reader;
+
+                ready++;
+                while (!start.load())
+                { }
+
+                for (std::size_t i = 0; i < operations_per_reader; i++)
+                {
+                    const auto key = key_dist(gen);
+                    times[i] = 0;
+                    {
+                        ACCUMULATE_DURATION(times[i]);
+                        tree.contains(key);
+                    }
+                }
+            };
+
+            std::vector<std::thread> readers;
+            for (std::size_t index = 0; index < readers_count; index++)
+            {
+                readers.emplace_back(reader, index);
+            }
+            while (ready.load() != readers_count)
+            { }
+
+            start.store(true);
+            for (auto& thread : readers)
+            {
+                thread.join();
+            }
+            is_done.store(true);
+            writer.join();
+
+            auto percentile = [&](double fraction)
+            {
+                const auto index = static_cast<std::size_t>(fraction * static_cast<double>(find_times.size() - 1));
+                std::nth_element(find_times.begin(), find_times.begin() + index, find_times.end());
+                return find_times[index];
+            };
+
+            const double p50 = percentile(0.5);
+            const double p99 = percentile(0.99);
+            const double max = *std::max_element(find_times.begin(), find_times.end());
+            results.push_back({readers_count, p50, p99, max});
+        }
+
+        return results;
+    }
+
+
+    // Time per operation of batch_size random inserts and erases on a Tree of size keys,
+    // applied one by one and as one apply_batch call, for batch sizes growing tenfold from
+    // batch_size_start to batch_size_end. Both trees start from the same keys. The batch
+    // runs on a pool of the given number of threads, on the calling thread if it is 1.
+    template <typename Tree>
+    std::vector<batch_statistic> profile_batch(std::size_t size,
+                                               std::size_t batch_size_start,
+                                               std::size_t batch_size_end,
+                                               std::size_t threads
+    )
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        const int key_max = static_cast<int>(2 * size);
+        std::uniform_int_distribution<> key_dist(0, key_max);
+        std::bernoulli_distribution kind_dist(0.5);
+
+        std::optional<tree::thread_pool> pool;
+        if (threads > 1)
+        {
+            pool.emplace(threads);
+        }
+
+        std::vector<batch_statistic> results;
+
+        for (std::size_t batch_size = batch_size_start; batch_size <= batch_size_end; batch_size *= 10)
+        {
+            Tree one_by_one;
+            Tree batched;
+            while (one_by_one.size() < size)
+            {
+                const auto key = key_dist(gen);
+                one_by_one.insert(key);
+                batched.insert(key);
+            }
+
+            std::vector<tree::batch_operation<int>> batch(batch_size);
+            for (auto& operation : batch)
+            {
+                operation = {kind_dist(gen) ? tree::batch_kind::insert : tree::batch_kind::erase, key_dist(gen)};
+            }
+
+            double one_by_one_time = 0;
+            {
+                ACCUMULATE_DURATION(one_by_one_time);
+                for (const auto& operation : batch)
+                {
+                    if (operation.kind == tree::batch_kind::insert)
+                    {
+                        one_by_one.insert(operation.key);
+                    }
+                    else
+                    {
+                        one_by_one.erase(operation.key);
+                    }
+                }
+            }
+
+            double batch_time = 0;
+            {
+                ACCUMULATE_DURATION(batch_time);
+                if (pool.has_value())
+                {
+                    batched.apply_batch(batch, tree::par.on(*pool));
+                }
+                else
+                {
+                    batched.apply_batch(batch, tree::seq);
+                }
+            }
+
+            const auto operations = static_cast<double>(batch_size);
+            results.push_back({batch_size, threads, one_by_one_time / operations, batch_time / operations});
+        }
+
+        return results;
+    }
+
+
+    // Seconds to build a Tree of size random keys with from_unsorted on 1, 2, 4, ... up to
+    // max_threads threads, and to insert the same keys one by one. On 1 thread the build runs
+    // sequentially, otherwise on a pool of that many threads started beforehand.
+    template <typename Tree>
+    std::vector<build_statistic> profile_build(std::size_t size, std::size_t max_threads)
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+
+        std::vector<int> keys(size);
+        for (auto& key : keys)
+        {
+            key = key_dist(gen);
+        }
+
+        double insert_time = 0;
+        {
+            Tree tree;
+            ACCUMULATE_DURATION(insert_time);
+            for (const auto& key : keys)
+            {
+                tree.insert(key);
+            }
+        }
+
+        std::vector<build_statistic> results;
+
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+        {
+            std::optional<tree::thread_pool> pool;
+            if (threads > 1)
+            {
+                pool.emplace(threads);
+            }
+
+            double build_time = 0;
+            std::optional<Tree> tree;
+            {
+                ACCUMULATE_DURATION(build_time);
+                if (pool.has_value())
+                {
+                    tree.emplace(Tree::from_unsorted(keys.begin(), keys.end(), tree::par.on(*pool)));
+                }
+                else
+                {
+                    tree.emplace(Tree::from_unsorted(keys.begin(), keys.end(), tree::seq));
+                }
+            }
+
+            results.push_back({threads, build_time, insert_time});
+        }
+
+        return results;
+    }
+
+
+    // Seconds for a full for_each, a sum by reduce and a clone of a Tree of size random keys on
+    // 1, 2, 4, ... up to max_threads threads, and for summing it with a range-for. The tree is
+    // built once and then searched for a hundredth of its keys, so a splay tree is skewed.
+    template <typename Tree>
+    std::vector<traversal_statistic> profile_traversal(std::size_t size, std::size_t max_threads)
+    {
+        std::random_device rd;
+        const auto seed = rd();
+        std::mt19937 gen(seed);
+
+        int key_min = std::numeric_limits<int>::min();
+        int key_max = std::numeric_limits<int>::max();
+        std::uniform_int_distribution<> key_dist(key_min, key_max);
+
+        std::vector<int> keys(size);
+        for (auto& key : keys)
+        {
+            key = key_dist(gen);
+        }
+
+        Tree tree = Tree::from_unsorted(keys.begin(), keys.end(), tree::par);
+        std::uniform_int_distribution<std::size_t> index_dist(0, size - 1);
+        for (std::size_t find = 0; find < size / 100; find++)
+        {
+            tree.find(keys[index_dist(gen)]);
+        }
+
+        const auto add = [](long long sum, int key) { return sum + key; };
+        const auto sum = [](long long lhs, long long rhs) { return lhs + rhs; };
+
+        double iterate_time = 0;
+        long long iterated = 0;
+        {
+            ACCUMULATE_DURATION(iterate_time);
+            for (const auto& key : tree)
+            {
+                iterated += key;
+            }
+        }
+
+        std::vector<traversal_statistic> results;
+
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+        {
+            std::optional<tree::thread_pool> pool;
+            if (threads > 1)
+            {
+                pool.emplace(threads);
+            }
+
+            // a relaxed counter of the rare keys, so that the calls do not fight over it
+            std::atomic<std::size_t> counted{0};
+            const auto count = [&](int key)
+            {
+                if (key % 1024 == 0)
+                {
+                    counted.fetch_add(1, std::memory_order_relaxed);
+                }
+            };
+
+            double for_each_time = 0;
+            double reduce_time = 0;
+            double clone_time = 0;
+            long long reduced = 0;
+            std::optional<Tree> copy;
+            {
+                ACCUMULATE_DURATION(for_each_time);
+                if (pool.has_value())
+                {
+                    tree.for_each(count, tree::par.on(*pool));
+                }
+                else
+                {
+                    tree.for_each(count, tree::seq);
+                }
+            }
+            {
+                ACCUMULATE_DURATION(reduce_time);
+                if (pool.has_value())
+                {
+                    reduced = tree.reduce(0LL, add, sum, tree::par.on(*pool));
+                }
+                else
+                {
+                    reduced = tree.reduce(0LL, add, sum, tree::seq);
+                }
+            }
+            {
+                ACCUMULATE_DURATION(clone_time);
+                if (pool.has_value())
+                {
+                    copy.emplace(tree.clone(tree::par.on(*pool)));
+                }
+                else
+                {
+                    copy.emplace(tree.clone(tree::seq));
+                }
+            }
+
+            if (reduced != iterated || copy->size() != tree.size())
+            {
+                throw std::runtime_error("parallel traversal disagrees with the iterator");
+            }
+
+            results.push_back({threads, for_each_time, reduce_time, clone_time, iterate_time});
+        }
+
+        return results;
+    }
+
 } // namespace profiler
\ No newline at end of file
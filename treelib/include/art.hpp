@@ -0,0 +1,206 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "detail/radix.hpp"
+#include "static_set.hpp"
+
+namespace tree
+{
+    // Adaptive radix tree (Leis et al.): keys are turned into binary-comparable bytes and
+    // looked up one byte per level, so the depth depends on the key length, not on the size.
+    // Inner nodes grow and shrink between 4, 16, 48 and 256 children, chains of single-child
+    // nodes are compressed into a prefix, and a leaf hangs directly below the first byte
+    // that tells its key apart from the others.
+    //
+    // Key is an integral type or std::string without '\0' characters.
+    template <typename Key>
+    class art
+    {
+    public:
+        using key_type = Key;
+        using key_compare = std::less<Key>;
+        using self_type = tree::art<key_type>;
+        using node_type = tree::detail::NodeART;
+        using node_ptr = node_type*;
+        using leaf_type = tree::detail::NodeARTLeaf<key_type>;
+        using leaf_ptr = leaf_type*;
+        using key_traits = tree::detail::radix_key<key_type>;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            const_iterator(const self_type* owner, const leaf_type* leaf);
+
+            const value_type& operator * () const;
+            const value_type* operator -> () const;
+
+            // looks the successor up from the root, O(key length)
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            const self_type* owner;
+            const leaf_type* leaf;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+    public:
+        art();
+
+        art(const std::initializer_list<key_type>& data);
+        art(std::initializer_list<key_type>&& data);
+
+        art(const self_type& other);
+        art(self_type&& other) noexcept;
+
+        ~art();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        iterator insert(key_type key);
+
+        void erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // first key not less than the value
+        const_iterator lower_bound(const key_type& value) const;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        // node sizes fit their types, keys in nodes are sorted, every leaf lies on the path
+        // of its bytes and the leaves add up to size()
+        bool is_art() const noexcept;
+
+    private:
+        using node4_type = tree::detail::NodeART4;
+        using node16_type = tree::detail::NodeART16;
+        using node48_type = tree::detail::NodeART48;
+        using node256_type = tree::detail::NodeART256;
+        using bytes_type = typename key_traits::bytes_type;
+
+        static constexpr std::size_t max_prefix_length = tree::detail::art_max_prefix_length;
+
+        ////////////////
+        //   LEAVES   //
+        ////////////////
+
+        static bool is_leaf(const node_type* node) noexcept;
+        static leaf_ptr as_leaf(const node_type* node) noexcept;
+        static node_ptr as_node(leaf_ptr leaf) noexcept;
+
+        static leaf_ptr minimum(const node_type* node) noexcept;
+
+        /////////////////////
+        //   INNER NODES   //
+        /////////////////////
+
+        // link to the child under the byte, nullptr if there is none
+        static node_ptr* find_child(node_ptr node, std::uint8_t byte) noexcept;
+
+        // first child under a byte not less than the given one, which may be 256
+        static node_ptr next_child(const node_type* node, unsigned byte) noexcept;
+
+        // calls visit(byte, child) for the children in order
+        template <typename Visitor>
+        static void for_each_child(const node_type* node, Visitor&& visit);
+
+        // the node under the link grows into the next type when it is full
+        static void add_child(node_ptr& link, std::uint8_t byte, node_ptr child);
+
+        // the node under the link shrinks into the previous type when it gets sparse,
+        // a node left with one child is merged into it
+        static void remove_child(node_ptr& link, std::uint8_t byte, node_ptr* slot);
+
+        static void copy_header(node_ptr to, const node_type* from) noexcept;
+
+        //////////////////
+        //   PREFIXES   //
+        //////////////////
+
+        // length of the common part of the node prefix and the bytes from depth on
+        template <typename Bytes>
+        static std::size_t prefix_mismatch(const node_type* node, const Bytes& bytes, std::size_t depth) noexcept;
+
+        // compares the part of the path from offset on with the bytes from depth on,
+        // a path longer than the bytes is greater
+        template <typename Path, typename Bytes>
+        static int compare_path(const Path& path, std::size_t offset, std::size_t length,
+                                const Bytes& bytes, std::size_t depth) noexcept;
+
+        ////////////////
+        //   SEARCH   //
+        ////////////////
+
+        leaf_ptr find_leaf(const key_type& value) const;
+
+        // first leaf after the key, or not less than it if not strict
+        leaf_ptr bound(const node_type* node, const bytes_type& bytes, std::size_t depth,
+                       const key_type& key, bool strict) const;
+
+        static void destroy(node_ptr node) noexcept;
+
+        bool check(const node_type* node, std::vector<int>& path, std::size_t& leaves) const;
+
+    private:
+        node_ptr head = nullptr;
+        std::size_t m_size = 0;
+        key_compare key_cmp = { };
+    };
+
+} // namespace tree
+
+#include "detail/art.tpp"
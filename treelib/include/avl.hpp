@@ -2,6 +2,8 @@
 
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 #include <exception>
@@ -11,7 +13,12 @@
 #include <queue>
 
 #include "detail/node.hpp"
+#include "detail/node_pool.hpp"
+#include "detail/batch.hpp"
 #include "iterator.hpp"
+#include "execution.hpp"
+#include "detail/parallel.hpp"
+#include "static_set.hpp"
 
 #define AVL_TREE_DEBUG_ROTATIONS 0
 #define AVL_TREE_DEBUG_INSERT 0
@@ -19,6 +26,9 @@
 
 namespace tree
 {
+    template <typename Tree>
+    class seqlocked;
+
     template <typename Key, typename Compare = std::less<Key>>
     class avl
     {
@@ -29,6 +39,7 @@ namespace tree
         using node_ptr = node_type*;
         using iterator = tree::NodeIterator<node_type>;
         using const_iterator = tree::NodeIterator<const node_type>;
+        using self_type = tree::avl<key_type, key_compare>;
 
     public:
         avl();
@@ -44,6 +55,17 @@ namespace tree
         avl<key_type, key_compare>& operator = (const avl<key_type, key_compare>& other);
         avl<key_type, key_compare>& operator = (avl<key_type, key_compare>&& other) noexcept;
 
+        // The distinct keys of [first, last) in any order, the first of equal ones kept. They are
+        // sorted and deduplicated, then linked into a perfectly balanced tree in O(n); under the
+        // parallel policy all of it runs on the pool, disjoint subtrees on different workers.
+        template <typename InputIt, typename ExecutionPolicy = sequenced_policy>
+        static self_type from_unsorted(InputIt first, InputIt last, const ExecutionPolicy& policy = seq);
+
+        // A copy of the same shape node for node, rather than the keys inserted one by one; under
+        // the parallel policy the subtrees near the root are copied on different workers.
+        template <typename ExecutionPolicy = sequenced_policy>
+        self_type clone(const ExecutionPolicy& policy = seq) const;
+
         ///////////////////
         //   ITERATORS   //
         ///////////////////
@@ -56,6 +78,22 @@ namespace tree
         const_iterator end() const;
         const_iterator cend() const;
 
+        ///////////////////
+        //   TRAVERSAL   //
+        ///////////////////
+
+        // Calls function(key) on every key, in order under the sequential policy. Under the
+        // parallel one the subtrees near the root go to different workers, idle ones stealing
+        // from busy ones, so the order is unspecified and the calls are concurrent.
+        template <typename Function, typename ExecutionPolicy = sequenced_policy>
+        void for_each(Function function, const ExecutionPolicy& policy = seq) const;
+
+        // Folds the keys in order: every part starts from identity, accumulate(value, key) takes
+        // its keys in and combine(lhs, rhs) joins neighbouring parts, so combine has to be
+        // associative with identity neutral. The parts are split like for for_each.
+        template <typename T, typename Accumulate, typename Combine, typename ExecutionPolicy = sequenced_policy>
+        T reduce(T identity, Accumulate accumulate, Combine combine, const ExecutionPolicy& policy = seq) const;
+
         //////////////////
         //   CAPACITY   //
         //////////////////
@@ -73,6 +111,27 @@ namespace tree
 
         void erase(const key_type& key);
 
+        // Applies the inserts and erases of the batch as if one by one in batch order and tells
+        // for each whether it changed the tree. The batch is sorted by key and merged into the
+        // tree in one pass, disjoint parts of it in parallel under the parallel policy.
+        std::vector<bool> apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                      const sequenced_policy& policy = seq);
+        std::vector<bool> apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                      const parallel_policy& policy);
+
+        /////////////////////////
+        //   RELAXED BALANCE   //
+        /////////////////////////
+
+        // In relaxed mode insert and erase only mark the nodes on their path and skip rotations,
+        // the marked part is repaired later by rebalance_step. Switching the mode off repairs it all.
+        void set_relaxed(bool relaxed);
+
+        bool is_relaxed() const noexcept;
+
+        // repairs at most budget marked nodes, the lowest first; true once none is left
+        bool rebalance_step(std::size_t budget);
+
         /////////////////
         //   LOOK UP   //
         /////////////////
@@ -80,6 +139,20 @@ namespace tree
         iterator find(const key_type& value);
         const_iterator find(const key_type& value) const;
 
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        // per-node counters of the finds that hit a key, off by default; switching on resets them.
+        // Only the non-const find counts, so const lookups stay read-only and may still run
+        // concurrently, as under a shared lock or in seqlocked and sharded.
+        void set_access_counting(bool enabled);
+
+        // keys in order with their counted finds, the weights for a weighted_static
+        std::vector<std::pair<key_type, std::size_t>> access_weights() const;
+
+        // number of nodes from the root down to the key, 0 if it is absent
+        std::size_t depth(const key_type& value) const;
+
         bool is_ordered(node_ptr subtree) const noexcept;
 
         bool is_balanced(node_ptr subtree) const noexcept;
@@ -109,7 +182,66 @@ namespace tree
 
         void clear_cache() const;
 
+        node_ptr insert_relaxed(key_type key);
+
+        void erase_relaxed(const key_type& key);
+
+        // height of an unmarked subtree, following the higher child
+        static int height(node_ptr subtree) noexcept;
+
+        // AVL tree of the keys of lhs, the middle node and rhs, with its height;
+        // lhs and rhs are unmarked and ordered around the middle
+        std::pair<node_ptr, int> join(node_ptr lhs, int lhs_height, node_ptr middle,
+                                      node_ptr rhs, int rhs_height);
+
+        // lhs is more than one level higher than rhs, middle goes down its right spine
+        std::pair<node_ptr, int> join_right(node_ptr lhs, int lhs_height, node_ptr middle,
+                                            node_ptr rhs, int rhs_height);
+
+        // rhs is more than one level higher than lhs, middle goes down its left spine
+        std::pair<node_ptr, int> join_left(node_ptr lhs, int lhs_height, node_ptr middle,
+                                           node_ptr rhs, int rhs_height);
+
+        //////////////////
+        //   BATCHING   //
+        //////////////////
+
+        // forks on the executor if there is one
+        std::vector<bool> apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                      thread_pool* executor);
+
+        // the subtree with the groups in [first, last) applied, and its height; the groups
+        // are split around the root of the subtree and both sides are joined back to it
+        std::pair<node_ptr, int> apply_groups(node_ptr subtree, int subtree_height,
+                                              std::size_t first, std::size_t last,
+                                              detail::batch_plan<key_type>& plan, thread_pool* executor);
+
+        // a perfectly balanced tree of the sorted keys in [first, last), moved out of them, and its height
+        std::pair<node_ptr, int> build_sorted(std::vector<key_type>& keys, std::size_t first, std::size_t last,
+                                              thread_pool* executor);
+
+        // a balanced tree of the nodes in [first, last), given in key order
+        std::pair<node_ptr, int> build(const std::vector<node_ptr>& nodes, std::size_t first, std::size_t last);
+
+        // lhs and rhs are unmarked and every key of lhs is less than every key of rhs
+        std::pair<node_ptr, int> join(node_ptr lhs, int lhs_height, node_ptr rhs, int rhs_height);
+
+        // detaches the least node of a non-empty subtree into min
+        std::pair<node_ptr, int> remove_min(node_ptr subtree, int subtree_height, node_ptr& min);
+
+        // from the pool if one is set, from the heap otherwise
+        node_ptr create_node(key_type key);
+
+        void destroy_node(node_ptr node) noexcept;
+
     private:
+        // smaller batches are not worth a task
+        static constexpr std::size_t batch_parallel_cutoff = 1024;
+
+        // reads the root and sets the pool
+        template <typename Tree>
+        friend class tree::seqlocked;
+
         node_ptr head = nullptr;
         std::size_t m_size = 0;
         key_compare key_cmp = { };
@@ -120,6 +252,11 @@ namespace tree
         mutable node_ptr joint_to_branch = nullptr;
         mutable node_ptr branch_root = nullptr;
         mutable bool is_branch_right_child = false;
+
+        bool relaxed = false;
+        bool count_accesses = false;
+
+        detail::node_pool<node_type>* pool = nullptr;
     };
 
 } // namespace tree
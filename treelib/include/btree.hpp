@@ -0,0 +1,177 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+
+namespace tree
+{
+    // B+ tree with nodes of about NodeBytes bytes: keys live in the leaves,
+    // which are chained for iteration; inner nodes only route the search.
+    // Pick NodeBytes as a few cache lines for memory-resident sets or a page for larger ones.
+    template <typename Key, typename Compare = std::less<Key>, std::size_t NodeBytes = 256>
+    class btree
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using self_type = tree::btree<key_type, key_compare, NodeBytes>;
+
+        static constexpr std::size_t header_bytes = sizeof(std::uint32_t);
+
+        static constexpr std::size_t leaf_capacity =
+                std::max<std::size_t>(3, (NodeBytes - header_bytes - 2 * sizeof(void*)) / sizeof(key_type));
+
+        static constexpr std::size_t inner_capacity =
+                std::max<std::size_t>(3, (NodeBytes - header_bytes - sizeof(void*)) /
+                                         (sizeof(key_type) + sizeof(void*)));
+
+        static_assert(leaf_capacity < UINT16_MAX && inner_capacity < UINT16_MAX, "node is too large");
+
+        using node_type = tree::detail::NodeBTree<key_type>;
+        using node_ptr = node_type*;
+        using leaf_type = tree::detail::NodeBTreeLeaf<key_type, leaf_capacity>;
+        using leaf_ptr = leaf_type*;
+        using inner_type = tree::detail::NodeBTreeInner<key_type, inner_capacity>;
+        using inner_ptr = inner_type*;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            const_iterator(const self_type* owner, const leaf_type* leaf, std::size_t index);
+
+            const value_type& operator * () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            const_iterator& operator -- ();
+            const_iterator operator -- (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            const self_type* owner;
+            const leaf_type* leaf;
+            std::size_t index;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+    public:
+        btree();
+
+        btree(const std::initializer_list<key_type>& data);
+        btree(std::initializer_list<key_type>&& data);
+
+        btree(const self_type& other);
+        btree(self_type&& other) noexcept;
+
+        ~btree();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        iterator insert(key_type key);
+
+        void erase(const key_type& key);
+
+        // replaces the contents in O(n), [first, last) must be sorted and hold no duplicates
+        template <typename InputIt>
+        void bulk_load(InputIt first, InputIt last);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        bool is_btree() const noexcept;
+
+    private:
+        std::size_t lower_index(const key_type* keys, std::size_t count, const key_type& value) const;
+        std::size_t upper_index(const key_type* keys, std::size_t count, const key_type& value) const;
+
+        leaf_ptr find_leaf(const key_type& value) const;
+
+        // same as find_leaf, but caches the path for rebalancing
+        leaf_ptr descend(const key_type& value);
+
+        void insert_into_parent(key_type separator, node_ptr right);
+
+        void rebalance_leaf(leaf_ptr leaf);
+        void rebalance_inner(inner_ptr node);
+
+        void remove_from_inner(inner_ptr node, std::size_t key_index);
+
+        void destroy(node_ptr subtree) noexcept;
+
+        bool check(node_ptr subtree, std::size_t depth, std::size_t& leaf_depth,
+                   const key_type* lower, const key_type* upper) const noexcept;
+
+        static leaf_ptr as_leaf(node_ptr node) noexcept;
+        static inner_ptr as_inner(node_ptr node) noexcept;
+
+    private:
+        // keep in-node search linear while a node spans only a few cache lines
+        static constexpr std::size_t linear_search_bytes = 256;
+
+        static constexpr std::size_t leaf_min = leaf_capacity / 2;
+        static constexpr std::size_t inner_min = inner_capacity / 2;
+
+        node_ptr head = nullptr;
+        leaf_ptr first_leaf = nullptr;
+        leaf_ptr last_leaf = nullptr;
+        std::size_t m_size = 0;
+        key_compare key_cmp = { };
+
+        // inner nodes on the way to the current leaf with the index of the child taken
+        std::vector<std::pair<inner_ptr, std::size_t>> path_cache;
+    };
+
+} // namespace tree
+
+#include "detail/btree.tpp"
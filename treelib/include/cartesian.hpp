@@ -2,8 +2,10 @@
 
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
+#include <limits>
 #include <exception>
 #include <optional>
 #include <initializer_list>
@@ -12,13 +14,22 @@
 #include <random>
 
 #include "detail/node.hpp"
+#include "detail/node_pool.hpp"
+#include "detail/batch.hpp"
+#include "detail/intrinsics.hpp"
 #include "iterator.hpp"
+#include "execution.hpp"
+#include "detail/parallel.hpp"
+#include "static_set.hpp"
 
 #define CARTESIAN_TREE_DEBUG_INSERT 0
 #define CARTESIAN_TREE_DEBUG_ERASE 0
 
 namespace tree
 {
+    template <typename Tree>
+    class seqlocked;
+
     template <typename Key, typename Compare = std::less<Key>>
     class cartesian
     {
@@ -30,6 +41,7 @@ namespace tree
         using iterator = tree::NodeIterator<node_type>;
         using const_iterator = tree::NodeIterator<const node_type>;
         using self_type = tree::cartesian<key_type, key_compare>;
+        using priority_type = int;
 
     public:
         cartesian();
@@ -45,6 +57,18 @@ namespace tree
         cartesian<key_type, key_compare>& operator = (const cartesian<key_type, key_compare>& other);
         cartesian<key_type, key_compare>& operator = (cartesian<key_type, key_compare>&& other) noexcept;
 
+        // The distinct keys of [first, last) in any order, the first of equal ones kept, with random
+        // priorities: the same treap as inserting them one by one. The keys are sorted and
+        // deduplicated, runs of them are linked into heaps in O(n) and merged along their spines;
+        // under the parallel policy all of it runs on the pool, disjoint runs on different workers.
+        template <typename InputIt, typename ExecutionPolicy = sequenced_policy>
+        static self_type from_unsorted(InputIt first, InputIt last, const ExecutionPolicy& policy = seq);
+
+        // A copy of the same shape node for node, rather than the keys inserted one by one; under
+        // the parallel policy the subtrees near the root are copied on different workers.
+        template <typename ExecutionPolicy = sequenced_policy>
+        self_type clone(const ExecutionPolicy& policy = seq) const;
+
         ///////////////////
         //   ITERATORS   //
         ///////////////////
@@ -57,6 +81,22 @@ namespace tree
         const_iterator end() const;
         const_iterator cend() const;
 
+        ///////////////////
+        //   TRAVERSAL   //
+        ///////////////////
+
+        // Calls function(key) on every key, in order under the sequential policy. Under the
+        // parallel one the subtrees near the root go to different workers, idle ones stealing
+        // from busy ones, so the order is unspecified and the calls are concurrent.
+        template <typename Function, typename ExecutionPolicy = sequenced_policy>
+        void for_each(Function function, const ExecutionPolicy& policy = seq) const;
+
+        // Folds the keys in order: every part starts from identity, accumulate(value, key) takes
+        // its keys in and combine(lhs, rhs) joins neighbouring parts, so combine has to be
+        // associative with identity neutral. The parts are split like for for_each.
+        template <typename T, typename Accumulate, typename Combine, typename ExecutionPolicy = sequenced_policy>
+        T reduce(T identity, Accumulate accumulate, Combine combine, const ExecutionPolicy& policy = seq) const;
+
         //////////////////
         //   CAPACITY   //
         //////////////////
@@ -72,8 +112,21 @@ namespace tree
 
         node_ptr insert(key_type key);
 
+        // The priority is kept as given, e.g. a timestamp or a score, and is what the priority
+        // queries below see. Depth stays logarithmic only while priorities are independent of the
+        // key order; switching the frequency-biased mode reassigns every priority.
+        node_ptr insert(key_type key, priority_type priority);
+
         void erase(const key_type& key);
 
+        // Applies the inserts and erases of the batch as if one by one in batch order and tells
+        // for each whether it changed the tree. The batch is sorted by key, the tree is split at
+        // its middle key and both halves go on, in parallel under the parallel policy.
+        std::vector<bool> apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                      const sequenced_policy& policy = seq);
+        std::vector<bool> apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                      const parallel_policy& policy);
+
         // possible memory leak if the returned value is discarded
         [[nodiscard]] std::pair<node_ptr, node_ptr> split(const key_type& key, node_ptr node);
 
@@ -87,6 +140,39 @@ namespace tree
         iterator find(const key_type& value);
         const_iterator find(const key_type& value) const;
 
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        //////////////////////////
+        //   PRIORITY QUERIES   //
+        //////////////////////////
+
+        std::optional<priority_type> priority_of(const key_type& value) const;
+
+        // The key of the highest priority in [lower, upper]: the first node of the search path
+        // that falls into the range is an ancestor of all others there. O(depth).
+        std::optional<std::pair<key_type, priority_type>> max_priority(const key_type& lower,
+                                                                      const key_type& upper) const;
+
+        // Keys in [lower, upper] whose priority is at least the threshold, in key order.
+        // A node below the threshold cuts off its whole subtree, so O(depth + k) for k keys.
+        std::vector<key_type> priority_at_least(const key_type& lower,
+                                                const key_type& upper,
+                                                priority_type threshold) const;
+
+        // Self-adjusting mode: finds count the hits of every node, and a node whose count reaches
+        // the next power of two is re-prioritised and rotated up. The priority of a node is the
+        // log2 class of its count over its own random low bits, so hot keys sit near the root,
+        // equally hot ones keep the treap shape, and reads rotate only O(log count) times per key.
+        // Counts are halved every decay_factor * size() finds. Off by default; switching either
+        // way resets the counts and reshapes the tree in O(n).
+        void set_frequency_biased(bool enabled);
+
+        bool is_frequency_biased() const noexcept;
+
+        // number of nodes from the root down to the key, 0 if it is absent
+        std::size_t depth(const key_type& value) const;
+
         bool is_ordered(node_ptr subtree) const noexcept;
 
         bool is_heap(node_ptr subtree) const noexcept;
@@ -96,11 +182,75 @@ namespace tree
     private:
         auto get_random_priority() const;
 
+        node_ptr find_node(const key_type& value) const;
+
+        //////////////////////////
+        //   FREQUENCY BIASED   //
+        //////////////////////////
+
+        // counts a hit of path_cache.back() and rotates it up along path_cache if its priority grew
+        void count_access();
+
+        // halves every count and rebuilds the heap with the lowered priorities
+        void decay();
+
+        // the log2 class of the count in the high bits, the random low bits of the priority kept
+        static int biased_priority(std::uint32_t accesses, int priority) noexcept;
+
+        std::vector<node_ptr> in_order() const;
+
+        // links the nodes, given in key order, into a heap by priority with a stack in O(n)
+        void rebuild(const std::vector<node_ptr>& nodes);
+
+        // the same with a stack of the caller's, returns the root
+        static node_ptr link_heap(const std::vector<node_ptr>& nodes, std::vector<node_ptr>& spine);
+
+        // a heap of the sorted keys in [first, last), moved out of them, with the given priorities
+        node_ptr build_sorted(std::vector<key_type>& keys, const std::vector<priority_type>& priorities,
+                              std::size_t first, std::size_t last, thread_pool* executor);
+
+        //////////////////
+        //   BATCHING   //
+        //////////////////
+
+        // forks on the executor if there is one
+        std::vector<bool> apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                      thread_pool* executor);
+
+        // the subtree with the groups in [first, last) applied; a new key of a group
+        // gets the priority drawn for it beforehand
+        node_ptr apply_groups(node_ptr subtree, std::size_t first, std::size_t last,
+                              detail::batch_plan<key_type>& plan, const std::vector<priority_type>& priorities,
+                              thread_pool* executor);
+
+        // from the pool if one is set, from the heap otherwise
+        node_ptr create_node(key_type key, priority_type priority);
+
+        void destroy_node(node_ptr node) noexcept;
+
     private:
+        // reads the root and sets the pool
+        template <typename Tree>
+        friend class tree::seqlocked;
+
+        static constexpr unsigned class_shift = 26;
+        static constexpr std::size_t decay_factor = 8;
+
+        // smaller batches are not worth a task
+        static constexpr std::size_t batch_parallel_cutoff = 1024;
+
         node_ptr head = nullptr;
         std::size_t m_size = 0;
         key_compare key_cmp = { };
 
+        detail::node_pool<node_type>* pool = nullptr;
+
+        bool frequency_biased = false;
+        std::size_t finds_since_decay = 0;
+
+        // ancestors of the node found last, the root first
+        std::vector<node_ptr> path_cache;
+
         const unsigned seed = (std::random_device{})();
         mutable std::mt19937 gen = std::mt19937(seed);
         const int priority_min = std::numeric_limits<int>::min();
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+
+#include "detail/intrinsics.hpp"
+
+namespace tree
+{
+    // Ordered set shared between threads through flat combining (Hendler, Incze, Shavit,
+    // Tzafrir) over any sequential Tree. A thread publishes its operation in a record of its
+    // own and then either waits on that record or, if the lock is free, becomes the combiner:
+    // it collects every published operation, sorts the batch by key and applies it to the
+    // tree in one pass, so the lock changes hands once per batch instead of once per
+    // operation and neighbouring keys are visited one after another.
+    //
+    // Records are taken per operation, starting from a slot picked by the thread id, so
+    // threads do not register. With more than Slots threads in flight at once the extra
+    // ones take the lock themselves. Lookups are combined as well, since avl and splay change
+    // the tree even when they only read it. Tree needs insert, erase, find, end, size, clear
+    // and ordered iteration. The set owns its lock, so it is neither copyable nor movable.
+    template <typename Tree, std::size_t Slots = 64>
+    class combining
+    {
+        static_assert(Slots > 0, "at least one publication record is needed");
+
+    public:
+        using tree_type = Tree;
+        using key_type = typename tree_type::key_type;
+        using key_compare = typename tree_type::key_compare;
+        using self_type = tree::combining<tree_type, Slots>;
+
+        static constexpr std::size_t slots_count = Slots;
+
+    public:
+        combining() = default;
+
+        combining(const std::initializer_list<key_type>& data);
+        combining(std::initializer_list<key_type>&& data);
+
+        combining(const self_type& other) = delete;
+        combining(self_type&& other) = delete;
+
+        self_type& operator = (const self_type& other) = delete;
+        self_type& operator = (self_type&& other) = delete;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const;
+
+        std::size_t size() const;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear();
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        bool contains(const key_type& value) const;
+
+        // every key in order, copied under the lock
+        std::vector<key_type> keys() const;
+
+        // operations applied by combiners so far and the batches they came in,
+        // for watching how much combining happens
+        std::size_t combined_operations() const noexcept;
+        std::size_t combined_batches() const noexcept;
+
+    private:
+        enum class operation : std::uint8_t {insert, erase, contains};
+
+        enum class status : std::uint8_t {free, taken, pending, done};
+
+        struct alignas(detail::cache_line_size) record
+        {
+            std::atomic<status> state{status::free};
+
+            // written by the owner before it publishes, read by the combiner
+            operation type = operation::contains;
+            const key_type* key = nullptr;
+
+            // written by the combiner before it marks the record done
+            bool result = false;
+        };
+
+        // publishes the operation and waits until some combiner applied it
+        bool apply(operation type, const key_type& key) const;
+
+        // expects the lock: applies every published operation, the own one included
+        void combine() const;
+
+        bool apply_locked(operation type, const key_type& key) const;
+
+        record* take_record() const;
+
+    private:
+        mutable std::array<record, Slots> records;
+
+        mutable std::mutex mutex;
+        mutable tree_type tree;
+
+        // reused by the combiner, guarded by mutex
+        mutable std::vector<record*> batch;
+
+        mutable std::atomic<std::size_t> operations_count{0};
+        mutable std::atomic<std::size_t> batches_count{0};
+
+        key_compare key_cmp = { };
+    };
+
+} // namespace tree
+
+#include "detail/combining.tpp"
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "detail/epoch.hpp"
+
+namespace tree
+{
+    // AVL tree with optimistic concurrency control (Bronson, Casper, Chafi, Olukotun):
+    // insert, erase, find and contains may be called from any number of threads at once.
+    //
+    // Lookups take no locks and write no shared memory besides their epoch slot: they walk
+    // down hand over hand and check that the version of every node they passed did not change,
+    // going back one level when it did. Insert and erase lock only the node they change and its
+    // parent, and rebalancing locks the two or three nodes a rotation moves together with their
+    // parent. Balance is relaxed: heights are repaired on the way up after every change, so the
+    // tree is a strict AVL tree whenever no operation is in flight. An erased key with two
+    // children stays as a routing node until it can be unlinked; unlinked nodes are freed
+    // through epoch-based reclamation.
+    //
+    // Iteration is weakly consistent: every step looks up the next key after the last one,
+    // so it sees every key present for the whole iteration exactly once. clear(), copying,
+    // moving and assignment are not thread-safe. The sentinel above the root holds a
+    // default-constructed key, which is never compared.
+    template <typename Key, typename Compare = std::less<Key>>
+    class concurrent_avl
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeConcurrentAVL<key_type>;
+        using node_ptr = node_type*;
+        using self_type = tree::concurrent_avl<key_type, key_compare>;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            // the end iterator
+            const_iterator() = default;
+
+            const value_type& operator * () const;
+            const value_type* operator -> () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            friend class concurrent_avl;
+
+            const_iterator(const self_type* owner, std::optional<key_type> current);
+
+        private:
+            const self_type* owner = nullptr;
+
+            // a copy, so the node may go away under the iterator
+            std::optional<key_type> current;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+    public:
+        concurrent_avl();
+
+        concurrent_avl(const std::initializer_list<key_type>& data);
+        concurrent_avl(std::initializer_list<key_type>&& data);
+
+        concurrent_avl(const self_type& other);
+        concurrent_avl(self_type&& other) noexcept;
+
+        ~concurrent_avl();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+
+        // exact when no operation is in flight
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear();
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        const_iterator find(const key_type& value) const;
+
+        bool contains(const key_type& value) const;
+
+        // keys are ordered, heights are exact and balanced, and every routing node has two
+        // children; only meaningful while no other thread modifies the tree
+        bool is_avl() const;
+
+    private:
+        enum class search_result {not_found, found, retry};
+        enum class update_result {unchanged, changed, retry};
+
+        // the version of a node during a rotation that moves keys out of its subtree
+        static constexpr std::uint64_t unlinked = 1;
+        static constexpr std::uint64_t shrinking = 2;
+        static constexpr std::uint64_t version_step = 4;
+
+        // outcomes of node_condition() besides the height the node should have
+        static constexpr int nothing_required = -1;
+        static constexpr int unlink_required = -2;
+        static constexpr int rebalance_required = -3;
+
+        ///////////////////
+        //   SEARCHING   //
+        ///////////////////
+
+        // looks the key up below the child of the node, which had the version;
+        // retry if the node changed on the way
+        search_result attempt_find(const key_type& key, node_ptr node, bool is_right,
+                                   std::uint64_t node_version) const;
+
+        // the least present key below the child of the node that is greater than after,
+        // the least of all if after is null
+        search_result attempt_next(const key_type* after, node_ptr node, bool is_right,
+                                   std::uint64_t node_version, std::optional<key_type>& next) const;
+
+        std::optional<key_type> next_key(const key_type* after) const;
+
+        // waits out a rotation that is moving keys out of the node's subtree
+        static void wait_until_not_shrinking(const node_type* node) noexcept;
+
+        ///////////////////
+        //   MODIFYING   //
+        ///////////////////
+
+        update_result attempt_insert(key_type& key, node_ptr node, bool is_right, std::uint64_t node_version);
+
+        update_result attempt_erase(const key_type& key, node_ptr node, bool is_right, std::uint64_t node_version);
+
+        // erases the key of a node found as a child of the parent
+        update_result attempt_erase_node(node_ptr parent, node_ptr node);
+
+        // expects both locks; false if the node is no longer the parent's child or has two children
+        bool attempt_unlink_locked(node_ptr parent, node_ptr node);
+
+        /////////////////////
+        //   REBALANCING   //
+        /////////////////////
+
+        // repairs heights and balance from the node up to the root
+        void fix_height_and_rebalance(node_ptr node);
+
+        // the height the node should have, or one of the requirements above
+        static int node_condition(node_ptr node) noexcept;
+
+        // expects the node's lock; the next node to repair, nullptr if none
+        static node_ptr fix_height_locked(node_ptr node) noexcept;
+
+        // expects the locks of both; nodes to repair besides the returned one go to pending
+        node_ptr rebalance_locked(node_ptr parent, node_ptr node, std::vector<node_ptr>& pending);
+
+        // rotates the heavy child of the node above it, or the heavy grandchild above both;
+        // expects the locks of the parent and the node
+        node_ptr rebalance_toward(node_ptr parent, node_ptr node, node_ptr heavy, int light_height,
+                                  bool is_right_heavy, std::vector<node_ptr>& pending);
+
+        // expects the locks of the parent, the node and the heavy child
+        static node_ptr rotate_single(node_ptr parent, node_ptr node, node_ptr heavy, bool is_right_heavy,
+                                      int light_height, int outer_height, node_ptr inner, int inner_height) noexcept;
+
+        // expects the locks of the parent, the node, the heavy child and its inner child
+        static node_ptr rotate_double(node_ptr parent, node_ptr node, node_ptr heavy, bool is_right_heavy,
+                                      int light_height, int outer_height, node_ptr inner, int inner_outer_height,
+                                      std::vector<node_ptr>& pending);
+
+        /////////////////
+        //   HELPERS   //
+        /////////////////
+
+        static node_ptr child(const node_type* node, bool is_right) noexcept;
+
+        static void set_child(node_ptr node, bool is_right, node_ptr value) noexcept;
+
+        static int height(const node_type* node) noexcept;
+
+        bool is_equal(const key_type& lhs, const key_type& rhs) const;
+
+        // height of the subtree, -1 if it breaks a rule of is_avl()
+        int check(const node_type* subtree, const key_type* lower, const key_type* upper,
+                  std::size_t& present) const;
+
+        void retire(node_ptr node);
+
+        static void destroy(node_ptr subtree) noexcept;
+
+        static void destroy_node(void* node) noexcept;
+
+    private:
+        // never rotated and never unlinked: the root is its right child
+        node_ptr holder;
+
+        std::atomic<std::size_t> m_size{0};
+        key_compare key_cmp = { };
+
+        mutable detail::epoch_domain epochs;
+    };
+
+} // namespace tree
+
+#include "detail/concurrent_avl.tpp"
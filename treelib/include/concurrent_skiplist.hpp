@@ -0,0 +1,173 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <utility>
+#include <random>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "detail/intrinsics.hpp"
+#include "detail/epoch.hpp"
+
+namespace tree
+{
+    // Lock-free skip list (Fraser, Herlihy-Shavit): insert, erase, find, lower_bound and
+    // contains may be called from any number of threads at once. Nodes are marked before
+    // they are unlinked, and freed through epoch-based reclamation once no thread can reach them.
+    //
+    // Iterators pin the epoch while they live, so hold them briefly under concurrent erases.
+    // Iteration is weakly consistent. clear(), copying, moving and assignment
+    // are not thread-safe.
+    template <typename Key, typename Compare = std::less<Key>>
+    class concurrent_skiplist
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeSkipList<key_type>;
+        using node_ptr = node_type*;
+        using link_type = typename node_type::link_type;
+        using self_type = tree::concurrent_skiplist<key_type, key_compare>;
+
+        static constexpr std::size_t max_height = 32;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            const_iterator() = default;
+            const_iterator(detail::epoch_domain::guard guard, node_ptr node) noexcept;
+
+            // a copy pins the epoch of its own, no allocation either way
+            const_iterator(const const_iterator& other);
+            const_iterator(const_iterator&& other) noexcept = default;
+
+            const_iterator& operator = (const const_iterator& other);
+            const_iterator& operator = (const_iterator&& other) noexcept = default;
+
+            const value_type& operator * () const;
+            const value_type* operator -> () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            detail::epoch_domain::guard guard;
+            node_ptr node = nullptr;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+    public:
+        concurrent_skiplist();
+
+        concurrent_skiplist(const std::initializer_list<key_type>& data);
+        concurrent_skiplist(std::initializer_list<key_type>&& data);
+
+        concurrent_skiplist(const self_type& other);
+        concurrent_skiplist(self_type&& other) noexcept;
+
+        ~concurrent_skiplist();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+
+        // exact when no operation is in flight
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // first key not less than the value
+        const_iterator lower_bound(const key_type& value) const;
+
+        // wait-free, never modifies the list
+        bool contains(const key_type& value) const;
+
+        // every level is sorted, every node is linked on all of its levels and none is marked;
+        // only meaningful while no other thread modifies the list
+        bool is_skiplist() const noexcept;
+
+    private:
+        using guard_type = detail::epoch_domain::guard;
+
+        // preds[level] is the link to succs[level], the first node not less than the key on that level;
+        // marked nodes on the way are unlinked
+        bool find_position(const key_type& key, link_type** preds, node_ptr* succs, guard_type& guard);
+
+        // first unmarked node not less than the value, without modifying the list
+        node_ptr search(const key_type& value) const;
+
+        void release(node_ptr node, guard_type& guard) noexcept;
+
+        std::uint8_t random_height() noexcept;
+
+        static node_ptr create_node(key_type key, std::uint8_t height);
+        static void destroy_node(void* node) noexcept;
+
+        static node_ptr pointer_of(std::uintptr_t link) noexcept;
+        static std::uintptr_t link_of(node_ptr node) noexcept;
+        static bool is_marked(std::uintptr_t link) noexcept;
+        static constexpr std::uintptr_t mark = 1;
+
+        static node_ptr next_unmarked(node_ptr node) noexcept;
+
+    private:
+        link_type head[max_height] = { };
+        std::atomic<std::size_t> height{1};
+        std::atomic<std::size_t> m_size{0};
+        key_compare key_cmp = { };
+
+        mutable detail::epoch_domain epochs;
+    };
+
+} // namespace tree
+
+#include "detail/concurrent_skiplist.tpp"
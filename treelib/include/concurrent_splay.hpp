@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <functional>
+#include <initializer_list>
+
+#include "splay.hpp"
+#include "detail/intrinsics.hpp"
+
+namespace tree
+{
+    // Splay tree shared between threads with deferred splaying. A find on a splay tree moves
+    // the key to the root, so even pure readers cannot share one. Here readers look the key up
+    // without splaying, under a shared lock, and only log a hit in a buffer of their own. The
+    // logged splays are applied later in bulk under the exclusive lock, every buffer in the
+    // order it was logged: when a reader fills its buffer, when a writer holds the lock anyway,
+    // or when maintain() is called, e.g. periodically. Hot keys still end up near the root,
+    // only with a delay, and reads scale with the threads.
+    //
+    // Buffers are taken per lookup, starting from a slot picked by the thread id, so threads
+    // do not register; a hit that finds every buffer busy or full is not logged. Buffers hold
+    // copies of keys, so an erase between a lookup and the maintenance step is harmless. The
+    // set owns its lock, so it is neither copyable nor movable.
+    template <typename Key, typename Compare = std::less<Key>>
+    class concurrent_splay
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using tree_type = tree::splay<key_type, key_compare>;
+        using self_type = tree::concurrent_splay<key_type, key_compare>;
+
+        static constexpr std::size_t slots_count = 64;
+
+        // hits a buffer logs before its reader runs the maintenance step
+        static constexpr std::size_t buffer_size = 64;
+
+    public:
+        concurrent_splay() = default;
+
+        concurrent_splay(const std::initializer_list<key_type>& data);
+        concurrent_splay(std::initializer_list<key_type>&& data);
+
+        concurrent_splay(const self_type& other) = delete;
+        concurrent_splay(self_type&& other) = delete;
+
+        self_type& operator = (const self_type& other) = delete;
+        self_type& operator = (self_type&& other) = delete;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const;
+
+        std::size_t size() const;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear();
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        // applies every logged splay
+        void maintain();
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        std::optional<key_type> find(const key_type& value) const;
+
+        bool contains(const key_type& value) const;
+
+        // every key in order, copied under the shared lock
+        std::vector<key_type> keys() const;
+
+        // number of nodes from the root down to the key, 0 if it is absent
+        std::size_t depth(const key_type& value) const;
+
+        // splays applied by maintenance steps so far and the steps that applied them
+        std::size_t deferred_splays() const noexcept;
+        std::size_t maintenance_steps() const noexcept;
+
+    private:
+        struct alignas(detail::cache_line_size) buffer
+        {
+            std::atomic<bool> is_busy{false};
+
+            // written by the reader that holds the buffer, read under the exclusive lock
+            std::array<key_type, buffer_size> keys;
+            std::size_t size = 0;
+        };
+
+        // expects the shared lock; true if the buffer the hit went to is full now
+        bool log_access(const key_type& key) const;
+
+        // takes the exclusive lock
+        void run_maintenance() const;
+
+        // expects the exclusive lock
+        void apply_logged() const;
+
+    private:
+        mutable std::array<buffer, slots_count> buffers;
+
+        mutable std::shared_mutex mutex;
+
+        // readers splay it too, through the maintenance step
+        mutable tree_type tree;
+
+        mutable std::atomic<std::size_t> splays_count{0};
+        mutable std::atomic<std::size_t> steps_count{0};
+    };
+
+} // namespace tree
+
+#include "detail/concurrent_splay.tpp"
@@ -0,0 +1,1074 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key>
+    art<Key>::const_iterator::const_iterator(const self_type* owner, const leaf_type* leaf)
+        : owner{owner}, leaf{leaf}
+    { }
+
+    template <typename Key>
+    const Key& art<Key>::const_iterator::operator * () const
+    {
+        return leaf->value;
+    }
+
+    template <typename Key>
+    const Key* art<Key>::const_iterator::operator -> () const
+    {
+        return &leaf->value;
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator& art<Key>::const_iterator::operator ++ ()
+    {
+        if (leaf != nullptr)
+        {
+            leaf = owner->bound(owner->head, key_traits::encode(leaf->value), 0, leaf->value, true);
+        }
+        return *this;
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Key>
+    bool art<Key>::const_iterator::operator == (const const_iterator& other) const
+    {
+        return leaf == other.leaf;
+    }
+
+    template <typename Key>
+    bool art<Key>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key>
+    art<Key>::art() = default;
+
+    template <typename Key>
+    art<Key>::art(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key>
+    art<Key>::art(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key>
+    art<Key>::art(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key>
+    art<Key>::art(self_type&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+        std::swap(this->m_size, other.m_size);
+    }
+
+    template <typename Key>
+    art<Key>::~art()
+    {
+        this->clear();
+    }
+
+    template <typename Key>
+    art<Key>& art<Key>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key>
+    art<Key>& art<Key>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+            std::swap(this->m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key>
+    typename art<Key>::iterator art<Key>::begin()
+    {
+        return iterator(this, head != nullptr ? minimum(head) : nullptr);
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::begin() const
+    {
+        return const_iterator(this, head != nullptr ? minimum(head) : nullptr);
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key>
+    typename art<Key>::iterator art<Key>::end()
+    {
+        return iterator(this, nullptr);
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::end() const
+    {
+        return const_iterator(this, nullptr);
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key>
+    bool art<Key>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key>
+    std::size_t art<Key>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key>
+    void art<Key>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+        m_size = 0;
+    }
+
+    template <typename Key>
+    typename art<Key>::iterator art<Key>::insert(key_type key)
+    {
+        // the encoding of a string refers to its characters, so it is taken from the leaf
+        auto leaf = new leaf_type(std::move(key));
+        const auto bytes = key_traits::encode(leaf->value);
+
+        node_ptr* link = &head;
+        std::size_t depth = 0;
+
+        while (*link != nullptr)
+        {
+            node_ptr node = *link;
+
+            if (is_leaf(node))
+            {
+                leaf_ptr existing = as_leaf(node);
+                if (existing->value == leaf->value)
+                {
+                    delete leaf;
+                    return iterator(this, existing);
+                }
+
+                // both leaves go below a new node holding the bytes they share
+                const auto existing_bytes = key_traits::encode(existing->value);
+                std::size_t common = depth;
+                while (existing_bytes[common] == bytes[common])
+                {
+                    common++;
+                }
+
+                auto split = new node4_type();
+                split->prefix_length = static_cast<std::uint32_t>(common - depth);
+                for (std::size_t i = 0; i < std::min(common - depth, max_prefix_length); i++)
+                {
+                    split->prefix[i] = bytes[depth + i];
+                }
+
+                *link = split;
+                add_child(*link, existing_bytes[common], node);
+                add_child(*link, bytes[common], as_node(leaf));
+                m_size++;
+                return iterator(this, leaf);
+            }
+
+            if (node->prefix_length > 0)
+            {
+                const std::size_t mismatch = prefix_mismatch(node, bytes, depth);
+                if (mismatch < node->prefix_length)
+                {
+                    // the prefix splits where the key leaves it
+                    auto split = new node4_type();
+                    split->prefix_length = static_cast<std::uint32_t>(mismatch);
+                    std::memcpy(split->prefix, node->prefix, std::min(mismatch, max_prefix_length));
+
+                    std::uint8_t node_byte;
+                    if (node->prefix_length <= max_prefix_length)
+                    {
+                        node_byte = node->prefix[mismatch];
+                        node->prefix_length -= static_cast<std::uint32_t>(mismatch + 1);
+                        std::memmove(node->prefix, node->prefix + mismatch + 1, node->prefix_length);
+                    }
+                    else
+                    {
+                        // the bytes past the stored part are only known from the leaves
+                        const auto min_bytes = key_traits::encode(minimum(node)->value);
+                        node_byte = min_bytes[depth + mismatch];
+                        node->prefix_length -= static_cast<std::uint32_t>(mismatch + 1);
+                        for (std::size_t i = 0; i < std::min<std::size_t>(node->prefix_length, max_prefix_length); i++)
+                        {
+                            node->prefix[i] = min_bytes[depth + mismatch + 1 + i];
+                        }
+                    }
+
+                    *link = split;
+                    add_child(*link, node_byte, node);
+                    add_child(*link, bytes[depth + mismatch], as_node(leaf));
+                    m_size++;
+                    return iterator(this, leaf);
+                }
+                depth += node->prefix_length;
+            }
+
+            node_ptr* child = find_child(node, bytes[depth]);
+            if (child == nullptr)
+            {
+                add_child(*link, bytes[depth], as_node(leaf));
+                m_size++;
+                return iterator(this, leaf);
+            }
+
+            link = child;
+            depth++;
+        }
+
+        *link = as_node(leaf);
+        m_size++;
+        return iterator(this, leaf);
+    }
+
+    template <typename Key>
+    void art<Key>::erase(const key_type& key)
+    {
+        const auto bytes = key_traits::encode(key);
+
+        node_ptr* link = &head;
+        std::size_t depth = 0;
+
+        while (*link != nullptr)
+        {
+            node_ptr node = *link;
+
+            if (is_leaf(node))
+            {   // only the root can be reached this way
+                leaf_ptr leaf = as_leaf(node);
+                if (leaf->value == key)
+                {
+                    *link = nullptr;
+                    delete leaf;
+                    m_size--;
+                }
+                return;
+            }
+
+            if (node->prefix_length > 0)
+            {
+                if (prefix_mismatch(node, bytes, depth) < node->prefix_length)
+                {
+                    return;
+                }
+                depth += node->prefix_length;
+            }
+
+            if (depth >= bytes.size())
+            {
+                return;
+            }
+
+            const std::uint8_t byte = bytes[depth];
+            node_ptr* child = find_child(node, byte);
+            if (child == nullptr)
+            {
+                return;
+            }
+
+            if (is_leaf(*child))
+            {
+                leaf_ptr leaf = as_leaf(*child);
+                if (leaf->value == key)
+                {
+                    // the key may be the leaf itself, so it goes last
+                    remove_child(*link, byte, child);
+                    delete leaf;
+                    m_size--;
+                }
+                return;
+            }
+
+            link = child;
+            depth++;
+        }
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key>
+    typename art<Key>::iterator art<Key>::find(const key_type& value)
+    {
+        return iterator(this, find_leaf(value));
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::find(const key_type& value) const
+    {
+        return const_iterator(this, find_leaf(value));
+    }
+
+    template <typename Key>
+    typename art<Key>::const_iterator art<Key>::lower_bound(const key_type& value) const
+    {
+        return const_iterator(this, bound(head, key_traits::encode(value), 0, value, false));
+    }
+
+    template <typename Key>
+    static_set<Key, std::less<Key>> art<Key>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key>
+    bool art<Key>::is_art() const noexcept
+    {
+        std::vector<int> path;
+        std::size_t leaves = 0;
+        if (head != nullptr && !check(head, path, leaves))
+        {
+            return false;
+        }
+        if (leaves != m_size)
+        {
+            return false;
+        }
+
+        auto current = begin();
+        for (std::size_t i = 1; i < m_size; i++)
+        {
+            auto previous = current++;
+            if (!key_cmp(*previous, *current))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ////////////////
+    //   LEAVES   //
+    ////////////////
+
+    template <typename Key>
+    bool art<Key>::is_leaf(const node_type* node) noexcept
+    {
+        return (reinterpret_cast<std::uintptr_t>(node) & 1u) != 0;
+    }
+
+    template <typename Key>
+    typename art<Key>::leaf_ptr art<Key>::as_leaf(const node_type* node) noexcept
+    {
+        return reinterpret_cast<leaf_ptr>(reinterpret_cast<std::uintptr_t>(node) & ~std::uintptr_t(1));
+    }
+
+    template <typename Key>
+    typename art<Key>::node_ptr art<Key>::as_node(leaf_ptr leaf) noexcept
+    {
+        return reinterpret_cast<node_ptr>(reinterpret_cast<std::uintptr_t>(leaf) | 1u);
+    }
+
+    template <typename Key>
+    typename art<Key>::leaf_ptr art<Key>::minimum(const node_type* node) noexcept
+    {
+        while (!is_leaf(node))
+        {
+            node = next_child(node, 0);
+        }
+        return as_leaf(node);
+    }
+
+    /////////////////////
+    //   INNER NODES   //
+    /////////////////////
+
+    template <typename Key>
+    typename art<Key>::node_ptr* art<Key>::find_child(node_ptr node, std::uint8_t byte) noexcept
+    {
+        switch (node->type)
+        {
+        case detail::art_node_type::node4:
+        {
+            auto inner = static_cast<node4_type*>(node);
+            for (unsigned i = 0; i < inner->count; i++)
+            {
+                if (inner->keys[i] == byte)
+                {
+                    return &inner->children[i];
+                }
+            }
+            return nullptr;
+        }
+        case detail::art_node_type::node16:
+        {
+            auto inner = static_cast<node16_type*>(node);
+            const unsigned index = detail::find_byte16(inner->keys, inner->count, byte);
+            return index < inner->count ? &inner->children[index] : nullptr;
+        }
+        case detail::art_node_type::node48:
+        {
+            auto inner = static_cast<node48_type*>(node);
+            const unsigned index = inner->child_index[byte];
+            return index != 0 ? &inner->children[index - 1] : nullptr;
+        }
+        case detail::art_node_type::node256:
+        {
+            auto inner = static_cast<node256_type*>(node);
+            return inner->children[byte] != nullptr ? &inner->children[byte] : nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    template <typename Key>
+    typename art<Key>::node_ptr art<Key>::next_child(const node_type* node, unsigned byte) noexcept
+    {
+        switch (node->type)
+        {
+        case detail::art_node_type::node4:
+        {
+            auto inner = static_cast<const node4_type*>(node);
+            for (unsigned i = 0; i < inner->count; i++)
+            {
+                if (inner->keys[i] >= byte)
+                {
+                    return inner->children[i];
+                }
+            }
+            return nullptr;
+        }
+        case detail::art_node_type::node16:
+        {
+            auto inner = static_cast<const node16_type*>(node);
+            const unsigned index = byte == 0 ? 0 : detail::count_bytes_not_greater(
+                    inner->keys, inner->count, static_cast<std::uint8_t>(std::min(byte - 1, 255u)));
+            return index < inner->count ? inner->children[index] : nullptr;
+        }
+        case detail::art_node_type::node48:
+        {
+            auto inner = static_cast<const node48_type*>(node);
+            for (; byte < 256; byte++)
+            {
+                if (inner->child_index[byte] != 0)
+                {
+                    return inner->children[inner->child_index[byte] - 1];
+                }
+            }
+            return nullptr;
+        }
+        case detail::art_node_type::node256:
+        {
+            auto inner = static_cast<const node256_type*>(node);
+            for (; byte < 256; byte++)
+            {
+                if (inner->children[byte] != nullptr)
+                {
+                    return inner->children[byte];
+                }
+            }
+            return nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    template <typename Key>
+    template <typename Visitor>
+    void art<Key>::for_each_child(const node_type* node, Visitor&& visit)
+    {
+        switch (node->type)
+        {
+        case detail::art_node_type::node4:
+        {
+            auto inner = static_cast<const node4_type*>(node);
+            for (unsigned i = 0; i < inner->count; i++)
+            {
+                visit(inner->keys[i], inner->children[i]);
+            }
+            break;
+        }
+        case detail::art_node_type::node16:
+        {
+            auto inner = static_cast<const node16_type*>(node);
+            for (unsigned i = 0; i < inner->count; i++)
+            {
+                visit(inner->keys[i], inner->children[i]);
+            }
+            break;
+        }
+        case detail::art_node_type::node48:
+        {
+            auto inner = static_cast<const node48_type*>(node);
+            for (unsigned byte = 0; byte < 256; byte++)
+            {
+                if (inner->child_index[byte] != 0)
+                {
+                    visit(static_cast<std::uint8_t>(byte), inner->children[inner->child_index[byte] - 1]);
+                }
+            }
+            break;
+        }
+        case detail::art_node_type::node256:
+        {
+            auto inner = static_cast<const node256_type*>(node);
+            for (unsigned byte = 0; byte < 256; byte++)
+            {
+                if (inner->children[byte] != nullptr)
+                {
+                    visit(static_cast<std::uint8_t>(byte), inner->children[byte]);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    template <typename Key>
+    void art<Key>::add_child(node_ptr& link, std::uint8_t byte, node_ptr child)
+    {
+        switch (link->type)
+        {
+        case detail::art_node_type::node4:
+        {
+            auto inner = static_cast<node4_type*>(link);
+            if (inner->count < 4)
+            {
+                unsigned position = 0;
+                while (position < inner->count && inner->keys[position] < byte)
+                {
+                    position++;
+                }
+                std::memmove(inner->keys + position + 1, inner->keys + position, inner->count - position);
+                std::memmove(inner->children + position + 1, inner->children + position,
+                             (inner->count - position) * sizeof(node_ptr));
+                inner->keys[position] = byte;
+                inner->children[position] = child;
+                inner->count++;
+                return;
+            }
+
+            auto grown = new node16_type();
+            copy_header(grown, inner);
+            std::memcpy(grown->keys, inner->keys, inner->count);
+            std::memcpy(grown->children, inner->children, inner->count * sizeof(node_ptr));
+            delete inner;
+            link = grown;
+            break;
+        }
+        case detail::art_node_type::node16:
+        {
+            auto inner = static_cast<node16_type*>(link);
+            if (inner->count < 16)
+            {
+                const unsigned position = detail::count_bytes_not_greater(inner->keys, inner->count, byte);
+                std::memmove(inner->keys + position + 1, inner->keys + position, inner->count - position);
+                std::memmove(inner->children + position + 1, inner->children + position,
+                             (inner->count - position) * sizeof(node_ptr));
+                inner->keys[position] = byte;
+                inner->children[position] = child;
+                inner->count++;
+                return;
+            }
+
+            auto grown = new node48_type();
+            copy_header(grown, inner);
+            for (unsigned i = 0; i < inner->count; i++)
+            {
+                grown->child_index[inner->keys[i]] = static_cast<std::uint8_t>(i + 1);
+                grown->children[i] = inner->children[i];
+            }
+            delete inner;
+            link = grown;
+            break;
+        }
+        case detail::art_node_type::node48:
+        {
+            auto inner = static_cast<node48_type*>(link);
+            if (inner->count < 48)
+            {
+                // erases leave holes anywhere in the slots
+                unsigned slot = 0;
+                while (inner->children[slot] != nullptr)
+                {
+                    slot++;
+                }
+                inner->children[slot] = child;
+                inner->child_index[byte] = static_cast<std::uint8_t>(slot + 1);
+                inner->count++;
+                return;
+            }
+
+            auto grown = new node256_type();
+            copy_header(grown, inner);
+            for (unsigned key = 0; key < 256; key++)
+            {
+                if (inner->child_index[key] != 0)
+                {
+                    grown->children[key] = inner->children[inner->child_index[key] - 1];
+                }
+            }
+            delete inner;
+            link = grown;
+            break;
+        }
+        case detail::art_node_type::node256:
+        {
+            auto inner = static_cast<node256_type*>(link);
+            inner->children[byte] = child;
+            inner->count++;
+            return;
+        }
+        }
+
+        add_child(link, byte, child);
+    }
+
+    template <typename Key>
+    void art<Key>::remove_child(node_ptr& link, std::uint8_t byte, node_ptr* slot)
+    {
+        switch (link->type)
+        {
+        case detail::art_node_type::node4:
+        {
+            auto inner = static_cast<node4_type*>(link);
+            const auto position = static_cast<unsigned>(slot - inner->children);
+            std::memmove(inner->keys + position, inner->keys + position + 1, inner->count - position - 1);
+            std::memmove(inner->children + position, inner->children + position + 1,
+                         (inner->count - position - 1) * sizeof(node_ptr));
+            inner->count--;
+
+            if (inner->count == 1)
+            {
+                // the path through this node joins the prefix of the remaining child
+                node_ptr child = inner->children[0];
+                if (!is_leaf(child))
+                {
+                    std::size_t length = inner->prefix_length;
+                    if (length < max_prefix_length)
+                    {
+                        inner->prefix[length] = inner->keys[0];
+                        length++;
+                    }
+                    if (length < max_prefix_length)
+                    {
+                        const std::size_t child_length = std::min<std::size_t>(child->prefix_length,
+                                                                               max_prefix_length - length);
+                        std::memcpy(inner->prefix + length, child->prefix, child_length);
+                        length += child_length;
+                    }
+                    std::memcpy(child->prefix, inner->prefix, std::min(length, max_prefix_length));
+                    child->prefix_length += inner->prefix_length + 1;
+                }
+                delete inner;
+                link = child;
+            }
+            return;
+        }
+        case detail::art_node_type::node16:
+        {
+            auto inner = static_cast<node16_type*>(link);
+            const auto position = static_cast<unsigned>(slot - inner->children);
+            std::memmove(inner->keys + position, inner->keys + position + 1, inner->count - position - 1);
+            std::memmove(inner->children + position, inner->children + position + 1,
+                         (inner->count - position - 1) * sizeof(node_ptr));
+            inner->count--;
+
+            if (inner->count == 3)
+            {
+                auto shrunk = new node4_type();
+                copy_header(shrunk, inner);
+                std::memcpy(shrunk->keys, inner->keys, inner->count);
+                std::memcpy(shrunk->children, inner->children, inner->count * sizeof(node_ptr));
+                delete inner;
+                link = shrunk;
+            }
+            return;
+        }
+        case detail::art_node_type::node48:
+        {
+            auto inner = static_cast<node48_type*>(link);
+            inner->children[inner->child_index[byte] - 1] = nullptr;
+            inner->child_index[byte] = 0;
+            inner->count--;
+
+            if (inner->count == 12)
+            {
+                auto shrunk = new node16_type();
+                copy_header(shrunk, inner);
+                unsigned position = 0;
+                for (unsigned key = 0; key < 256; key++)
+                {
+                    if (inner->child_index[key] != 0)
+                    {
+                        shrunk->keys[position] = static_cast<std::uint8_t>(key);
+                        shrunk->children[position] = inner->children[inner->child_index[key] - 1];
+                        position++;
+                    }
+                }
+                delete inner;
+                link = shrunk;
+            }
+            return;
+        }
+        case detail::art_node_type::node256:
+        {
+            auto inner = static_cast<node256_type*>(link);
+            inner->children[byte] = nullptr;
+            inner->count--;
+
+            if (inner->count == 37)
+            {
+                auto shrunk = new node48_type();
+                copy_header(shrunk, inner);
+                unsigned position = 0;
+                for (unsigned key = 0; key < 256; key++)
+                {
+                    if (inner->children[key] != nullptr)
+                    {
+                        shrunk->children[position] = inner->children[key];
+                        shrunk->child_index[key] = static_cast<std::uint8_t>(position + 1);
+                        position++;
+                    }
+                }
+                delete inner;
+                link = shrunk;
+            }
+            return;
+        }
+        }
+    }
+
+    template <typename Key>
+    void art<Key>::copy_header(node_ptr to, const node_type* from) noexcept
+    {
+        to->count = from->count;
+        to->prefix_length = from->prefix_length;
+        std::memcpy(to->prefix, from->prefix, max_prefix_length);
+    }
+
+    //////////////////
+    //   PREFIXES   //
+    //////////////////
+
+    template <typename Key>
+    template <typename Bytes>
+    std::size_t art<Key>::prefix_mismatch(const node_type* node, const Bytes& bytes, std::size_t depth) noexcept
+    {
+        const std::size_t available = bytes.size() > depth ? bytes.size() - depth : 0;
+
+        const std::size_t stored = std::min({std::size_t(node->prefix_length), max_prefix_length, available});
+        std::size_t i = 0;
+        for (; i < stored; i++)
+        {
+            if (node->prefix[i] != bytes[depth + i])
+            {
+                return i;
+            }
+        }
+
+        if (node->prefix_length > max_prefix_length)
+        {
+            const auto min_bytes = key_traits::encode(minimum(node)->value);
+            const std::size_t length = std::min<std::size_t>(node->prefix_length, available);
+            for (; i < length; i++)
+            {
+                if (min_bytes[depth + i] != bytes[depth + i])
+                {
+                    return i;
+                }
+            }
+        }
+        return i;
+    }
+
+    template <typename Key>
+    template <typename Path, typename Bytes>
+    int art<Key>::compare_path(const Path& path, std::size_t offset, std::size_t length,
+                               const Bytes& bytes, std::size_t depth) noexcept
+    {
+        for (std::size_t i = 0; i < length; i++)
+        {
+            if (depth + i >= bytes.size())
+            {
+                return 1;
+            }
+            if (path[offset + i] != bytes[depth + i])
+            {
+                return path[offset + i] < bytes[depth + i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    ////////////////
+    //   SEARCH   //
+    ////////////////
+
+    template <typename Key>
+    typename art<Key>::leaf_ptr art<Key>::find_leaf(const key_type& value) const
+    {
+        const auto bytes = key_traits::encode(value);
+
+        node_ptr node = head;
+        std::size_t depth = 0;
+
+        while (node != nullptr)
+        {
+            if (is_leaf(node))
+            {
+                leaf_ptr leaf = as_leaf(node);
+                return leaf->value == value ? leaf : nullptr;
+            }
+
+            // Optimistic: only the stored part of the prefix is compared,
+            // the leaf is checked against the whole key anyway
+            if (node->prefix_length > 0)
+            {
+                const std::size_t stored = std::min<std::size_t>(node->prefix_length, max_prefix_length);
+                if (depth + node->prefix_length >= bytes.size())
+                {
+                    return nullptr;
+                }
+                for (std::size_t i = 0; i < stored; i++)
+                {
+                    if (node->prefix[i] != bytes[depth + i])
+                    {
+                        return nullptr;
+                    }
+                }
+                depth += node->prefix_length;
+            }
+
+            if (depth >= bytes.size())
+            {
+                return nullptr;
+            }
+
+            node_ptr* child = find_child(node, bytes[depth]);
+            node = child != nullptr ? *child : nullptr;
+            depth++;
+        }
+        return nullptr;
+    }
+
+    template <typename Key>
+    typename art<Key>::leaf_ptr art<Key>::bound(const node_type* node, const bytes_type& bytes,
+                                                std::size_t depth, const key_type& key, bool strict) const
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (is_leaf(node))
+        {
+            leaf_ptr leaf = as_leaf(node);
+            const bool fits = strict ? key_cmp(key, leaf->value) : !key_cmp(leaf->value, key);
+            return fits ? leaf : nullptr;
+        }
+
+        if (node->prefix_length > 0)
+        {
+            const int order = node->prefix_length <= max_prefix_length
+                              ? compare_path(node->prefix, 0, node->prefix_length, bytes, depth)
+                              : compare_path(key_traits::encode(minimum(node)->value), depth,
+                                             node->prefix_length, bytes, depth);
+            if (order != 0)
+            {
+                // the whole subtree is on one side of the key
+                return order > 0 ? minimum(node) : nullptr;
+            }
+            depth += node->prefix_length;
+        }
+
+        if (depth >= bytes.size())
+        {
+            return minimum(node);
+        }
+
+        const std::uint8_t byte = bytes[depth];
+        if (node_ptr* child = find_child(const_cast<node_ptr>(node), byte))
+        {
+            if (leaf_ptr leaf = bound(*child, bytes, depth + 1, key, strict))
+            {
+                return leaf;
+            }
+        }
+
+        const node_type* next = next_child(node, byte + 1u);
+        return next != nullptr ? minimum(next) : nullptr;
+    }
+
+    template <typename Key>
+    void art<Key>::destroy(node_ptr node) noexcept
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+
+        if (is_leaf(node))
+        {
+            delete as_leaf(node);
+            return;
+        }
+
+        for_each_child(node, [](std::uint8_t, node_ptr child) { destroy(child); });
+
+        switch (node->type)
+        {
+        case detail::art_node_type::node4:
+            delete static_cast<node4_type*>(node);
+            break;
+        case detail::art_node_type::node16:
+            delete static_cast<node16_type*>(node);
+            break;
+        case detail::art_node_type::node48:
+            delete static_cast<node48_type*>(node);
+            break;
+        case detail::art_node_type::node256:
+            delete static_cast<node256_type*>(node);
+            break;
+        }
+    }
+
+    template <typename Key>
+    bool art<Key>::check(const node_type* node, std::vector<int>& path, std::size_t& leaves) const
+    {
+        if (is_leaf(node))
+        {
+            leaves++;
+            const auto bytes = key_traits::encode(as_leaf(node)->value);
+            if (path.size() > bytes.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < path.size(); i++)
+            {
+                // -1 marks a prefix byte that is not stored in its node
+                if (path[i] != -1 && path[i] != bytes[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::size_t min_count = 0;
+        std::size_t max_count = 0;
+        switch (node->type)
+        {
+        case detail::art_node_type::node4:
+            min_count = 2;
+            max_count = 4;
+            break;
+        case detail::art_node_type::node16:
+            min_count = 4;
+            max_count = 16;
+            break;
+        case detail::art_node_type::node48:
+            min_count = 13;
+            max_count = 48;
+            break;
+        case detail::art_node_type::node256:
+            min_count = 38;
+            max_count = 256;
+            break;
+        }
+        if (node->count < min_count || node->count > max_count)
+        {
+            return false;
+        }
+
+        const std::size_t depth = path.size();
+        for (std::size_t i = 0; i < node->prefix_length; i++)
+        {
+            path.push_back(i < max_prefix_length ? node->prefix[i] : -1);
+        }
+
+        bool valid = true;
+        int previous = -1;
+        std::size_t children = 0;
+        for_each_child(node, [&](std::uint8_t byte, node_ptr child)
+        {
+            valid = valid && child != nullptr && int(byte) > previous;
+            previous = byte;
+            children++;
+
+            if (valid)
+            {
+                path.push_back(byte);
+                valid = check(child, path, leaves);
+                path.pop_back();
+            }
+        });
+
+        path.resize(depth);
+        return valid && children == node->count;
+    }
+
+} // namespace tree
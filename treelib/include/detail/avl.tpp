@@ -39,6 +39,8 @@ namespace tree
     {
         std::swap(this->head, other.head);
         std::swap(this->m_size, other.m_size);
+        std::swap(this->relaxed, other.relaxed);
+        std::swap(this->pool, other.pool);
     }
 
     template <typename Key, typename Compare>
@@ -73,6 +75,36 @@ namespace tree
         return *this;
     }
 
+    template <typename Key, typename Compare>
+    template <typename InputIt, typename ExecutionPolicy>
+    avl<Key, Compare> avl<Key, Compare>::from_unsorted(InputIt first, InputIt last, const ExecutionPolicy& policy)
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        thread_pool* executor = detail::executor_of(policy);
+
+        self_type result;
+        auto keys = detail::sorted_unique<key_type>(first, last, result.key_cmp, executor);
+        result.head = result.build_sorted(keys, 0, keys.size(), executor).first;
+        result.m_size = keys.size();
+        return result;
+    }
+
+    template <typename Key, typename Compare>
+    template <typename ExecutionPolicy>
+    avl<Key, Compare> avl<Key, Compare>::clone(const ExecutionPolicy& policy) const
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        avl<key_type, key_compare> result;
+        result.head = detail::parallel_clone<node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy));
+        result.m_size = m_size;
+        result.key_cmp = key_cmp;
+        result.relaxed = relaxed;
+        result.count_accesses = count_accesses;
+        return result;
+    }
+
     ///////////////////
     //   ITERATORS   //
     ///////////////////
@@ -113,6 +145,31 @@ namespace tree
         return const_iterator(std::make_optional<node_ptr>(nullptr));
     }
 
+    ///////////////////
+    //   TRAVERSAL   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    template <typename Function, typename ExecutionPolicy>
+    void avl<Key, Compare>::for_each(Function function, const ExecutionPolicy& policy) const
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        detail::parallel_visit<node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy),
+                                          [&](const node_type* node) { function(node->value); });
+    }
+
+    template <typename Key, typename Compare>
+    template <typename T, typename Accumulate, typename Combine, typename ExecutionPolicy>
+    T avl<Key, Compare>::reduce(T identity, Accumulate accumulate, Combine combine,
+                                const ExecutionPolicy& policy) const
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        return detail::parallel_reduce<T, node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy),
+                                                     identity, accumulate, combine);
+    }
+
     //////////////////
     //   CAPACITY   //
     //////////////////
@@ -149,13 +206,18 @@ namespace tree
         std::cerr << "insert" << std::endl;
 #endif
 
+        if (relaxed)
+        {
+            return insert_relaxed(std::move(key));
+        }
+
         clear_cache();
 
         node_ptr child = nullptr;
 
         if (head == nullptr)
         {
-            head = new node_type(key);
+            head = create_node(key);
         }
         else
         {
@@ -168,12 +230,12 @@ namespace tree
             auto is_right_child = static_cast<bool>(cmp_cache.back());
             if (!is_right_child)
             {
-                child = new node_type{key};
+                child = create_node(key);
                 parent->left = child;
             }
             else
             {
-                child = new node_type{key};
+                child = create_node(key);
                 parent->right = child;
             }
 
@@ -206,6 +268,12 @@ namespace tree
     template <typename Key, typename Compare>
     void avl<Key, Compare>::erase(const key_type& key)
     {
+        if (relaxed)
+        {
+            erase_relaxed(key);
+            return;
+        }
+
         clear_cache();
 
         // caching until the key
@@ -218,7 +286,7 @@ namespace tree
         if (m_size == 1)
         {   // it's the onliest node
             m_size--;
-            delete head;
+            destroy_node(head);
             head = nullptr;
             return;
         }
@@ -265,7 +333,7 @@ namespace tree
                 cmp_cache.push_back(false);
             }
 
-            delete node;
+            destroy_node(node);
         }
         else
         {
@@ -305,7 +373,7 @@ namespace tree
                 path_cache.push(right_child);
                 cmp_cache.push_back(true);
 
-                delete node;
+                destroy_node(node);
             }
             else
             {
@@ -367,7 +435,7 @@ namespace tree
                     path_cache_to_next.pop();
                 }
 
-                delete node;
+                destroy_node(node);
             }
         }
 
@@ -518,6 +586,182 @@ namespace tree
         m_size--;
     }
 
+    template <typename Key, typename Compare>
+    std::vector<bool> avl<Key, Compare>::apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                                     const sequenced_policy&)
+    {
+        return apply_batch(batch, nullptr);
+    }
+
+    template <typename Key, typename Compare>
+    std::vector<bool> avl<Key, Compare>::apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                                     const parallel_policy& policy)
+    {
+        // nodes of a pool are taken and given back from one thread
+        return apply_batch(batch, pool == nullptr ? detail::executor_of(policy) : nullptr);
+    }
+
+    /////////////////////////
+    //   RELAXED BALANCE   //
+    /////////////////////////
+
+    template <typename Key, typename Compare>
+    void avl<Key, Compare>::set_relaxed(bool relaxed)
+    {
+        if (!relaxed)
+        {
+            rebalance_step(std::numeric_limits<std::size_t>::max());
+        }
+        this->relaxed = relaxed;
+    }
+
+    template <typename Key, typename Compare>
+    bool avl<Key, Compare>::is_relaxed() const noexcept
+    {
+        return relaxed;
+    }
+
+    template <typename Key, typename Compare>
+    bool avl<Key, Compare>::rebalance_step(std::size_t budget)
+    {
+        // marks are closed upwards, so the marked nodes form a subtree at the root:
+        // walk it in post-order and rebuild every node from its already repaired children
+        std::vector<node_ptr> path;
+        if (head != nullptr && head->is_marked)
+        {
+            path.push_back(head);
+        }
+
+        while (!path.empty() && budget > 0)
+        {
+            node_ptr node = path.back();
+            if (node->left != nullptr && node->left->is_marked)
+            {
+                path.push_back(node->left);
+                continue;
+            }
+            if (node->right != nullptr && node->right->is_marked)
+            {
+                path.push_back(node->right);
+                continue;
+            }
+            path.pop_back();
+
+            node_ptr lhs = node->left;
+            node_ptr rhs = node->right;
+            node->left = nullptr;
+            node->right = nullptr;
+            node->is_marked = false;
+
+            node_ptr subtree = join(lhs, height(lhs), node, rhs, height(rhs)).first;
+            if (path.empty())
+            {
+                head = subtree;
+            }
+            else if (path.back()->left == node)
+            {
+                path.back()->left = subtree;
+            }
+            else
+            {
+                path.back()->right = subtree;
+            }
+
+            budget--;
+        }
+
+        return head == nullptr || !head->is_marked;
+    }
+
+    template <typename Key, typename Compare>
+    typename avl<Key, Compare>::node_ptr avl<Key, Compare>::insert_relaxed(key_type key)
+    {
+        // the path is marked on the way down, a duplicate key leaves marks
+        // whose repair changes nothing
+        node_ptr* link = &head;
+        while (*link != nullptr)
+        {
+            node_ptr current = *link;
+            current->is_marked = true;
+
+            if (key_cmp(key, current->value))
+            {
+                link = &current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                link = &current->right;
+            }
+            else
+            {
+                return current;
+            }
+        }
+
+        // a new leaf is balanced on its own
+        auto child = create_node(std::move(key));
+        *link = child;
+        m_size++;
+        return child;
+    }
+
+    template <typename Key, typename Compare>
+    void avl<Key, Compare>::erase_relaxed(const key_type& key)
+    {
+        node_ptr* link = &head;
+        while (*link != nullptr)
+        {
+            node_ptr current = *link;
+            current->is_marked = true;
+
+            if (key_cmp(key, current->value))
+            {
+                link = &current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                link = &current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        node_ptr node = *link;
+        if (node == nullptr)
+        {   // no such key found
+            return;
+        }
+
+        if (node->left == nullptr || node->right == nullptr)
+        {
+            // the only child is an unmarked subtree and takes the place of the node
+            *link = node->left != nullptr ? node->left : node->right;
+        }
+        else
+        {
+            // the in-order successor takes the place of the node,
+            // the path down to it is marked as well
+            node_ptr* next_link = &node->right;
+            while ((*next_link)->left != nullptr)
+            {
+                (*next_link)->is_marked = true;
+                next_link = &(*next_link)->left;
+            }
+
+            node_ptr next = *next_link;
+            *next_link = next->right;
+            next->left = node->left;
+            next->right = node->right;
+            next->is_marked = true;
+            *link = next;
+        }
+
+        destroy_node(node);
+        m_size--;
+    }
+
     /////////////////
     //   LOOK UP   //
     /////////////////
@@ -542,6 +786,11 @@ namespace tree
             }
         }
 
+        if (count_accesses && current != nullptr)
+        {
+            current->accesses += current->accesses != std::numeric_limits<std::uint32_t>::max() ? 1 : 0;
+        }
+
         return iterator(head, current);
     }
 
@@ -568,6 +817,91 @@ namespace tree
         return const_iterator(head, current);
     }
 
+    template <typename Key, typename Compare>
+    static_set<Key, Compare> avl<Key, Compare>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key, typename Compare>
+    void avl<Key, Compare>::set_access_counting(bool enabled)
+    {
+        if (enabled)
+        {
+            std::vector<node_ptr> stack;
+            if (head != nullptr)
+            {
+                stack.push_back(head);
+            }
+            while (!stack.empty())
+            {
+                node_ptr node = stack.back();
+                stack.pop_back();
+                node->accesses = 0;
+
+                if (node->left != nullptr)
+                {
+                    stack.push_back(node->left);
+                }
+                if (node->right != nullptr)
+                {
+                    stack.push_back(node->right);
+                }
+            }
+        }
+        count_accesses = enabled;
+    }
+
+    template <typename Key, typename Compare>
+    std::vector<std::pair<Key, std::size_t>> avl<Key, Compare>::access_weights() const
+    {
+        std::vector<std::pair<key_type, std::size_t>> weights;
+        weights.reserve(m_size);
+
+        // in-order walk over the nodes
+        std::vector<node_ptr> stack;
+        node_ptr node = head;
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+
+            weights.emplace_back(node->value, node->accesses);
+            node = node->right;
+        }
+
+        return weights;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t avl<Key, Compare>::depth(const key_type& value) const
+    {
+        std::size_t depth = 1;
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                return depth;
+            }
+            depth++;
+        }
+        return 0;
+    }
+
 
     template <typename Key, typename Compare>
     [[nodiscard]] bool avl<Key, Compare>::is_avl(node_ptr subtree) const noexcept
@@ -873,6 +1207,278 @@ namespace tree
         return subtree;
     }
 
+    template <typename Key, typename Compare>
+    int avl<Key, Compare>::height(node_ptr subtree) noexcept
+    {
+        int height = -1;
+        while (subtree != nullptr)
+        {
+            height++;
+            subtree = subtree->balance == detail::balance_factor::lhs_1 ? subtree->left : subtree->right;
+        }
+        return height;
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::join(node_ptr lhs, int lhs_height, node_ptr middle, node_ptr rhs, int rhs_height)
+    {
+        if (lhs_height > rhs_height + 1)
+        {
+            return join_right(lhs, lhs_height, middle, rhs, rhs_height);
+        }
+        if (rhs_height > lhs_height + 1)
+        {
+            return join_left(lhs, lhs_height, middle, rhs, rhs_height);
+        }
+
+        middle->left = lhs;
+        middle->right = rhs;
+        middle->balance = detail::balance_factor(rhs_height - lhs_height);
+        return {middle, std::max(lhs_height, rhs_height) + 1};
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::join_right(node_ptr lhs, int lhs_height, node_ptr middle, node_ptr rhs, int rhs_height)
+    {
+        using detail::balance_factor;
+
+        node_ptr inner = lhs->right;
+        const int left_height = lhs_height - (lhs->balance == balance_factor::rhs_1 ? 2 : 1);
+        const int inner_height = lhs_height - (lhs->balance == balance_factor::lhs_1 ? 2 : 1);
+
+        std::pair<node_ptr, int> joined;
+        if (inner_height <= rhs_height + 1)
+        {
+            middle->left = inner;
+            middle->right = rhs;
+            middle->balance = balance_factor(rhs_height - inner_height);
+            joined = {middle, std::max(inner_height, rhs_height) + 1};
+        }
+        else
+        {
+            joined = join_right(inner, inner_height, middle, rhs, rhs_height);
+        }
+
+        lhs->right = joined.first;
+        if (joined.second <= left_height + 1)
+        {
+            lhs->balance = balance_factor(joined.second - left_height);
+            return {lhs, std::max(left_height, joined.second) + 1};
+        }
+
+        // the right side is two levels higher
+        lhs->balance = balance_factor::rhs_2;
+        if (joined.first->balance == balance_factor::zero)
+        {
+            node_ptr subtree = rotate_left(lhs);
+            subtree->balance = balance_factor::lhs_1;
+            lhs->balance = balance_factor::rhs_1;
+            return {subtree, left_height + 3};
+        }
+        return {rebalance(lhs), left_height + 2};
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::join_left(node_ptr lhs, int lhs_height, node_ptr middle, node_ptr rhs, int rhs_height)
+    {
+        using detail::balance_factor;
+
+        node_ptr inner = rhs->left;
+        const int right_height = rhs_height - (rhs->balance == balance_factor::lhs_1 ? 2 : 1);
+        const int inner_height = rhs_height - (rhs->balance == balance_factor::rhs_1 ? 2 : 1);
+
+        std::pair<node_ptr, int> joined;
+        if (inner_height <= lhs_height + 1)
+        {
+            middle->left = lhs;
+            middle->right = inner;
+            middle->balance = balance_factor(inner_height - lhs_height);
+            joined = {middle, std::max(lhs_height, inner_height) + 1};
+        }
+        else
+        {
+            joined = join_left(lhs, lhs_height, middle, inner, inner_height);
+        }
+
+        rhs->left = joined.first;
+        if (joined.second <= right_height + 1)
+        {
+            rhs->balance = balance_factor(right_height - joined.second);
+            return {rhs, std::max(right_height, joined.second) + 1};
+        }
+
+        // the left side is two levels higher
+        rhs->balance = balance_factor::lhs_2;
+        if (joined.first->balance == balance_factor::zero)
+        {
+            node_ptr subtree = rotate_right(rhs);
+            subtree->balance = balance_factor::rhs_1;
+            rhs->balance = balance_factor::lhs_1;
+            return {subtree, right_height + 3};
+        }
+        return {rebalance(rhs), right_height + 2};
+    }
+
+    //////////////////
+    //   BATCHING   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    std::vector<bool> avl<Key, Compare>::apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                                     thread_pool* executor)
+    {
+        // the batch is joined into unmarked subtrees only
+        rebalance_step(std::numeric_limits<std::size_t>::max());
+
+        detail::batch_plan<key_type> plan(batch, key_cmp);
+        head = apply_groups(head, height(head), 0, plan.groups_count(), plan, executor).first;
+        m_size = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(m_size) + plan.size_change());
+        return plan.results();
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::apply_groups(node_ptr subtree, int subtree_height, std::size_t first, std::size_t last,
+                                    detail::batch_plan<key_type>& plan, thread_pool* executor)
+    {
+        using detail::balance_factor;
+
+        if (first == last)
+        {
+            return {subtree, subtree_height};
+        }
+
+        if (subtree == nullptr)
+        {
+            // none of the keys is there, the ones still there after their group make a new subtree
+            std::vector<node_ptr> nodes;
+            for (std::size_t group = first; group < last; group++)
+            {
+                if (plan.resolve(group, false))
+                {
+                    nodes.push_back(create_node(plan.key(group)));
+                }
+            }
+            return build(nodes, 0, nodes.size());
+        }
+
+        const std::size_t middle = plan.lower_bound(first, last, subtree->value, key_cmp);
+        const bool is_hit = middle != last && !key_cmp(subtree->value, plan.key(middle));
+        const std::size_t rhs_first = is_hit ? middle + 1 : middle;
+
+        node_ptr lhs = subtree->left;
+        node_ptr rhs = subtree->right;
+        const int lhs_height = subtree_height - (subtree->balance == balance_factor::rhs_1 ? 2 : 1);
+        const int rhs_height = subtree_height - (subtree->balance == balance_factor::lhs_1 ? 2 : 1);
+
+        // the two sides share no node and no group
+        const auto [lhs_result, rhs_result] = detail::fork_join(
+                last - first >= batch_parallel_cutoff ? executor : nullptr,
+                [&]() { return apply_groups(lhs, lhs_height, first, middle, plan, executor); },
+                [&]() { return apply_groups(rhs, rhs_height, rhs_first, last, plan, executor); });
+
+        if (!is_hit || plan.resolve(middle, true))
+        {
+            return join(lhs_result.first, lhs_result.second, subtree, rhs_result.first, rhs_result.second);
+        }
+
+        destroy_node(subtree);
+        return join(lhs_result.first, lhs_result.second, rhs_result.first, rhs_result.second);
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::build_sorted(std::vector<key_type>& keys, std::size_t first, std::size_t last,
+                                    thread_pool* executor)
+    {
+        using detail::balance_factor;
+
+        if (first == last)
+        {
+            return {nullptr, -1};
+        }
+
+        // the parent is allocated before its subtrees, so a path down the tree goes forward in memory
+        const std::size_t middle = first + (last - first) / 2;
+        node_ptr node = create_node(std::move(keys[middle]));
+
+        const auto [lhs, rhs] = detail::fork_join(
+                last - first > detail::parallel_grain ? executor : nullptr,
+                [&]() { return build_sorted(keys, first, middle, executor); },
+                [&]() { return build_sorted(keys, middle + 1, last, executor); });
+
+        // the halves differ in size by at most one, and so do their heights
+        node->left = lhs.first;
+        node->right = rhs.first;
+        if (lhs.second < rhs.second)
+        {
+            node->balance = balance_factor::rhs_1;
+        }
+        else if (lhs.second > rhs.second)
+        {
+            node->balance = balance_factor::lhs_1;
+        }
+        return {node, std::max(lhs.second, rhs.second) + 1};
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::build(const std::vector<node_ptr>& nodes, std::size_t first, std::size_t last)
+    {
+        if (first == last)
+        {
+            return {nullptr, -1};
+        }
+
+        const std::size_t middle = first + (last - first) / 2;
+        const auto lhs = build(nodes, first, middle);
+        const auto rhs = build(nodes, middle + 1, last);
+        return join(lhs.first, lhs.second, nodes[middle], rhs.first, rhs.second);
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::join(node_ptr lhs, int lhs_height, node_ptr rhs, int rhs_height)
+    {
+        if (lhs == nullptr)
+        {
+            return {rhs, rhs_height};
+        }
+        if (rhs == nullptr)
+        {
+            return {lhs, lhs_height};
+        }
+
+        // the least key of rhs goes between the two
+        node_ptr min = nullptr;
+        const auto rest = remove_min(rhs, rhs_height, min);
+        return join(lhs, lhs_height, min, rest.first, rest.second);
+    }
+
+    template <typename Key, typename Compare>
+    std::pair<typename avl<Key, Compare>::node_ptr, int>
+    avl<Key, Compare>::remove_min(node_ptr subtree, int subtree_height, node_ptr& min)
+    {
+        using detail::balance_factor;
+
+        node_ptr rhs = subtree->right;
+        if (subtree->left == nullptr)
+        {
+            // a missing left child makes the right one a leaf at most
+            min = subtree;
+            min->right = nullptr;
+            return {rhs, subtree_height - 1};
+        }
+
+        const int lhs_height = subtree_height - (subtree->balance == balance_factor::rhs_1 ? 2 : 1);
+        const int rhs_height = subtree_height - (subtree->balance == balance_factor::lhs_1 ? 2 : 1);
+        const auto rest = remove_min(subtree->left, lhs_height, min);
+        return join(rest.first, rest.second, subtree, rhs, rhs_height);
+    }
+
     template <typename Key, typename Compare>
     void avl<Key, Compare>::clear_cache() const
     {
@@ -886,4 +1492,25 @@ namespace tree
         branch_root = nullptr;
     }
 
+    template <typename Key, typename Compare>
+    typename avl<Key, Compare>::node_ptr avl<Key, Compare>::create_node(key_type key)
+    {
+        if (pool != nullptr)
+        {
+            return pool->create(std::move(key));
+        }
+        return new node_type(std::move(key));
+    }
+
+    template <typename Key, typename Compare>
+    void avl<Key, Compare>::destroy_node(node_ptr node) noexcept
+    {
+        if (pool != nullptr)
+        {
+            pool->release(node);
+            return;
+        }
+        delete node;
+    }
+
 } // namespace tree
\ No newline at end of file
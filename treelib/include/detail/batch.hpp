@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
+namespace tree
+{
+    enum class batch_kind : std::uint8_t {insert, erase};
+
+    // one operation of a batch for apply_batch
+    template <typename Key>
+    struct batch_operation
+    {
+        batch_kind kind;
+        Key key;
+    };
+
+} // namespace tree
+
+namespace tree::detail
+{
+    ////////////////////
+    //   BATCH PLAN   //
+    ////////////////////
+
+    // The operations of a batch in key order, grouped by equal keys, every group in batch
+    // order. A group only depends on whether its key was there before it, so disjoint ranges
+    // of groups may be resolved from different threads.
+    template <typename Key>
+    class batch_plan
+    {
+    public:
+        template <typename Compare>
+        batch_plan(const std::vector<batch_operation<Key>>& batch, const Compare& key_cmp)
+            : batch{batch},
+              order(batch.size()),
+              changed(batch.size(), 0)
+        {
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs)
+            {
+                return key_cmp(batch[lhs].key, batch[rhs].key);
+            });
+
+            for (std::size_t index = 0; index < order.size(); index++)
+            {
+                if (index == 0 || key_cmp(batch[order[index - 1]].key, batch[order[index]].key))
+                {
+                    group_begin.push_back(index);
+                }
+            }
+            group_begin.push_back(order.size());
+            group_change.assign(groups_count(), 0);
+        }
+
+        std::size_t groups_count() const noexcept
+        {
+            return group_begin.size() - 1;
+        }
+
+        const Key& key(std::size_t group) const noexcept
+        {
+            return batch[order[group_begin[group]]].key;
+        }
+
+        // the first group in [first, last) whose key is not less than the value
+        template <typename Compare>
+        std::size_t lower_bound(std::size_t first, std::size_t last, const Key& value, const Compare& key_cmp) const
+        {
+            while (first < last)
+            {
+                const std::size_t middle = first + (last - first) / 2;
+                if (key_cmp(key(middle), value))
+                {
+                    first = middle + 1;
+                }
+                else
+                {
+                    last = middle;
+                }
+            }
+            return first;
+        }
+
+        // applies the operations of the group in batch order to a key that was there or not,
+        // records what each of them changed and tells whether the key is there afterwards
+        bool resolve(std::size_t group, bool is_present) noexcept
+        {
+            const bool was_present = is_present;
+            for (std::size_t index = group_begin[group]; index < group_begin[group + 1]; index++)
+            {
+                const bool is_insert = batch[order[index]].kind == batch_kind::insert;
+                changed[order[index]] = is_insert != is_present;
+                is_present = is_insert;
+            }
+
+            group_change[group] = static_cast<std::int8_t>(int(is_present) - int(was_present));
+            return is_present;
+        }
+
+        // whether each operation changed the tree, in batch order
+        std::vector<bool> results() const
+        {
+            return std::vector<bool>(changed.begin(), changed.end());
+        }
+
+        // keys added minus keys removed, once every group is resolved
+        std::ptrdiff_t size_change() const noexcept
+        {
+            return std::accumulate(group_change.begin(), group_change.end(), std::ptrdiff_t(0));
+        }
+
+    private:
+        const std::vector<batch_operation<Key>>& batch;
+
+        // indices of the operations sorted by key, and where every group starts among them
+        std::vector<std::size_t> order;
+        std::vector<std::size_t> group_begin;
+
+        // bytes rather than bits, written from different threads
+        std::vector<std::int8_t> group_change;
+        std::vector<unsigned char> changed;
+    };
+
+} // namespace tree::detail
@@ -0,0 +1,843 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::const_iterator::const_iterator(const self_type* owner,
+                                                                   const leaf_type* leaf,
+                                                                   std::size_t index)
+        : owner{owner}, leaf{leaf}, index{index}
+    { }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    const Key& btree<Key, Compare, NodeBytes>::const_iterator::operator * () const
+    {
+        return leaf->keys[index];
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator&
+    btree<Key, Compare, NodeBytes>::const_iterator::operator ++ ()
+    {
+        if (leaf == nullptr)
+        {
+            return *this;
+        }
+
+        index++;
+        if (index == leaf->count)
+        {
+            leaf = leaf->next;
+            index = 0;
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator
+    btree<Key, Compare, NodeBytes>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator&
+    btree<Key, Compare, NodeBytes>::const_iterator::operator -- ()
+    {
+        if (leaf == nullptr)
+        {   // prev from end()
+            leaf = owner->last_leaf;
+            index = leaf->count - 1;
+        }
+        else if (index == 0)
+        {
+            leaf = leaf->prev;
+            index = leaf->count - 1;
+        }
+        else
+        {
+            index--;
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator
+    btree<Key, Compare, NodeBytes>::const_iterator::operator -- (int)
+    {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    bool btree<Key, Compare, NodeBytes>::const_iterator::operator == (const const_iterator& other) const
+    {
+        return leaf == other.leaf && index == other.index;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    bool btree<Key, Compare, NodeBytes>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::btree() = default;
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::btree(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::btree(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::btree(const self_type& other)
+    {
+        this->bulk_load(other.begin(), other.end());
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::btree(self_type&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+        std::swap(this->first_leaf, other.first_leaf);
+        std::swap(this->last_leaf, other.last_leaf);
+        std::swap(this->m_size, other.m_size);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>::~btree()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>& btree<Key, Compare, NodeBytes>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->bulk_load(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    btree<Key, Compare, NodeBytes>& btree<Key, Compare, NodeBytes>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+            std::swap(this->first_leaf, other.first_leaf);
+            std::swap(this->last_leaf, other.last_leaf);
+            std::swap(this->m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::iterator btree<Key, Compare, NodeBytes>::begin()
+    {
+        return iterator(this, first_leaf, 0);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator btree<Key, Compare, NodeBytes>::begin() const
+    {
+        return const_iterator(this, first_leaf, 0);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator btree<Key, Compare, NodeBytes>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::iterator btree<Key, Compare, NodeBytes>::end()
+    {
+        return iterator(this, nullptr, 0);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator btree<Key, Compare, NodeBytes>::end() const
+    {
+        return const_iterator(this, nullptr, 0);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator btree<Key, Compare, NodeBytes>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    bool btree<Key, Compare, NodeBytes>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    std::size_t btree<Key, Compare, NodeBytes>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+        first_leaf = nullptr;
+        last_leaf = nullptr;
+        m_size = 0;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::iterator btree<Key, Compare, NodeBytes>::insert(key_type key)
+    {
+        if (head == nullptr)
+        {
+            auto leaf = new leaf_type();
+            leaf->keys[0] = std::move(key);
+            leaf->count = 1;
+
+            head = leaf;
+            first_leaf = leaf;
+            last_leaf = leaf;
+            m_size = 1;
+            return iterator(this, leaf, 0);
+        }
+
+        leaf_ptr leaf = descend(key);
+        std::size_t position = lower_index(leaf->keys, leaf->count, key);
+        if (position < leaf->count && !key_cmp(key, leaf->keys[position]))
+        {
+            return iterator(this, leaf, position);
+        }
+
+        m_size++;
+
+        if (leaf->count < leaf_capacity)
+        {
+            std::move_backward(leaf->keys + position, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            leaf->keys[position] = std::move(key);
+            leaf->count++;
+            return iterator(this, leaf, position);
+        }
+
+        // the leaf is full: move its upper half to a new right sibling,
+        // then put the key into whichever half it belongs to
+        auto right = new leaf_type();
+        const std::size_t left_count = (leaf_capacity + 1) / 2;
+        const bool goes_left = position < left_count;
+        const std::size_t moved_from = goes_left ? left_count - 1 : left_count;
+
+        std::move(leaf->keys + moved_from, leaf->keys + leaf->count, right->keys);
+        right->count = static_cast<std::uint16_t>(leaf->count - moved_from);
+        leaf->count = static_cast<std::uint16_t>(moved_from);
+
+        leaf_ptr target = goes_left ? leaf : right;
+        if (!goes_left)
+        {
+            position -= moved_from;
+        }
+        std::move_backward(target->keys + position, target->keys + target->count, target->keys + target->count + 1);
+        target->keys[position] = std::move(key);
+        target->count++;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr)
+        {
+            leaf->next->prev = right;
+        }
+        else
+        {
+            last_leaf = right;
+        }
+        leaf->next = right;
+
+        insert_into_parent(right->keys[0], right);
+        return iterator(this, target, position);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::erase(const key_type& key)
+    {
+        if (head == nullptr)
+        {
+            return;
+        }
+
+        leaf_ptr leaf = descend(key);
+        const std::size_t position = lower_index(leaf->keys, leaf->count, key);
+        if (position == leaf->count || key_cmp(key, leaf->keys[position]))
+        {   // no such key found
+            return;
+        }
+
+        std::move(leaf->keys + position + 1, leaf->keys + leaf->count, leaf->keys + position);
+        leaf->count--;
+        m_size--;
+
+        if (leaf == head)
+        {
+            if (leaf->count == 0)
+            {
+                delete leaf;
+                head = nullptr;
+                first_leaf = nullptr;
+                last_leaf = nullptr;
+            }
+            return;
+        }
+
+        // separators may keep the erased key: they only have to route the search
+        if (leaf->count < leaf_min)
+        {
+            rebalance_leaf(leaf);
+        }
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    template <typename InputIt>
+    void btree<Key, Compare, NodeBytes>::bulk_load(InputIt first, InputIt last)
+    {
+        clear();
+
+        std::vector<key_type> keys(first, last);
+        if (keys.empty())
+        {
+            return;
+        }
+
+        // step 1: spread the keys evenly over the fewest leaves that can hold them,
+        //         so that every leaf is at least half full
+        const std::size_t leaf_count = (keys.size() + leaf_capacity - 1) / leaf_capacity;
+
+        std::vector<std::pair<node_ptr, key_type>> level;
+        level.reserve(leaf_count);
+
+        leaf_ptr previous = nullptr;
+        std::size_t consumed = 0;
+        for (std::size_t i = 0; i < leaf_count; i++)
+        {
+            const std::size_t count = keys.size() / leaf_count + (i < keys.size() % leaf_count ? 1 : 0);
+
+            auto leaf = new leaf_type();
+            std::move(keys.begin() + consumed, keys.begin() + consumed + count, leaf->keys);
+            leaf->count = static_cast<std::uint16_t>(count);
+            consumed += count;
+
+            leaf->prev = previous;
+            if (previous != nullptr)
+            {
+                previous->next = leaf;
+            }
+            else
+            {
+                first_leaf = leaf;
+            }
+            previous = leaf;
+
+            level.emplace_back(leaf, leaf->keys[0]);
+        }
+        last_leaf = previous;
+        m_size = keys.size();
+
+        // step 2: group every level evenly under the fewest inner nodes, up to a single root
+        while (level.size() > 1)
+        {
+            const std::size_t node_count = (level.size() + inner_capacity) / (inner_capacity + 1);
+
+            std::vector<std::pair<node_ptr, key_type>> parents;
+            parents.reserve(node_count);
+
+            std::size_t taken = 0;
+            for (std::size_t i = 0; i < node_count; i++)
+            {
+                const std::size_t children = level.size() / node_count + (i < level.size() % node_count ? 1 : 0);
+
+                auto node = new inner_type();
+                for (std::size_t child = 0; child < children; child++)
+                {
+                    node->children[child] = level[taken + child].first;
+                    if (child > 0)
+                    {
+                        node->keys[child - 1] = level[taken + child].second;
+                    }
+                }
+                node->count = static_cast<std::uint16_t>(children - 1);
+
+                parents.emplace_back(node, level[taken].second);
+                taken += children;
+            }
+
+            level = std::move(parents);
+        }
+
+        head = level.front().first;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::iterator btree<Key, Compare, NodeBytes>::find(const key_type& value)
+    {
+        return static_cast<const self_type&>(*this).find(value);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::const_iterator
+    btree<Key, Compare, NodeBytes>::find(const key_type& value) const
+    {
+        if (head == nullptr)
+        {
+            return end();
+        }
+
+        const leaf_ptr leaf = find_leaf(value);
+        const std::size_t position = lower_index(leaf->keys, leaf->count, value);
+        if (position < leaf->count && !key_cmp(value, leaf->keys[position]))
+        {
+            return const_iterator(this, leaf, position);
+        }
+
+        return end();
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    bool btree<Key, Compare, NodeBytes>::is_btree() const noexcept
+    {
+        if (head == nullptr)
+        {
+            return m_size == 0 && first_leaf == nullptr && last_leaf == nullptr;
+        }
+
+        std::size_t leaf_depth = 0;
+        if (!check(head, 1, leaf_depth, nullptr, nullptr))
+        {
+            return false;
+        }
+
+        // the leaf chain has to visit every key in order in both directions
+        std::size_t count = 0;
+        const leaf_type* previous = nullptr;
+        for (const leaf_type* leaf = first_leaf; leaf != nullptr; leaf = leaf->next)
+        {
+            if (leaf->prev != previous)
+            {
+                return false;
+            }
+            if (previous != nullptr && !key_cmp(previous->keys[previous->count - 1], leaf->keys[0]))
+            {
+                return false;
+            }
+            count += leaf->count;
+            previous = leaf;
+        }
+
+        return previous == last_leaf && count == m_size;
+    }
+
+    ////////////////////////
+    //   NODE INTERNALS   //
+    ////////////////////////
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    std::size_t btree<Key, Compare, NodeBytes>::lower_index(const key_type* keys, std::size_t count,
+                                                            const key_type& value) const
+    {
+        if constexpr (leaf_capacity * sizeof(key_type) <= linear_search_bytes)
+        {
+            // branchless scan: count the keys less than the value
+            std::size_t index = 0;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                index += static_cast<std::size_t>(key_cmp(keys[i], value));
+            }
+            return index;
+        }
+        else
+        {
+            return static_cast<std::size_t>(std::lower_bound(keys, keys + count, value, key_cmp) - keys);
+        }
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    std::size_t btree<Key, Compare, NodeBytes>::upper_index(const key_type* keys, std::size_t count,
+                                                            const key_type& value) const
+    {
+        if constexpr (inner_capacity * sizeof(key_type) <= linear_search_bytes)
+        {
+            // branchless scan: count the keys not greater than the value
+            std::size_t index = 0;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                index += static_cast<std::size_t>(!key_cmp(value, keys[i]));
+            }
+            return index;
+        }
+        else
+        {
+            return static_cast<std::size_t>(std::upper_bound(keys, keys + count, value, key_cmp) - keys);
+        }
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::leaf_ptr
+    btree<Key, Compare, NodeBytes>::find_leaf(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (!current->is_leaf)
+        {
+            inner_ptr inner = as_inner(current);
+            current = inner->children[upper_index(inner->keys, inner->count, value)];
+        }
+        return as_leaf(current);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::leaf_ptr
+    btree<Key, Compare, NodeBytes>::descend(const key_type& value)
+    {
+        path_cache.clear();
+
+        node_ptr current = head;
+        while (!current->is_leaf)
+        {
+            inner_ptr inner = as_inner(current);
+            const std::size_t index = upper_index(inner->keys, inner->count, value);
+            path_cache.emplace_back(inner, index);
+            current = inner->children[index];
+        }
+        return as_leaf(current);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::insert_into_parent(key_type separator, node_ptr right)
+    {
+        while (!path_cache.empty())
+        {
+            auto [parent, index] = path_cache.back();
+            path_cache.pop_back();
+
+            if (parent->count < inner_capacity)
+            {
+                std::move_backward(parent->keys + index, parent->keys + parent->count,
+                                   parent->keys + parent->count + 1);
+                std::move_backward(parent->children + index + 1, parent->children + parent->count + 1,
+                                   parent->children + parent->count + 2);
+                parent->keys[index] = std::move(separator);
+                parent->children[index + 1] = right;
+                parent->count++;
+                return;
+            }
+
+            // the parent is full as well: lay out its keys and children with the new pair,
+            // keep the lower half, promote the middle key and move the rest to a new sibling
+            key_type keys[inner_capacity + 1];
+            node_ptr children[inner_capacity + 2];
+
+            std::move(parent->keys, parent->keys + index, keys);
+            keys[index] = std::move(separator);
+            std::move(parent->keys + index, parent->keys + inner_capacity, keys + index + 1);
+
+            std::copy(parent->children, parent->children + index + 1, children);
+            children[index + 1] = right;
+            std::copy(parent->children + index + 1, parent->children + inner_capacity + 1, children + index + 2);
+
+            const std::size_t left_count = (inner_capacity + 1) / 2;
+            const std::size_t right_count = inner_capacity - left_count;
+
+            auto sibling = new inner_type();
+            std::move(keys, keys + left_count, parent->keys);
+            std::copy(children, children + left_count + 1, parent->children);
+            std::fill(parent->children + left_count + 1, parent->children + inner_capacity + 1, nullptr);
+            parent->count = static_cast<std::uint16_t>(left_count);
+
+            std::move(keys + left_count + 1, keys + inner_capacity + 1, sibling->keys);
+            std::copy(children + left_count + 1, children + inner_capacity + 2, sibling->children);
+            sibling->count = static_cast<std::uint16_t>(right_count);
+
+            separator = std::move(keys[left_count]);
+            right = sibling;
+        }
+
+        // the root was split: grow the tree by one level
+        auto root = new inner_type();
+        root->keys[0] = std::move(separator);
+        root->children[0] = head;
+        root->children[1] = right;
+        root->count = 1;
+        head = root;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::rebalance_leaf(leaf_ptr leaf)
+    {
+        auto [parent, index] = path_cache.back();
+        path_cache.pop_back();
+
+        leaf_ptr left = index > 0 ? as_leaf(parent->children[index - 1]) : nullptr;
+        leaf_ptr right = index < parent->count ? as_leaf(parent->children[index + 1]) : nullptr;
+
+        if (left != nullptr && left->count > leaf_min)
+        {
+            // borrow the biggest key of the left sibling
+            std::move_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            leaf->keys[0] = std::move(left->keys[left->count - 1]);
+            leaf->count++;
+            left->count--;
+            parent->keys[index - 1] = leaf->keys[0];
+            return;
+        }
+
+        if (right != nullptr && right->count > leaf_min)
+        {
+            // borrow the smallest key of the right sibling
+            leaf->keys[leaf->count] = std::move(right->keys[0]);
+            leaf->count++;
+            std::move(right->keys + 1, right->keys + right->count, right->keys);
+            right->count--;
+            parent->keys[index] = right->keys[0];
+            return;
+        }
+
+        // both siblings are minimal: merge with one of them
+        leaf_ptr into = left != nullptr ? left : leaf;
+        leaf_ptr from = left != nullptr ? leaf : right;
+        const std::size_t key_index = left != nullptr ? index - 1 : index;
+
+        std::move(from->keys, from->keys + from->count, into->keys + into->count);
+        into->count = static_cast<std::uint16_t>(into->count + from->count);
+
+        into->next = from->next;
+        if (from->next != nullptr)
+        {
+            from->next->prev = into;
+        }
+        else
+        {
+            last_leaf = into;
+        }
+        delete from;
+
+        remove_from_inner(parent, key_index);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::rebalance_inner(inner_ptr node)
+    {
+        auto [parent, index] = path_cache.back();
+        path_cache.pop_back();
+
+        inner_ptr left = index > 0 ? as_inner(parent->children[index - 1]) : nullptr;
+        inner_ptr right = index < parent->count ? as_inner(parent->children[index + 1]) : nullptr;
+
+        if (left != nullptr && left->count > inner_min)
+        {
+            // rotate right through the parent's separator
+            std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+            std::move_backward(node->children, node->children + node->count + 1,
+                               node->children + node->count + 2);
+            node->keys[0] = std::move(parent->keys[index - 1]);
+            node->children[0] = left->children[left->count];
+            node->count++;
+
+            parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+            left->children[left->count] = nullptr;
+            left->count--;
+            return;
+        }
+
+        if (right != nullptr && right->count > inner_min)
+        {
+            // rotate left through the parent's separator
+            node->keys[node->count] = std::move(parent->keys[index]);
+            node->children[node->count + 1] = right->children[0];
+            node->count++;
+
+            parent->keys[index] = std::move(right->keys[0]);
+            std::move(right->keys + 1, right->keys + right->count, right->keys);
+            std::move(right->children + 1, right->children + right->count + 1, right->children);
+            right->children[right->count] = nullptr;
+            right->count--;
+            return;
+        }
+
+        // both siblings are minimal: merge with one of them, pulling the separator down
+        inner_ptr into = left != nullptr ? left : node;
+        inner_ptr from = left != nullptr ? node : right;
+        const std::size_t key_index = left != nullptr ? index - 1 : index;
+
+        into->keys[into->count] = std::move(parent->keys[key_index]);
+        std::move(from->keys, from->keys + from->count, into->keys + into->count + 1);
+        std::copy(from->children, from->children + from->count + 1, into->children + into->count + 1);
+        into->count = static_cast<std::uint16_t>(into->count + 1 + from->count);
+        delete from;
+
+        remove_from_inner(parent, key_index);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::remove_from_inner(inner_ptr node, std::size_t key_index)
+    {
+        // drop keys[key_index] together with the child to its right
+        std::move(node->keys + key_index + 1, node->keys + node->count, node->keys + key_index);
+        std::move(node->children + key_index + 2, node->children + node->count + 1,
+                  node->children + key_index + 1);
+        node->children[node->count] = nullptr;
+        node->count--;
+
+        if (node == head)
+        {
+            if (node->count == 0)
+            {
+                // the root has a single child left: shrink the tree by one level
+                head = node->children[0];
+                delete node;
+            }
+            return;
+        }
+
+        if (node->count < inner_min)
+        {
+            rebalance_inner(node);
+        }
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    void btree<Key, Compare, NodeBytes>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        if (subtree->is_leaf)
+        {
+            delete as_leaf(subtree);
+            return;
+        }
+
+        inner_ptr inner = as_inner(subtree);
+        for (std::size_t i = 0; i <= inner->count; i++)
+        {
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    bool btree<Key, Compare, NodeBytes>::check(node_ptr subtree, std::size_t depth, std::size_t& leaf_depth,
+                                               const key_type* lower, const key_type* upper) const noexcept
+    {
+        // every key k of the subtree has to satisfy lower <= k < upper
+        auto in_range = [&](const key_type& key)
+        {
+            return (lower == nullptr || !key_cmp(key, *lower)) && (upper == nullptr || key_cmp(key, *upper));
+        };
+
+        const bool is_root = subtree == head;
+
+        if (subtree->is_leaf)
+        {
+            leaf_ptr leaf = as_leaf(subtree);
+            if (leaf->count == 0 || (!is_root && leaf->count < leaf_min))
+            {
+                return false;
+            }
+            if (leaf_depth == 0)
+            {
+                leaf_depth = depth;
+            }
+            if (leaf_depth != depth)
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < leaf->count; i++)
+            {
+                if (!in_range(leaf->keys[i]) || (i > 0 && !key_cmp(leaf->keys[i - 1], leaf->keys[i])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inner_ptr inner = as_inner(subtree);
+        if (inner->count == 0 || (!is_root && inner->count < inner_min))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < inner->count; i++)
+        {
+            if (!in_range(inner->keys[i]) || (i > 0 && !key_cmp(inner->keys[i - 1], inner->keys[i])))
+            {
+                return false;
+            }
+        }
+        for (std::size_t i = 0; i <= inner->count; i++)
+        {
+            const key_type* child_lower = i == 0 ? lower : &inner->keys[i - 1];
+            const key_type* child_upper = i == inner->count ? upper : &inner->keys[i];
+            if (inner->children[i] == nullptr ||
+                !check(inner->children[i], depth + 1, leaf_depth, child_lower, child_upper))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::leaf_ptr btree<Key, Compare, NodeBytes>::as_leaf(node_ptr node) noexcept
+    {
+        return static_cast<leaf_ptr>(node);
+    }
+
+    template <typename Key, typename Compare, std::size_t NodeBytes>
+    typename btree<Key, Compare, NodeBytes>::inner_ptr btree<Key, Compare, NodeBytes>::as_inner(node_ptr node) noexcept
+    {
+        return static_cast<inner_ptr>(node);
+    }
+
+} // namespace tree
@@ -39,6 +39,9 @@ namespace tree
     {
         std::swap(this->head, other.head);
         std::swap(this->m_size, other.m_size);
+        std::swap(this->pool, other.pool);
+        std::swap(this->frequency_biased, other.frequency_biased);
+        std::swap(this->finds_since_decay, other.finds_since_decay);
     }
 
     template <typename Key, typename Compare>
@@ -73,6 +76,62 @@ namespace tree
         return *this;
     }
 
+    template <typename Key, typename Compare>
+    template <typename InputIt, typename ExecutionPolicy>
+    cartesian<Key, Compare> cartesian<Key, Compare>::from_unsorted(InputIt first, InputIt last,
+                                                                   const ExecutionPolicy& policy)
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        thread_pool* executor = detail::executor_of(policy);
+
+        self_type result;
+        auto keys = detail::sorted_unique<key_type>(first, last, result.key_cmp, executor);
+
+        // every block draws its priorities from a generator of its own, seeded by the tree's
+        const std::size_t blocks_count = (keys.size() + detail::parallel_grain - 1) / detail::parallel_grain;
+        std::vector<unsigned> seeds(blocks_count);
+        for (auto& seed : seeds)
+        {
+            seed = static_cast<unsigned>(result.gen());
+        }
+
+        std::vector<priority_type> priorities(keys.size());
+        detail::parallel_blocks(executor, 0, blocks_count, 1, [&](std::size_t first_block, std::size_t last_block)
+        {
+            for (std::size_t block = first_block; block < last_block; block++)
+            {
+                std::mt19937 gen(seeds[block]);
+                std::uniform_int_distribution<priority_type> priority_dist(result.priority_min, result.priority_max);
+
+                const std::size_t end = std::min(keys.size(), (block + 1) * detail::parallel_grain);
+                for (std::size_t index = block * detail::parallel_grain; index < end; index++)
+                {
+                    priorities[index] = priority_dist(gen);
+                }
+            }
+        });
+
+        result.head = result.build_sorted(keys, priorities, 0, keys.size(), executor);
+        result.m_size = keys.size();
+        return result;
+    }
+
+    template <typename Key, typename Compare>
+    template <typename ExecutionPolicy>
+    cartesian<Key, Compare> cartesian<Key, Compare>::clone(const ExecutionPolicy& policy) const
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        cartesian<key_type, key_compare> result;
+        result.head = detail::parallel_clone<node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy));
+        result.m_size = m_size;
+        result.key_cmp = key_cmp;
+        result.frequency_biased = frequency_biased;
+        result.finds_since_decay = finds_since_decay;
+        return result;
+    }
+
     ///////////////////
     //   ITERATORS   //
     ///////////////////
@@ -113,6 +172,31 @@ namespace tree
         return const_iterator(std::make_optional<node_ptr>(nullptr));
     }
 
+    ///////////////////
+    //   TRAVERSAL   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    template <typename Function, typename ExecutionPolicy>
+    void cartesian<Key, Compare>::for_each(Function function, const ExecutionPolicy& policy) const
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        detail::parallel_visit<node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy),
+                                          [&](const node_type* node) { function(node->value); });
+    }
+
+    template <typename Key, typename Compare>
+    template <typename T, typename Accumulate, typename Combine, typename ExecutionPolicy>
+    T cartesian<Key, Compare>::reduce(T identity, Accumulate accumulate, Combine combine,
+                                      const ExecutionPolicy& policy) const
+    {
+        static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+        return detail::parallel_reduce<T, node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy),
+                                                     identity, accumulate, combine);
+    }
+
     //////////////////
     //   CAPACITY   //
     //////////////////
@@ -148,15 +232,21 @@ namespace tree
 #if CARTESIAN_TREE_DEBUG_INSERT == 1
         std::cerr << "insert" << std::endl;
 #endif
-        auto it = find(key);
-        if (it != end())
+        const auto priority = frequency_biased ? biased_priority(0, get_random_priority())
+                                               : get_random_priority();
+        return insert(std::move(key), priority);
+    }
+
+    template <typename Key, typename Compare>
+    typename cartesian<Key, Compare>::node_ptr cartesian<Key, Compare>::insert(key_type key, priority_type priority)
+    {
+        if (find_node(key) != nullptr)
         {
             return nullptr;
         }
 
-        // step 1: create a new node with the given key and a random priority
-        const auto priority = get_random_priority();
-        auto child = new node_type(key, priority);
+        // step 1: create a new node with the given key and priority
+        auto child = create_node(key, priority);
 
         // step 2: split the initial tree by the key and merge in the new node
         auto [lhs, rhs] = this->split(key, head);
@@ -171,8 +261,7 @@ namespace tree
     template <typename Key, typename Compare>
     void cartesian<Key, Compare>::erase(const key_type& key)
     {
-        auto it = find(key);
-        if (it == end())
+        if (find_node(key) == nullptr)
         {
             return;
         }
@@ -203,13 +292,28 @@ namespace tree
             lhs = to_delete->left;
         }
 
-        delete to_delete;
+        destroy_node(to_delete);
         m_size--;
 
         // step 3: merge back
         this->head = merge(lhs, rhs);
     }
 
+    template <typename Key, typename Compare>
+    std::vector<bool> cartesian<Key, Compare>::apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                                           const sequenced_policy&)
+    {
+        return apply_batch(batch, nullptr);
+    }
+
+    template <typename Key, typename Compare>
+    std::vector<bool> cartesian<Key, Compare>::apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                                           const parallel_policy& policy)
+    {
+        // nodes of a pool are taken and given back from one thread
+        return apply_batch(batch, pool == nullptr ? detail::executor_of(policy) : nullptr);
+    }
+
     template <typename Key, typename Compare>
     [[nodiscard]] std::pair<typename cartesian<Key, Compare>::node_ptr,
                             typename cartesian<Key, Compare>::node_ptr>
@@ -296,9 +400,16 @@ namespace tree
     template <typename Key, typename Compare>
     typename cartesian<Key, Compare>::iterator cartesian<Key, Compare>::find(const key_type& value)
     {
+        if (!frequency_biased)
+        {
+            return iterator(head, find_node(value));
+        }
+
+        path_cache.clear();
         node_ptr current = head;
         while (current != nullptr)
         {
+            path_cache.push_back(current);
             if (key_cmp(value, current->value))
             {
                 current = current->left;
@@ -313,12 +424,139 @@ namespace tree
             }
         }
 
+        if (current != nullptr)
+        {
+            count_access();
+        }
+
+        if (++finds_since_decay >= decay_factor * m_size)
+        {
+            decay();
+        }
+
         return iterator(head, current);
     }
 
     template <typename Key, typename Compare>
     typename cartesian<Key, Compare>::const_iterator cartesian<Key, Compare>::find(const key_type& value) const
+    {
+        return const_iterator(head, find_node(value));
+    }
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare> cartesian<Key, Compare>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    //////////////////////////
+    //   PRIORITY QUERIES   //
+    //////////////////////////
+
+    template <typename Key, typename Compare>
+    std::optional<typename cartesian<Key, Compare>::priority_type>
+    cartesian<Key, Compare>::priority_of(const key_type& value) const
+    {
+        const node_ptr node = find_node(value);
+        if (node == nullptr)
+        {
+            return std::nullopt;
+        }
+        return node->priority;
+    }
+
+    template <typename Key, typename Compare>
+    std::optional<std::pair<Key, typename cartesian<Key, Compare>::priority_type>>
+    cartesian<Key, Compare>::max_priority(const key_type& lower, const key_type& upper) const
     {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(current->value, lower))
+            {
+                current = current->right;
+            }
+            else if (key_cmp(upper, current->value))
+            {
+                current = current->left;
+            }
+            else
+            {
+                return std::make_pair(current->value, current->priority);
+            }
+        }
+        return std::nullopt;
+    }
+
+    template <typename Key, typename Compare>
+    std::vector<Key> cartesian<Key, Compare>::priority_at_least(const key_type& lower,
+                                                                const key_type& upper,
+                                                                priority_type threshold) const
+    {
+        std::vector<key_type> keys;
+
+        // in-order walk that skips subtrees under the threshold and nodes below the range,
+        // and stops at the first key above it
+        std::vector<node_ptr> stack;
+        node_ptr node = head;
+        while (true)
+        {
+            while (node != nullptr && node->priority >= threshold)
+            {
+                if (key_cmp(node->value, lower))
+                {
+                    node = node->right;
+                }
+                else
+                {
+                    stack.push_back(node);
+                    node = node->left;
+                }
+            }
+
+            if (stack.empty())
+            {
+                break;
+            }
+            node = stack.back();
+            stack.pop_back();
+
+            if (key_cmp(upper, node->value))
+            {
+                break;
+            }
+            keys.push_back(node->value);
+            node = node->right;
+        }
+
+        return keys;
+    }
+
+    template <typename Key, typename Compare>
+    void cartesian<Key, Compare>::set_frequency_biased(bool enabled)
+    {
+        const auto nodes = in_order();
+        for (const auto& node : nodes)
+        {
+            node->accesses = 0;
+            node->priority = enabled ? biased_priority(0, node->priority) : get_random_priority();
+        }
+        rebuild(nodes);
+
+        frequency_biased = enabled;
+        finds_since_decay = 0;
+    }
+
+    template <typename Key, typename Compare>
+    bool cartesian<Key, Compare>::is_frequency_biased() const noexcept
+    {
+        return frequency_biased;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t cartesian<Key, Compare>::depth(const key_type& value) const
+    {
+        std::size_t depth = 1;
         node_ptr current = head;
         while (current != nullptr)
         {
@@ -332,11 +570,11 @@ namespace tree
             }
             else
             {
-                break;
+                return depth;
             }
+            depth++;
         }
-
-        return const_iterator(head, current);
+        return 0;
     }
 
     template <typename Key, typename Compare>
@@ -357,7 +595,7 @@ namespace tree
         node_ptr subtree_rhs = subtree->right;
         bool is_rhs_ordered =
                 subtree_rhs == nullptr ||
-                key_cmp(key, subtree_rhs->value) && is_ordered(subtree_lhs);
+                key_cmp(key, subtree_rhs->value) && is_ordered(subtree_rhs);
 
         return is_lhs_ordered && is_rhs_ordered;
     }
@@ -370,17 +608,18 @@ namespace tree
             return true;
         }
 
-        key_type priority = subtree->priority;
+        // equal priorities are allowed, merge keeps the left one on top
+        priority_type priority = subtree->priority;
 
         node_ptr subtree_lhs = subtree->left;
         bool is_lhs_heap =
                 subtree_lhs == nullptr ||
-                key_cmp(subtree_lhs->priority, priority) && is_heap(subtree_lhs);
+                subtree_lhs->priority <= priority && is_heap(subtree_lhs);
 
         node_ptr subtree_rhs = subtree->right;
         bool is_rhs_heap =
                 subtree_rhs == nullptr ||
-                key_cmp(subtree_rhs->priority, priority) && is_heap(subtree_lhs);
+                subtree_rhs->priority <= priority && is_heap(subtree_rhs);
 
         return is_lhs_heap && is_rhs_heap;
     }
@@ -402,4 +641,299 @@ namespace tree
         return priority_dist(gen);
     }
 
+    template <typename Key, typename Compare>
+    typename cartesian<Key, Compare>::node_ptr cartesian<Key, Compare>::find_node(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return current;
+    }
+
+    //////////////////////////
+    //   FREQUENCY BIASED   //
+    //////////////////////////
+
+    template <typename Key, typename Compare>
+    void cartesian<Key, Compare>::count_access()
+    {
+        node_ptr node = path_cache.back();
+        path_cache.pop_back();
+
+        if (node->accesses == std::numeric_limits<std::uint32_t>::max())
+        {
+            return;
+        }
+
+        // the class only changes at powers of two
+        node->accesses++;
+        if ((node->accesses & (node->accesses - 1)) != 0)
+        {
+            return;
+        }
+        node->priority = biased_priority(node->accesses, node->priority);
+
+        while (!path_cache.empty() && path_cache.back()->priority < node->priority)
+        {
+            node_ptr parent = path_cache.back();
+            path_cache.pop_back();
+
+            if (parent->left == node)
+            {
+                parent->left = node->right;
+                node->right = parent;
+            }
+            else
+            {
+                parent->right = node->left;
+                node->left = parent;
+            }
+
+            if (path_cache.empty())
+            {
+                head = node;
+            }
+            else if (path_cache.back()->left == parent)
+            {
+                path_cache.back()->left = node;
+            }
+            else
+            {
+                path_cache.back()->right = node;
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    void cartesian<Key, Compare>::decay()
+    {
+        // every nonzero count drops by exactly one class, so the order of
+        // the priorities changes and the heap is rebuilt rather than repaired
+        const auto nodes = in_order();
+        for (const auto& node : nodes)
+        {
+            node->accesses >>= 1u;
+            node->priority = biased_priority(node->accesses, node->priority);
+        }
+        rebuild(nodes);
+
+        finds_since_decay = 0;
+    }
+
+    template <typename Key, typename Compare>
+    int cartesian<Key, Compare>::biased_priority(std::uint32_t accesses, int priority) noexcept
+    {
+        const std::uint32_t random_bits = static_cast<std::uint32_t>(priority) & ((1u << class_shift) - 1);
+        const std::uint32_t level = accesses == 0 ? 0 : 64 - detail::count_leading_zeros(accesses);
+
+        // at most 32 classes above the lowest priority fit into an int
+        const auto biased = static_cast<std::int64_t>(std::numeric_limits<int>::min())
+                            + (static_cast<std::int64_t>(level) << class_shift) + random_bits;
+        return static_cast<int>(biased);
+    }
+
+    template <typename Key, typename Compare>
+    std::vector<typename cartesian<Key, Compare>::node_ptr> cartesian<Key, Compare>::in_order() const
+    {
+        std::vector<node_ptr> nodes;
+        nodes.reserve(m_size);
+
+        std::vector<node_ptr> stack;
+        node_ptr node = head;
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+
+            nodes.push_back(node);
+            node = node->right;
+        }
+
+        return nodes;
+    }
+
+    template <typename Key, typename Compare>
+    void cartesian<Key, Compare>::rebuild(const std::vector<node_ptr>& nodes)
+    {
+        head = link_heap(nodes, path_cache);
+    }
+
+    template <typename Key, typename Compare>
+    typename cartesian<Key, Compare>::node_ptr
+    cartesian<Key, Compare>::link_heap(const std::vector<node_ptr>& nodes, std::vector<node_ptr>& spine)
+    {
+        // the stack holds the right spine of the tree built so far, a new node
+        // takes the part of it with lower priorities as its left subtree
+        spine.clear();
+        for (const auto& node : nodes)
+        {
+            node_ptr lower = nullptr;
+            while (!spine.empty() && spine.back()->priority < node->priority)
+            {
+                lower = spine.back();
+                spine.pop_back();
+            }
+
+            node->left = lower;
+            node->right = nullptr;
+            if (!spine.empty())
+            {
+                spine.back()->right = node;
+            }
+            spine.push_back(node);
+        }
+
+        node_ptr root = spine.empty() ? nullptr : spine.front();
+        spine.clear();
+        return root;
+    }
+
+    template <typename Key, typename Compare>
+    typename cartesian<Key, Compare>::node_ptr
+    cartesian<Key, Compare>::build_sorted(std::vector<key_type>& keys, const std::vector<priority_type>& priorities,
+                                          std::size_t first, std::size_t last, thread_pool* executor)
+    {
+        if (executor == nullptr || last - first <= detail::parallel_grain)
+        {
+            std::vector<node_ptr> nodes;
+            nodes.reserve(last - first);
+            for (std::size_t index = first; index < last; index++)
+            {
+                nodes.push_back(create_node(std::move(keys[index]), priorities[index]));
+            }
+
+            std::vector<node_ptr> spine;
+            return link_heap(nodes, spine);
+        }
+
+        // every key of lhs is less than every key of rhs, merging only walks the inner spines
+        const std::size_t middle = first + (last - first) / 2;
+        const auto halves = executor->fork_join(
+                [&]() { return build_sorted(keys, priorities, first, middle, executor); },
+                [&]() { return build_sorted(keys, priorities, middle, last, executor); });
+        return merge(halves.first, halves.second);
+    }
+
+    //////////////////
+    //   BATCHING   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    std::vector<bool> cartesian<Key, Compare>::apply_batch(const std::vector<batch_operation<key_type>>& batch,
+                                                           thread_pool* executor)
+    {
+        detail::batch_plan<key_type> plan(batch, key_cmp);
+
+        // the generator is not shared between threads
+        std::vector<priority_type> priorities(plan.groups_count());
+        for (auto& priority : priorities)
+        {
+            priority = frequency_biased ? biased_priority(0, get_random_priority()) : get_random_priority();
+        }
+
+        head = apply_groups(head, 0, plan.groups_count(), plan, priorities, executor);
+        m_size = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(m_size) + plan.size_change());
+        return plan.results();
+    }
+
+    template <typename Key, typename Compare>
+    typename cartesian<Key, Compare>::node_ptr
+    cartesian<Key, Compare>::apply_groups(node_ptr subtree, std::size_t first, std::size_t last,
+                                          detail::batch_plan<key_type>& plan,
+                                          const std::vector<priority_type>& priorities, thread_pool* executor)
+    {
+        if (first == last)
+        {
+            return subtree;
+        }
+
+        const std::size_t middle = first + (last - first) / 2;
+        const key_type& key = plan.key(middle);
+        const auto halves = split(key, subtree);
+        node_ptr lhs = halves.first;
+        node_ptr rhs = halves.second;
+
+        // the key, if it is there, is the greatest one of lhs
+        node_ptr parent = nullptr;
+        node_ptr found = lhs;
+        while (found != nullptr && found->right != nullptr)
+        {
+            parent = found;
+            found = found->right;
+        }
+        if (found != nullptr && key_cmp(found->value, key))
+        {
+            found = nullptr;
+        }
+        else if (found != nullptr)
+        {
+            if (parent != nullptr)
+            {
+                parent->right = found->left;
+            }
+            else
+            {
+                lhs = found->left;
+            }
+            found->left = nullptr;
+        }
+
+        // the two halves share no node and no group
+        const auto [lhs_result, rhs_result] = detail::fork_join(
+                last - first >= batch_parallel_cutoff ? executor : nullptr,
+                [&]() { return apply_groups(lhs, first, middle, plan, priorities, executor); },
+                [&]() { return apply_groups(rhs, middle + 1, last, plan, priorities, executor); });
+
+        if (plan.resolve(middle, found != nullptr))
+        {
+            node_ptr node = found != nullptr ? found : create_node(key, priorities[middle]);
+            return merge(merge(lhs_result, node), rhs_result);
+        }
+
+        if (found != nullptr)
+        {
+            destroy_node(found);
+        }
+        return merge(lhs_result, rhs_result);
+    }
+
+    template <typename Key, typename Compare>
+    typename cartesian<Key, Compare>::node_ptr cartesian<Key, Compare>::create_node(key_type key, priority_type priority)
+    {
+        if (pool != nullptr)
+        {
+            return pool->create(std::move(key), priority);
+        }
+        return new node_type(std::move(key), priority);
+    }
+
+    template <typename Key, typename Compare>
+    void cartesian<Key, Compare>::destroy_node(node_ptr node) noexcept
+    {
+        if (pool != nullptr)
+        {
+            pool->release(node);
+            return;
+        }
+        delete node;
+    }
+
 } // namespace tree
\ No newline at end of file
@@ -0,0 +1,204 @@
+#pragma once
+
+namespace tree
+{
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Tree, std::size_t Slots>
+    combining<Tree, Slots>::combining(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            tree.insert(element);
+        }
+    }
+
+    template <typename Tree, std::size_t Slots>
+    combining<Tree, Slots>::combining(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            tree.insert(std::move(element));
+        }
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Tree, std::size_t Slots>
+    bool combining<Tree, Slots>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template <typename Tree, std::size_t Slots>
+    std::size_t combining<Tree, Slots>::size() const
+    {
+        std::lock_guard lock(mutex);
+        return tree.size();
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Tree, std::size_t Slots>
+    void combining<Tree, Slots>::clear()
+    {
+        std::lock_guard lock(mutex);
+        tree.clear();
+    }
+
+    template <typename Tree, std::size_t Slots>
+    bool combining<Tree, Slots>::insert(key_type key)
+    {
+        return apply(operation::insert, key);
+    }
+
+    template <typename Tree, std::size_t Slots>
+    bool combining<Tree, Slots>::erase(const key_type& key)
+    {
+        return apply(operation::erase, key);
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Tree, std::size_t Slots>
+    bool combining<Tree, Slots>::contains(const key_type& value) const
+    {
+        return apply(operation::contains, value);
+    }
+
+    template <typename Tree, std::size_t Slots>
+    std::vector<typename Tree::key_type> combining<Tree, Slots>::keys() const
+    {
+        std::lock_guard lock(mutex);
+        return std::vector<key_type>(tree.begin(), tree.end());
+    }
+
+    template <typename Tree, std::size_t Slots>
+    std::size_t combining<Tree, Slots>::combined_operations() const noexcept
+    {
+        return operations_count.load(std::memory_order_relaxed);
+    }
+
+    template <typename Tree, std::size_t Slots>
+    std::size_t combining<Tree, Slots>::combined_batches() const noexcept
+    {
+        return batches_count.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////
+    //   COMBINING   //
+    ///////////////////
+
+    template <typename Tree, std::size_t Slots>
+    bool combining<Tree, Slots>::apply(operation type, const key_type& key) const
+    {
+        record* slot = take_record();
+        if (slot == nullptr)
+        {
+            // more threads than records: this one goes without combining
+            std::lock_guard lock(mutex);
+            return apply_locked(type, key);
+        }
+
+        // the key stays alive on the caller's stack until the record is done
+        slot->type = type;
+        slot->key = &key;
+        slot->state.store(status::pending, std::memory_order_release);
+
+        for (unsigned spin = 0; slot->state.load(std::memory_order_acquire) != status::done; spin++)
+        {
+            if (mutex.try_lock())
+            {
+                // the own record is still pending or already done, either way it is done after this
+                combine();
+                mutex.unlock();
+                break;
+            }
+
+            // a combiner may be waiting for the core this thread spins on
+            if (spin >= 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        const bool result = slot->result;
+        slot->state.store(status::free, std::memory_order_release);
+        return result;
+    }
+
+    template <typename Tree, std::size_t Slots>
+    void combining<Tree, Slots>::combine() const
+    {
+        batch.clear();
+        for (auto& current : records)
+        {
+            if (current.state.load(std::memory_order_acquire) == status::pending)
+            {
+                batch.push_back(&current);
+            }
+        }
+
+        // operations in flight together may take effect in any order, key order is
+        // the one that walks the tree with the best locality
+        std::sort(batch.begin(), batch.end(), [this](const record* lhs, const record* rhs)
+        {
+            return key_cmp(*lhs->key, *rhs->key);
+        });
+
+        for (record* current : batch)
+        {
+            current->result = apply_locked(current->type, *current->key);
+            current->state.store(status::done, std::memory_order_release);
+        }
+
+        operations_count.fetch_add(batch.size(), std::memory_order_relaxed);
+        batches_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename Tree, std::size_t Slots>
+    bool combining<Tree, Slots>::apply_locked(operation type, const key_type& key) const
+    {
+        const std::size_t size_before = tree.size();
+        switch (type)
+        {
+            case operation::insert:
+                tree.insert(key);
+                return tree.size() != size_before;
+            case operation::erase:
+                tree.erase(key);
+                return tree.size() != size_before;
+            default:
+                return tree.find(key) != tree.end();
+        }
+    }
+
+    template <typename Tree, std::size_t Slots>
+    typename combining<Tree, Slots>::record* combining<Tree, Slots>::take_record() const
+    {
+        // a thread keeps finding the same record as long as it is not crowded out
+        static thread_local const std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        for (std::size_t offset = 0; offset < Slots; offset++)
+        {
+            record& current = records[(start + offset) % Slots];
+
+            status expected = status::free;
+            if (current.state.load(std::memory_order_relaxed) == status::free &&
+                current.state.compare_exchange_strong(expected, status::taken, std::memory_order_acquire))
+            {
+                return &current;
+            }
+        }
+        return nullptr;
+    }
+
+} // namespace tree
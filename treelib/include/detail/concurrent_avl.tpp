@@ -0,0 +1,999 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::const_iterator::const_iterator(const self_type* owner, std::optional<key_type> current)
+        : owner{owner}, current{std::move(current)}
+    { }
+
+    template <typename Key, typename Compare>
+    const Key& concurrent_avl<Key, Compare>::const_iterator::operator * () const
+    {
+        return *current;
+    }
+
+    template <typename Key, typename Compare>
+    const Key* concurrent_avl<Key, Compare>::const_iterator::operator -> () const
+    {
+        return &*current;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator&
+    concurrent_avl<Key, Compare>::const_iterator::operator ++ ()
+    {
+        current = owner->next_key(&*current);
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator
+    concurrent_avl<Key, Compare>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::const_iterator::operator == (const const_iterator& other) const
+    {
+        if (!current.has_value() || !other.current.has_value())
+        {
+            return current.has_value() == other.current.has_value();
+        }
+        return owner->is_equal(*current, *other.current);
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::concurrent_avl()
+        : holder{new node_type(key_type(), nullptr, false)}
+    {
+        holder->height.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::concurrent_avl(const std::initializer_list<key_type>& data)
+        : concurrent_avl()
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::concurrent_avl(std::initializer_list<key_type>&& data)
+        : concurrent_avl()
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::concurrent_avl(const self_type& other)
+        : concurrent_avl()
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::concurrent_avl(self_type&& other) noexcept
+        : concurrent_avl()
+    {
+        std::swap(holder, other.holder);
+        m_size.store(other.m_size.exchange(0));
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>::~concurrent_avl()
+    {
+        // nodes unlinked earlier are freed with the epoch domain
+        destroy(holder->right.load(std::memory_order_acquire));
+        delete holder;
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>& concurrent_avl<Key, Compare>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_avl<Key, Compare>& concurrent_avl<Key, Compare>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(holder, other.holder);
+
+            std::size_t other_size = other.m_size.exchange(m_size.load());
+            m_size.store(other_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator concurrent_avl<Key, Compare>::begin() const
+    {
+        return const_iterator(this, next_key(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator concurrent_avl<Key, Compare>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator concurrent_avl<Key, Compare>::end() const
+    {
+        return const_iterator();
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator concurrent_avl<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t concurrent_avl<Key, Compare>::size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::clear()
+    {
+        destroy(holder->right.exchange(nullptr));
+        m_size.store(0);
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::insert(key_type key)
+    {
+        auto guard = epochs.pin();
+
+        // the holder is never rotated, so its version stays zero
+        update_result result = update_result::retry;
+        while (result == update_result::retry)
+        {
+            result = attempt_insert(key, holder, true, 0);
+        }
+
+        if (result == update_result::changed)
+        {
+            m_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result == update_result::changed;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::erase(const key_type& key)
+    {
+        auto guard = epochs.pin();
+
+        update_result result = update_result::retry;
+        while (result == update_result::retry)
+        {
+            result = attempt_erase(key, holder, true, 0);
+        }
+
+        if (result == update_result::changed)
+        {
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return result == update_result::changed;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::const_iterator concurrent_avl<Key, Compare>::find(const key_type& value) const
+    {
+        return contains(value) ? const_iterator(this, value) : end();
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::contains(const key_type& value) const
+    {
+        auto guard = epochs.pin();
+
+        search_result result = search_result::retry;
+        while (result == search_result::retry)
+        {
+            result = attempt_find(value, holder, true, 0);
+        }
+        return result == search_result::found;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::is_avl() const
+    {
+        if (holder->left.load() != nullptr)
+        {
+            return false;
+        }
+
+        std::size_t present = 0;
+        return check(holder->right.load(), nullptr, nullptr, present) >= 0 && present == size();
+    }
+
+    ///////////////////
+    //   SEARCHING   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::search_result
+    concurrent_avl<Key, Compare>::attempt_find(const key_type& key, node_ptr node, bool is_right,
+                                               std::uint64_t node_version) const
+    {
+        while (true)
+        {
+            node_ptr next = child(node, is_right);
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return search_result::retry;
+            }
+            if (next == nullptr)
+            {
+                return search_result::not_found;
+            }
+            if (is_equal(key, next->value))
+            {
+                return next->is_present.load(std::memory_order_acquire) ? search_result::found
+                                                                         : search_result::not_found;
+            }
+
+            const std::uint64_t next_version = next->version.load(std::memory_order_acquire);
+            if ((next_version & (shrinking | unlinked)) != 0)
+            {
+                // the link to it changes as well, the next pass sees the new one
+                wait_until_not_shrinking(next);
+                continue;
+            }
+
+            // the child was still the one that holds the key when its version was read
+            if (next != child(node, is_right))
+            {
+                continue;
+            }
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return search_result::retry;
+            }
+
+            const search_result result = attempt_find(key, next, key_cmp(next->value, key), next_version);
+            if (result != search_result::retry)
+            {
+                return result;
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::search_result
+    concurrent_avl<Key, Compare>::attempt_next(const key_type* after, node_ptr node, bool is_right,
+                                               std::uint64_t node_version, std::optional<key_type>& next) const
+    {
+        while (true)
+        {
+            node_ptr current = child(node, is_right);
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return search_result::retry;
+            }
+            if (current == nullptr)
+            {
+                return search_result::not_found;
+            }
+
+            const std::uint64_t current_version = current->version.load(std::memory_order_acquire);
+            if ((current_version & (shrinking | unlinked)) != 0)
+            {
+                wait_until_not_shrinking(current);
+                continue;
+            }
+            if (current != child(node, is_right))
+            {
+                continue;
+            }
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return search_result::retry;
+            }
+
+            search_result result = search_result::not_found;
+            if (after == nullptr || key_cmp(*after, current->value))
+            {
+                // the left subtree first, then the node itself, then the right subtree
+                result = attempt_next(after, current, false, current_version, next);
+                if (result == search_result::not_found && current->is_present.load(std::memory_order_acquire))
+                {
+                    if (current->version.load(std::memory_order_acquire) != current_version)
+                    {
+                        continue;
+                    }
+                    next.emplace(current->value);
+                    return search_result::found;
+                }
+            }
+            if (result == search_result::not_found)
+            {
+                result = attempt_next(after, current, true, current_version, next);
+            }
+            if (result != search_result::retry)
+            {
+                return result;
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    std::optional<Key> concurrent_avl<Key, Compare>::next_key(const key_type* after) const
+    {
+        auto guard = epochs.pin();
+
+        std::optional<key_type> next;
+        while (attempt_next(after, holder, true, 0, next) == search_result::retry)
+        { }
+        return next;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::wait_until_not_shrinking(const node_type* node) noexcept
+    {
+        // a rotation holds the locks for a few stores, so spin before giving up the core
+        for (int spin = 0; (node->version.load(std::memory_order_acquire) & shrinking) != 0; spin++)
+        {
+            if (spin >= 100)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    ///////////////////
+    //   MODIFYING   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::update_result
+    concurrent_avl<Key, Compare>::attempt_insert(key_type& key, node_ptr node, bool is_right, std::uint64_t node_version)
+    {
+        while (true)
+        {
+            node_ptr next = child(node, is_right);
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return update_result::retry;
+            }
+
+            if (next == nullptr)
+            {
+                bool is_inserted = false;
+                {
+                    std::lock_guard lock(node->mutex);
+                    if (node->version.load(std::memory_order_acquire) != node_version)
+                    {
+                        return update_result::retry;
+                    }
+                    if (child(node, is_right) == nullptr)
+                    {
+                        set_child(node, is_right, new node_type(std::move(key), node, true));
+                        is_inserted = true;
+                    }
+                }
+
+                if (is_inserted)
+                {
+                    fix_height_and_rebalance(node);
+                    return update_result::changed;
+                }
+                continue;
+            }
+
+            if (is_equal(key, next->value))
+            {
+                // a routing node takes the key back
+                std::lock_guard lock(next->mutex);
+                if ((next->version.load(std::memory_order_acquire) & unlinked) != 0)
+                {
+                    continue;
+                }
+                if (next->is_present.load(std::memory_order_acquire))
+                {
+                    return update_result::unchanged;
+                }
+                next->is_present.store(true, std::memory_order_release);
+                return update_result::changed;
+            }
+
+            const std::uint64_t next_version = next->version.load(std::memory_order_acquire);
+            if ((next_version & (shrinking | unlinked)) != 0)
+            {
+                wait_until_not_shrinking(next);
+                continue;
+            }
+            if (next != child(node, is_right))
+            {
+                continue;
+            }
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return update_result::retry;
+            }
+
+            const update_result result = attempt_insert(key, next, key_cmp(next->value, key), next_version);
+            if (result != update_result::retry)
+            {
+                return result;
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::update_result
+    concurrent_avl<Key, Compare>::attempt_erase(const key_type& key, node_ptr node, bool is_right, std::uint64_t node_version)
+    {
+        while (true)
+        {
+            node_ptr next = child(node, is_right);
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return update_result::retry;
+            }
+            if (next == nullptr)
+            {
+                return update_result::unchanged;
+            }
+
+            if (is_equal(key, next->value))
+            {
+                const update_result result = attempt_erase_node(node, next);
+                if (result != update_result::retry)
+                {
+                    return result;
+                }
+                continue;
+            }
+
+            const std::uint64_t next_version = next->version.load(std::memory_order_acquire);
+            if ((next_version & (shrinking | unlinked)) != 0)
+            {
+                wait_until_not_shrinking(next);
+                continue;
+            }
+            if (next != child(node, is_right))
+            {
+                continue;
+            }
+            if (node->version.load(std::memory_order_acquire) != node_version)
+            {
+                return update_result::retry;
+            }
+
+            const update_result result = attempt_erase(key, next, key_cmp(next->value, key), next_version);
+            if (result != update_result::retry)
+            {
+                return result;
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::update_result
+    concurrent_avl<Key, Compare>::attempt_erase_node(node_ptr parent, node_ptr node)
+    {
+        if (!node->is_present.load(std::memory_order_acquire))
+        {
+            return update_result::unchanged;
+        }
+
+        if (child(node, false) != nullptr && child(node, true) != nullptr)
+        {
+            // with two children the node stays as a routing node, only its own lock is needed
+            std::lock_guard lock(node->mutex);
+            if ((node->version.load(std::memory_order_acquire) & unlinked) != 0)
+            {
+                return update_result::retry;
+            }
+            if (child(node, false) != nullptr && child(node, true) != nullptr)
+            {
+                if (!node->is_present.load(std::memory_order_acquire))
+                {
+                    return update_result::unchanged;
+                }
+                node->is_present.store(false, std::memory_order_release);
+                return update_result::changed;
+            }
+        }
+
+        bool is_unlinked = false;
+        {
+            std::lock_guard parent_lock(parent->mutex);
+            if ((parent->version.load(std::memory_order_acquire) & unlinked) != 0 ||
+                node->parent.load(std::memory_order_acquire) != parent)
+            {
+                return update_result::retry;
+            }
+
+            std::lock_guard node_lock(node->mutex);
+            if (!node->is_present.load(std::memory_order_acquire))
+            {
+                return update_result::unchanged;
+            }
+            node->is_present.store(false, std::memory_order_release);
+            is_unlinked = attempt_unlink_locked(parent, node);
+        }
+
+        // a routing node left behind is unlinked by the repair once it can be
+        fix_height_and_rebalance(is_unlinked ? parent : node);
+        return update_result::changed;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::attempt_unlink_locked(node_ptr parent, node_ptr node)
+    {
+        const bool is_right = child(parent, true) == node;
+        if (!is_right && child(parent, false) != node)
+        {
+            return false;
+        }
+
+        node_ptr left = child(node, false);
+        node_ptr right = child(node, true);
+        if (left != nullptr && right != nullptr)
+        {
+            return false;
+        }
+
+        node_ptr splice = left != nullptr ? left : right;
+        set_child(parent, is_right, splice);
+        if (splice != nullptr)
+        {
+            splice->parent.store(parent, std::memory_order_release);
+        }
+
+        node->version.store(node->version.load(std::memory_order_relaxed) | unlinked, std::memory_order_release);
+        retire(node);
+        return true;
+    }
+
+    /////////////////////
+    //   REBALANCING   //
+    /////////////////////
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::fix_height_and_rebalance(node_ptr node)
+    {
+        // a rotation can leave a second node to repair off the way up, it waits here
+        std::vector<node_ptr> pending;
+        while (true)
+        {
+            while (node == nullptr || node == holder)
+            {
+                if (pending.empty())
+                {
+                    return;
+                }
+                node = pending.back();
+                pending.pop_back();
+            }
+
+            const int condition = node_condition(node);
+            if (condition == nothing_required || (node->version.load(std::memory_order_acquire) & unlinked) != 0)
+            {
+                node = nullptr;
+                continue;
+            }
+
+            if (condition != unlink_required && condition != rebalance_required)
+            {
+                std::lock_guard lock(node->mutex);
+                node = fix_height_locked(node);
+            }
+            else
+            {
+                // a rotation or an unlink changes the link from the parent as well
+                node_ptr parent = node->parent.load(std::memory_order_acquire);
+                std::lock_guard parent_lock(parent->mutex);
+                if ((parent->version.load(std::memory_order_acquire) & unlinked) == 0 &&
+                    node->parent.load(std::memory_order_acquire) == parent)
+                {
+                    std::lock_guard node_lock(node->mutex);
+                    node = rebalance_locked(parent, node, pending);
+                }
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    int concurrent_avl<Key, Compare>::node_condition(node_ptr node) noexcept
+    {
+        node_ptr left = child(node, false);
+        node_ptr right = child(node, true);
+        if ((left == nullptr || right == nullptr) && !node->is_present.load(std::memory_order_acquire))
+        {
+            return unlink_required;
+        }
+
+        const int left_height = height(left);
+        const int right_height = height(right);
+        const int fixed_height = 1 + std::max(left_height, right_height);
+        const int balance = left_height - right_height;
+        if (balance < -1 || balance > 1)
+        {
+            return rebalance_required;
+        }
+        return fixed_height != node->height.load(std::memory_order_acquire) ? fixed_height : nothing_required;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::node_ptr concurrent_avl<Key, Compare>::fix_height_locked(node_ptr node) noexcept
+    {
+        const int condition = node_condition(node);
+        switch (condition)
+        {
+            case unlink_required:
+            case rebalance_required:
+                return node;
+            case nothing_required:
+                return nullptr;
+            default:
+                node->height.store(condition, std::memory_order_release);
+                return node->parent.load(std::memory_order_acquire);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::node_ptr concurrent_avl<Key, Compare>::rebalance_locked(node_ptr parent, node_ptr node,
+                                                                                          std::vector<node_ptr>& pending)
+    {
+        node_ptr left = child(node, false);
+        node_ptr right = child(node, true);
+        if ((left == nullptr || right == nullptr) && !node->is_present.load(std::memory_order_acquire))
+        {
+            return attempt_unlink_locked(parent, node) ? fix_height_locked(parent) : node;
+        }
+
+        const int left_height = height(left);
+        const int right_height = height(right);
+        const int fixed_height = 1 + std::max(left_height, right_height);
+        const int balance = left_height - right_height;
+
+        if (balance > 1 || balance < -1)
+        {
+            // a rotation may hand back a node below to repair first, the parent's height
+            // has to be looked at after it
+            pending.push_back(parent);
+            return balance > 1 ? rebalance_toward(parent, node, left, right_height, false, pending)
+                               : rebalance_toward(parent, node, right, left_height, true, pending);
+        }
+        if (fixed_height != node->height.load(std::memory_order_acquire))
+        {
+            node->height.store(fixed_height, std::memory_order_release);
+            return fix_height_locked(parent);
+        }
+        return nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::node_ptr
+    concurrent_avl<Key, Compare>::rebalance_toward(node_ptr parent, node_ptr node, node_ptr heavy,
+                                                   int light_height, bool is_right_heavy,
+                                                   std::vector<node_ptr>& pending)
+    {
+        std::lock_guard heavy_lock(heavy->mutex);
+
+        // the heights were read before the lock
+        if (heavy->height.load(std::memory_order_acquire) - light_height <= 1)
+        {
+            return node;
+        }
+
+        node_ptr inner = child(heavy, !is_right_heavy);
+        const int outer_height = height(child(heavy, is_right_heavy));
+        const int inner_height = height(inner);
+        if (outer_height >= inner_height)
+        {
+            return rotate_single(parent, node, heavy, is_right_heavy, light_height, outer_height, inner, inner_height);
+        }
+
+        {
+            std::lock_guard inner_lock(inner->mutex);
+
+            const int locked_inner_height = inner->height.load(std::memory_order_acquire);
+            if (outer_height >= locked_inner_height)
+            {
+                return rotate_single(parent, node, heavy, is_right_heavy,
+                                     light_height, outer_height, inner, locked_inner_height);
+            }
+
+            // the double rotation is enough unless it leaves the heavy child out of balance
+            const int inner_outer_height = height(child(inner, is_right_heavy));
+            const int balance = outer_height - inner_outer_height;
+            if (balance >= -1 && balance <= 1)
+            {
+                return rotate_double(parent, node, heavy, is_right_heavy,
+                                     light_height, outer_height, inner, inner_outer_height, pending);
+            }
+        }
+
+        // otherwise the heavy child is rotated the other way first, and the node is seen again after
+        pending.push_back(node);
+        return rebalance_toward(node, heavy, inner, outer_height, !is_right_heavy, pending);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::node_ptr
+    concurrent_avl<Key, Compare>::rotate_single(node_ptr parent, node_ptr node, node_ptr heavy, bool is_right_heavy,
+                                                int light_height, int outer_height,
+                                                node_ptr inner, int inner_height) noexcept
+    {
+        const std::uint64_t node_version = node->version.load(std::memory_order_relaxed);
+        const bool is_right_child = child(parent, true) == node;
+
+        // keys leave the node's subtree: readers inside it have to wait and go back;
+        // the heavy child only gains keys, so readers inside it may go on
+        node->version.store(node_version | shrinking, std::memory_order_release);
+
+        set_child(node, is_right_heavy, inner);
+        if (inner != nullptr)
+        {
+            inner->parent.store(node, std::memory_order_release);
+        }
+
+        set_child(heavy, !is_right_heavy, node);
+        node->parent.store(heavy, std::memory_order_release);
+
+        set_child(parent, is_right_child, heavy);
+        heavy->parent.store(parent, std::memory_order_release);
+
+        const int node_height = 1 + std::max(inner_height, light_height);
+        node->height.store(node_height, std::memory_order_release);
+        heavy->height.store(1 + std::max(outer_height, node_height), std::memory_order_release);
+
+        node->version.store(node_version + version_step, std::memory_order_release);
+
+        // the next node that needs a repair
+        const int node_balance = inner_height - light_height;
+        if (node_balance < -1 || node_balance > 1)
+        {
+            return node;
+        }
+        if ((inner == nullptr || light_height == 0) && !node->is_present.load(std::memory_order_acquire))
+        {
+            return node;
+        }
+
+        const int heavy_balance = outer_height - node_height;
+        if (heavy_balance < -1 || heavy_balance > 1)
+        {
+            return heavy;
+        }
+        if (outer_height == 0 && !heavy->is_present.load(std::memory_order_acquire))
+        {
+            return heavy;
+        }
+        return fix_height_locked(parent);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::node_ptr
+    concurrent_avl<Key, Compare>::rotate_double(node_ptr parent, node_ptr node, node_ptr heavy, bool is_right_heavy,
+                                                int light_height, int outer_height,
+                                                node_ptr inner, int inner_outer_height,
+                                                std::vector<node_ptr>& pending)
+    {
+        const std::uint64_t node_version = node->version.load(std::memory_order_relaxed);
+        const std::uint64_t heavy_version = heavy->version.load(std::memory_order_relaxed);
+        const bool is_right_child = child(parent, true) == node;
+
+        node_ptr inner_outer = child(inner, is_right_heavy);
+        node_ptr inner_inner = child(inner, !is_right_heavy);
+        const int inner_inner_height = height(inner_inner);
+
+        // both the node and the heavy child lose keys to the inner grandchild
+        node->version.store(node_version | shrinking, std::memory_order_release);
+        heavy->version.store(heavy_version | shrinking, std::memory_order_release);
+
+        set_child(node, is_right_heavy, inner_inner);
+        if (inner_inner != nullptr)
+        {
+            inner_inner->parent.store(node, std::memory_order_release);
+        }
+
+        set_child(heavy, !is_right_heavy, inner_outer);
+        if (inner_outer != nullptr)
+        {
+            inner_outer->parent.store(heavy, std::memory_order_release);
+        }
+
+        set_child(inner, is_right_heavy, heavy);
+        heavy->parent.store(inner, std::memory_order_release);
+
+        set_child(inner, !is_right_heavy, node);
+        node->parent.store(inner, std::memory_order_release);
+
+        set_child(parent, is_right_child, inner);
+        inner->parent.store(parent, std::memory_order_release);
+
+        const int node_height = 1 + std::max(inner_inner_height, light_height);
+        const int heavy_height = 1 + std::max(outer_height, inner_outer_height);
+        node->height.store(node_height, std::memory_order_release);
+        heavy->height.store(heavy_height, std::memory_order_release);
+        inner->height.store(1 + std::max(node_height, heavy_height), std::memory_order_release);
+
+        node->version.store(node_version + version_step, std::memory_order_release);
+        heavy->version.store(heavy_version + version_step, std::memory_order_release);
+
+        // a routing heavy child may be left with one child, it is below the inner one now
+        if ((outer_height == 0 || inner_outer_height == 0) && !heavy->is_present.load(std::memory_order_acquire))
+        {
+            pending.push_back(heavy);
+        }
+
+        const int node_balance = inner_inner_height - light_height;
+        if (node_balance < -1 || node_balance > 1)
+        {
+            return node;
+        }
+        if ((inner_inner == nullptr || light_height == 0) && !node->is_present.load(std::memory_order_acquire))
+        {
+            return node;
+        }
+
+        const int inner_balance = heavy_height - node_height;
+        if (inner_balance < -1 || inner_balance > 1)
+        {
+            return inner;
+        }
+        return fix_height_locked(parent);
+    }
+
+    /////////////////
+    //   HELPERS   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_avl<Key, Compare>::node_ptr
+    concurrent_avl<Key, Compare>::child(const node_type* node, bool is_right) noexcept
+    {
+        return (is_right ? node->right : node->left).load(std::memory_order_acquire);
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::set_child(node_ptr node, bool is_right, node_ptr value) noexcept
+    {
+        (is_right ? node->right : node->left).store(value, std::memory_order_release);
+    }
+
+    template <typename Key, typename Compare>
+    int concurrent_avl<Key, Compare>::height(const node_type* node) noexcept
+    {
+        return node != nullptr ? node->height.load(std::memory_order_acquire) : 0;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_avl<Key, Compare>::is_equal(const key_type& lhs, const key_type& rhs) const
+    {
+        return !key_cmp(lhs, rhs) && !key_cmp(rhs, lhs);
+    }
+
+    template <typename Key, typename Compare>
+    int concurrent_avl<Key, Compare>::check(const node_type* subtree, const key_type* lower, const key_type* upper,
+                                            std::size_t& present) const
+    {
+        if (subtree == nullptr)
+        {
+            return 0;
+        }
+
+        const key_type& key = subtree->value;
+        if ((lower != nullptr && !key_cmp(*lower, key)) || (upper != nullptr && !key_cmp(key, *upper)))
+        {
+            return -1;
+        }
+
+        const node_type* left = child(subtree, false);
+        const node_type* right = child(subtree, true);
+        if ((left != nullptr && left->parent.load() != subtree) || (right != nullptr && right->parent.load() != subtree))
+        {
+            return -1;
+        }
+
+        if (subtree->is_present.load())
+        {
+            present++;
+        }
+        else if (left == nullptr || right == nullptr)
+        {
+            return -1;
+        }
+
+        const int left_height = check(left, lower, &key, present);
+        const int right_height = check(right, &key, upper, present);
+        if (left_height < 0 || right_height < 0 || std::abs(left_height - right_height) > 1)
+        {
+            return -1;
+        }
+
+        const int subtree_height = 1 + std::max(left_height, right_height);
+        return subtree_height == subtree->height.load() ? subtree_height : -1;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::retire(node_ptr node)
+    {
+        epochs.pin().retire(node, &destroy_node);
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left.load(std::memory_order_relaxed));
+        destroy(subtree->right.load(std::memory_order_relaxed));
+        delete subtree;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_avl<Key, Compare>::destroy_node(void* node) noexcept
+    {
+        delete static_cast<node_ptr>(node);
+    }
+
+} // namespace tree
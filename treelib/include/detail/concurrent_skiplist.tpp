@@ -0,0 +1,652 @@
+#pragma once
+
+#include <new>
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::const_iterator::const_iterator(
+            detail::epoch_domain::guard guard, node_ptr node) noexcept
+        : guard{std::move(guard)}, node{node}
+    { }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::const_iterator::const_iterator(const const_iterator& other)
+        : guard{other.guard.duplicate()}, node{other.node}
+    { }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator&
+    concurrent_skiplist<Key, Compare>::const_iterator::operator = (const const_iterator& other)
+    {
+        if (this != &other)
+        {
+            guard = other.guard.duplicate();
+            node = other.node;
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    const typename concurrent_skiplist<Key, Compare>::key_type&
+    concurrent_skiplist<Key, Compare>::const_iterator::operator * () const
+    {
+        return node->value;
+    }
+
+    template <typename Key, typename Compare>
+    const typename concurrent_skiplist<Key, Compare>::key_type*
+    concurrent_skiplist<Key, Compare>::const_iterator::operator -> () const
+    {
+        return &node->value;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator&
+    concurrent_skiplist<Key, Compare>::const_iterator::operator ++ ()
+    {
+        node = next_unmarked(node);
+        if (node == nullptr)
+        {
+            guard = detail::epoch_domain::guard();
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator
+    concurrent_skiplist<Key, Compare>::const_iterator::operator ++ (int)
+    {
+        const_iterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::const_iterator::operator == (const const_iterator& other) const
+    {
+        return node == other.node;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    ///////////////////
+    //   SKIP LIST   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::concurrent_skiplist() = default;
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::concurrent_skiplist(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::concurrent_skiplist(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::concurrent_skiplist(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::concurrent_skiplist(self_type&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>::~concurrent_skiplist()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>& concurrent_skiplist<Key, Compare>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_skiplist<Key, Compare>& concurrent_skiplist<Key, Compare>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            // nodes retired by other stay in its epoch domain and are freed with it
+            this->clear();
+            for (std::size_t level = 0; level < max_height; level++)
+            {
+                head[level].store(other.head[level].exchange(0));
+            }
+            height.store(other.height.exchange(1));
+            m_size.store(other.m_size.exchange(0));
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::iterator concurrent_skiplist<Key, Compare>::begin()
+    {
+        return std::as_const(*this).begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator concurrent_skiplist<Key, Compare>::begin() const
+    {
+        guard_type guard = epochs.pin();
+
+        node_ptr first = pointer_of(head[0].load(std::memory_order_acquire));
+        while (first != nullptr && is_marked(first->links()[0].load(std::memory_order_acquire)))
+        {
+            first = pointer_of(first->links()[0].load(std::memory_order_acquire));
+        }
+
+        if (first == nullptr)
+        {
+            return end();
+        }
+        return const_iterator(std::move(guard), first);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator concurrent_skiplist<Key, Compare>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::iterator concurrent_skiplist<Key, Compare>::end()
+    {
+        return iterator();
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator concurrent_skiplist<Key, Compare>::end() const
+    {
+        return const_iterator();
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator concurrent_skiplist<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t concurrent_skiplist<Key, Compare>::size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void concurrent_skiplist<Key, Compare>::clear() noexcept
+    {
+        // every node that is still linked is linked on level 0
+        node_ptr current = pointer_of(head[0].load(std::memory_order_acquire));
+        while (current != nullptr)
+        {
+            node_ptr next = pointer_of(current->links()[0].load(std::memory_order_relaxed));
+            destroy_node(current);
+            current = next;
+        }
+
+        for (auto& link : head)
+        {
+            link.store(0, std::memory_order_relaxed);
+        }
+        height.store(1, std::memory_order_relaxed);
+        m_size.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::insert(key_type key)
+    {
+        link_type* preds[max_height];
+        node_ptr succs[max_height];
+
+        guard_type guard = epochs.pin();
+
+        if (find_position(key, preds, succs, guard))
+        {
+            return false;
+        }
+
+        const std::uint8_t node_height = random_height();
+        node_ptr node = create_node(std::move(key), node_height);
+        const key_type& value = node->value;
+
+        // linking on level 0 makes the key visible
+        while (true)
+        {
+            for (std::size_t level = 0; level < node_height; level++)
+            {
+                node->links()[level].store(link_of(succs[level]), std::memory_order_relaxed);
+            }
+
+            node->references.store(2, std::memory_order_relaxed);
+            std::uintptr_t expected = link_of(succs[0]);
+            if (preds[0]->compare_exchange_strong(expected, link_of(node),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed))
+            {
+                break;
+            }
+            node->references.store(1, std::memory_order_relaxed);
+
+            if (find_position(value, preds, succs, guard))
+            {
+                // nobody else has seen the node
+                destroy_node(node);
+                return false;
+            }
+        }
+
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        std::size_t current_height = height.load(std::memory_order_relaxed);
+        while (current_height < node_height &&
+               !height.compare_exchange_weak(current_height, node_height, std::memory_order_relaxed))
+        { }
+
+        // the upper levels only speed up searches, linking stops as soon as the node gets erased
+        for (std::size_t level = 1; level < node_height; level++)
+        {
+            while (true)
+            {
+                std::uintptr_t next = node->links()[level].load(std::memory_order_acquire);
+                if (is_marked(next))
+                {
+                    release(node, guard);
+                    return true;
+                }
+                if (pointer_of(next) != succs[level] &&
+                    !node->links()[level].compare_exchange_strong(next, link_of(succs[level]),
+                                                                  std::memory_order_acq_rel))
+                {
+                    // marked in the meantime
+                    release(node, guard);
+                    return true;
+                }
+
+                node->references.fetch_add(1, std::memory_order_relaxed);
+                std::uintptr_t expected = link_of(succs[level]);
+                if (preds[level]->compare_exchange_strong(expected, link_of(node),
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed))
+                {
+                    if (is_marked(node->links()[level].load(std::memory_order_acquire)))
+                    {
+                        // erased while being linked, make sure the node does not stay reachable
+                        find_position(value, preds, succs, guard);
+                        release(node, guard);
+                        return true;
+                    }
+                    break;
+                }
+                node->references.fetch_sub(1, std::memory_order_relaxed);
+
+                find_position(value, preds, succs, guard);
+                if (succs[0] != node)
+                {
+                    // already erased and unlinked
+                    release(node, guard);
+                    return true;
+                }
+            }
+        }
+
+        release(node, guard);
+        return true;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::erase(const key_type& key)
+    {
+        link_type* preds[max_height];
+        node_ptr succs[max_height];
+
+        guard_type guard = epochs.pin();
+
+        if (!find_position(key, preds, succs, guard))
+        {
+            return false;
+        }
+
+        node_ptr node = succs[0];
+
+        // mark the upper levels first so that the node stops gaining links
+        for (std::size_t level = node->height; level-- > 1; )
+        {
+            std::uintptr_t next = node->links()[level].load(std::memory_order_acquire);
+            while (!is_marked(next) &&
+                   !node->links()[level].compare_exchange_weak(next, next | mark, std::memory_order_acq_rel))
+            { }
+        }
+
+        // whoever marks level 0 erases the key
+        std::uintptr_t next = node->links()[0].load(std::memory_order_acquire);
+        while (true)
+        {
+            if (is_marked(next))
+            {
+                return false;
+            }
+            if (node->links()[0].compare_exchange_weak(next, next | mark, std::memory_order_acq_rel))
+            {
+                break;
+            }
+        }
+
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+
+        // unlink the node from every level
+        find_position(key, preds, succs, guard);
+        return true;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::iterator concurrent_skiplist<Key, Compare>::find(const key_type& value)
+    {
+        return std::as_const(*this).find(value);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator concurrent_skiplist<Key, Compare>::find(const key_type& value) const
+    {
+        guard_type guard = epochs.pin();
+
+        node_ptr node = search(value);
+        if (node == nullptr || key_cmp(value, node->value))
+        {
+            return end();
+        }
+        return const_iterator(std::move(guard), node);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::const_iterator
+    concurrent_skiplist<Key, Compare>::lower_bound(const key_type& value) const
+    {
+        guard_type guard = epochs.pin();
+
+        node_ptr node = search(value);
+        if (node == nullptr)
+        {
+            return end();
+        }
+        return const_iterator(std::move(guard), node);
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::contains(const key_type& value) const
+    {
+        guard_type guard = epochs.pin();
+
+        node_ptr node = search(value);
+        return node != nullptr && !key_cmp(value, node->value);
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::is_skiplist() const noexcept
+    {
+        // count the nodes each level should have from level 0
+        std::size_t level_sizes[max_height] = { };
+        std::size_t count = 0;
+
+        for (std::size_t level = 0; level < max_height; level++)
+        {
+            node_ptr previous = nullptr;
+            std::uintptr_t link = head[level].load(std::memory_order_acquire);
+            std::size_t level_size = 0;
+
+            while (pointer_of(link) != nullptr)
+            {
+                if (is_marked(link))
+                {
+                    return false;
+                }
+
+                node_ptr current = pointer_of(link);
+                if (previous != nullptr && !key_cmp(previous->value, current->value))
+                {
+                    return false;
+                }
+                if (current->height <= level)
+                {
+                    return false;
+                }
+                if (level == 0)
+                {
+                    for (std::size_t node_level = 0; node_level < current->height; node_level++)
+                    {
+                        level_sizes[node_level]++;
+                    }
+                    count++;
+                }
+
+                level_size++;
+                previous = current;
+                link = current->links()[level].load(std::memory_order_acquire);
+            }
+
+            if (is_marked(link) || level_size != level_sizes[level])
+            {
+                return false;
+            }
+        }
+
+        return count == size();
+    }
+
+    ///////////////////
+    //   INTERNALS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::find_position(const key_type& key, link_type** preds, node_ptr* succs,
+                                                          guard_type& guard)
+    {
+    retry:
+        link_type* pred_links = head;
+
+        for (std::size_t level = max_height; level-- > 0; )
+        {
+            node_ptr current = pointer_of(pred_links[level].load(std::memory_order_acquire));
+
+            while (current != nullptr)
+            {
+                std::uintptr_t next = current->links()[level].load(std::memory_order_acquire);
+
+                while (is_marked(next))
+                {
+                    // help unlinking the erased node, start over if the predecessor changed
+                    std::uintptr_t expected = link_of(current);
+                    if (!pred_links[level].compare_exchange_strong(expected, next & ~mark,
+                                                                   std::memory_order_acq_rel))
+                    {
+                        goto retry;
+                    }
+                    release(current, guard);
+
+                    current = pointer_of(next);
+                    if (current == nullptr)
+                    {
+                        break;
+                    }
+                    next = current->links()[level].load(std::memory_order_acquire);
+                }
+
+                if (current == nullptr || !key_cmp(current->value, key))
+                {
+                    break;
+                }
+
+                pred_links = current->links();
+                current = pointer_of(next);
+            }
+
+            preds[level] = pred_links + level;
+            succs[level] = current;
+        }
+
+        return succs[0] != nullptr && !key_cmp(key, succs[0]->value);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::node_ptr
+    concurrent_skiplist<Key, Compare>::search(const key_type& value) const
+    {
+        const link_type* pred_links = head;
+        node_ptr current = nullptr;
+
+        for (std::size_t level = height.load(std::memory_order_relaxed); level-- > 0; )
+        {
+            current = pointer_of(pred_links[level].load(std::memory_order_acquire));
+
+            while (current != nullptr)
+            {
+                const std::uintptr_t next = current->links()[level].load(std::memory_order_acquire);
+                if (is_marked(next))
+                {
+                    // erased, step over it without unlinking
+                    current = pointer_of(next);
+                    continue;
+                }
+
+                if (!key_cmp(current->value, value))
+                {
+                    break;
+                }
+
+                pred_links = current->links();
+                current = pointer_of(next);
+            }
+        }
+
+        return current;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_skiplist<Key, Compare>::release(node_ptr node, guard_type& guard) noexcept
+    {
+        if (node->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            guard.retire(node, &destroy_node);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    std::uint8_t concurrent_skiplist<Key, Compare>::random_height() noexcept
+    {
+        thread_local std::mt19937_64 gen{std::random_device{}()};
+
+        // each level holds half of the nodes of the one below
+        const std::uint64_t bits = gen() | (std::uint64_t{1} << (max_height - 1));
+        return static_cast<std::uint8_t>(detail::count_trailing_zeros(bits) + 1);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::node_ptr
+    concurrent_skiplist<Key, Compare>::create_node(key_type key, std::uint8_t height)
+    {
+        void* memory = ::operator new(sizeof(node_type) + height * sizeof(link_type));
+        node_ptr node = new (memory) node_type(std::move(key), height);
+        for (std::size_t level = 0; level < height; level++)
+        {
+            new (node->links() + level) link_type(0);
+        }
+        return node;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_skiplist<Key, Compare>::destroy_node(void* node) noexcept
+    {
+        static_cast<node_ptr>(node)->~node_type();
+        ::operator delete(node);
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::node_ptr
+    concurrent_skiplist<Key, Compare>::pointer_of(std::uintptr_t link) noexcept
+    {
+        return reinterpret_cast<node_ptr>(link & ~mark);
+    }
+
+    template <typename Key, typename Compare>
+    std::uintptr_t concurrent_skiplist<Key, Compare>::link_of(node_ptr node) noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_skiplist<Key, Compare>::is_marked(std::uintptr_t link) noexcept
+    {
+        return (link & mark) != 0;
+    }
+
+    template <typename Key, typename Compare>
+    typename concurrent_skiplist<Key, Compare>::node_ptr
+    concurrent_skiplist<Key, Compare>::next_unmarked(node_ptr node) noexcept
+    {
+        node_ptr next = pointer_of(node->links()[0].load(std::memory_order_acquire));
+        while (next != nullptr && is_marked(next->links()[0].load(std::memory_order_acquire)))
+        {
+            next = pointer_of(next->links()[0].load(std::memory_order_acquire));
+        }
+        return next;
+    }
+
+} // namespace tree
@@ -0,0 +1,213 @@
+#pragma once
+
+namespace tree
+{
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key, typename Compare>
+    concurrent_splay<Key, Compare>::concurrent_splay(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            tree.insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    concurrent_splay<Key, Compare>::concurrent_splay(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            tree.insert(std::move(element));
+        }
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool concurrent_splay<Key, Compare>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t concurrent_splay<Key, Compare>::size() const
+    {
+        std::shared_lock lock(mutex);
+        return tree.size();
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void concurrent_splay<Key, Compare>::clear()
+    {
+        std::unique_lock lock(mutex);
+        apply_logged();
+        tree.clear();
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_splay<Key, Compare>::insert(key_type key)
+    {
+        std::unique_lock lock(mutex);
+
+        // the lock is taken anyway, the logged splays go first to keep their order
+        apply_logged();
+
+        const std::size_t size_before = tree.size();
+        tree.insert(std::move(key));
+        return tree.size() != size_before;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_splay<Key, Compare>::erase(const key_type& key)
+    {
+        std::unique_lock lock(mutex);
+        apply_logged();
+
+        const std::size_t size_before = tree.size();
+        tree.erase(key);
+        return tree.size() != size_before;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_splay<Key, Compare>::maintain()
+    {
+        run_maintenance();
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    std::optional<Key> concurrent_splay<Key, Compare>::find(const key_type& value) const
+    {
+        std::optional<key_type> found;
+        bool is_full = false;
+        {
+            std::shared_lock lock(mutex);
+            if (const auto node = tree.lookup(value); node != nullptr)
+            {
+                found = node->value;
+                is_full = log_access(node->value);
+            }
+        }
+
+        if (is_full)
+        {
+            run_maintenance();
+        }
+        return found;
+    }
+
+    template <typename Key, typename Compare>
+    bool concurrent_splay<Key, Compare>::contains(const key_type& value) const
+    {
+        return find(value).has_value();
+    }
+
+    template <typename Key, typename Compare>
+    std::vector<Key> concurrent_splay<Key, Compare>::keys() const
+    {
+        std::shared_lock lock(mutex);
+        const tree_type& shared = tree;
+        return std::vector<key_type>(shared.begin(), shared.end());
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t concurrent_splay<Key, Compare>::depth(const key_type& value) const
+    {
+        std::shared_lock lock(mutex);
+        return tree.depth(value);
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t concurrent_splay<Key, Compare>::deferred_splays() const noexcept
+    {
+        return splays_count.load(std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t concurrent_splay<Key, Compare>::maintenance_steps() const noexcept
+    {
+        return steps_count.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////
+    //   DEFERRING   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    bool concurrent_splay<Key, Compare>::log_access(const key_type& key) const
+    {
+        // a thread keeps finding the same buffer as long as it is not crowded out
+        static thread_local const std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        for (std::size_t offset = 0; offset < slots_count; offset++)
+        {
+            buffer& current = buffers[(start + offset) % slots_count];
+
+            bool expected = false;
+            if (current.is_busy.load(std::memory_order_relaxed) ||
+                !current.is_busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            const bool is_logged = current.size < buffer_size;
+            if (is_logged)
+            {
+                current.keys[current.size++] = key;
+            }
+            const bool is_full = current.size == buffer_size;
+            current.is_busy.store(false, std::memory_order_release);
+
+            if (is_logged)
+            {
+                return is_full;
+            }
+        }
+
+        // every buffer is busy or full, the hit goes unlogged
+        return false;
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_splay<Key, Compare>::run_maintenance() const
+    {
+        std::unique_lock lock(mutex);
+        apply_logged();
+    }
+
+    template <typename Key, typename Compare>
+    void concurrent_splay<Key, Compare>::apply_logged() const
+    {
+        // no reader holds a buffer under the exclusive lock
+        std::size_t applied = 0;
+        for (auto& current : buffers)
+        {
+            for (std::size_t index = 0; index < current.size; index++)
+            {
+                // the key may have been erased since, then nothing moves
+                tree.find(current.keys[index]);
+            }
+            applied += current.size;
+            current.size = 0;
+        }
+
+        if (applied != 0)
+        {
+            splays_count.fetch_add(applied, std::memory_order_relaxed);
+            steps_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace tree
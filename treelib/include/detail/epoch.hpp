@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+
+#include "intrinsics.hpp"
+
+namespace tree::detail
+{
+    /////////////////////////////////
+    //   EPOCH-BASED RECLAMATION   //
+    /////////////////////////////////
+
+    // Memory unlinked from a lock-free structure is retired instead of freed, and is freed
+    // only once the global epoch has advanced twice since: by then every thread that could
+    // still hold a pointer to it has left its critical section.
+    //
+    // A thread enters a critical section with pin(), which takes a free participant slot
+    // and announces the current epoch in it. The epoch advances when every pinned slot
+    // has announced it. Slots are reused, so threads do not have to register.
+    class epoch_domain
+    {
+        struct retired
+        {
+            void* pointer;
+            void (*deleter)(void*);
+            std::uint64_t epoch;
+        };
+
+        struct alignas(cache_line_size) participant
+        {
+            std::atomic<std::uint64_t> epoch{idle};
+            std::atomic<bool> in_use{true};
+            participant* next = nullptr;
+
+            // owned by whoever holds the slot
+            std::vector<retired> retired_list;
+        };
+
+    public:
+        // pins the calling thread for its lifetime, move-only; an empty one pins nothing
+        class guard
+        {
+        public:
+            guard() = default;
+
+            guard(const guard&) = delete;
+            guard& operator = (const guard&) = delete;
+
+            guard(guard&& other) noexcept
+                : domain{std::exchange(other.domain, nullptr)},
+                  slot{std::exchange(other.slot, nullptr)}
+            { }
+
+            guard& operator = (guard&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    unpin();
+                    domain = std::exchange(other.domain, nullptr);
+                    slot = std::exchange(other.slot, nullptr);
+                }
+                return *this;
+            }
+
+            ~guard()
+            {
+                unpin();
+            }
+
+            // A second pin at the epoch of this one, so it keeps alive everything this one does.
+            // A fresh pin would announce the current epoch, which may already be one later.
+            guard duplicate() const
+            {
+                if (slot == nullptr)
+                {
+                    return guard();
+                }
+
+                participant* other = domain->acquire();
+                other->epoch.store(slot->epoch.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+                return guard(domain, other);
+            }
+
+            // the pointer must already be unreachable for threads that are not pinned
+            void retire(void* pointer, void (*deleter)(void*))
+            {
+                slot->retired_list.push_back({pointer, deleter, domain->global_epoch.load(std::memory_order_acquire)});
+
+                if (slot->retired_list.size() >= collect_threshold)
+                {
+                    domain->collect(slot);
+                }
+            }
+
+        private:
+            friend class epoch_domain;
+
+            guard(epoch_domain* domain, participant* slot) noexcept
+                : domain{domain}, slot{slot}
+            { }
+
+            void unpin() noexcept
+            {
+                if (slot != nullptr)
+                {
+                    slot->epoch.store(idle, std::memory_order_release);
+                    slot->in_use.store(false, std::memory_order_release);
+                    slot = nullptr;
+                }
+            }
+
+        private:
+            epoch_domain* domain = nullptr;
+            participant* slot = nullptr;
+        };
+
+    public:
+        epoch_domain() = default;
+
+        epoch_domain(const epoch_domain&) = delete;
+        epoch_domain& operator = (const epoch_domain&) = delete;
+
+        // no guard may be alive
+        ~epoch_domain()
+        {
+            participant* current = participants.load(std::memory_order_acquire);
+            while (current != nullptr)
+            {
+                for (const auto& item : current->retired_list)
+                {
+                    item.deleter(item.pointer);
+                }
+
+                participant* next = current->next;
+                delete current;
+                current = next;
+            }
+        }
+
+        guard pin()
+        {
+            participant* slot = acquire();
+
+            // the announcement must be visible while the global epoch still equals it,
+            // otherwise the epoch could move two steps past it
+            std::uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+            while (true)
+            {
+                slot->epoch.store(epoch, std::memory_order_seq_cst);
+                const std::uint64_t current = global_epoch.load(std::memory_order_seq_cst);
+                if (current == epoch)
+                {
+                    break;
+                }
+                epoch = current;
+            }
+
+            return guard(this, slot);
+        }
+
+    private:
+        participant* acquire()
+        {
+            // the slot this thread used last in this domain is most likely free
+            if (hint.domain_id == id && hint.slot != nullptr && try_take(hint.slot))
+            {
+                return hint.slot;
+            }
+
+            participant* current = participants.load(std::memory_order_acquire);
+            for (; current != nullptr; current = current->next)
+            {
+                if (try_take(current))
+                {
+                    hint = {id, current};
+                    return current;
+                }
+            }
+
+            auto slot = new participant();
+            slot->next = participants.load(std::memory_order_relaxed);
+            while (!participants.compare_exchange_weak(slot->next, slot,
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed))
+            { }
+
+            hint = {id, slot};
+            return slot;
+        }
+
+        static bool try_take(participant* slot) noexcept
+        {
+            bool expected = false;
+            return !slot->in_use.load(std::memory_order_relaxed) &&
+                   slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire);
+        }
+
+        // the epoch moves on once no pinned slot lags behind it
+        void try_advance() noexcept
+        {
+            std::uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+
+            participant* current = participants.load(std::memory_order_acquire);
+            for (; current != nullptr; current = current->next)
+            {
+                const std::uint64_t announced = current->epoch.load(std::memory_order_seq_cst);
+                if (announced != idle && announced != epoch)
+                {
+                    return;
+                }
+            }
+
+            global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+        }
+
+        void collect(participant* slot)
+        {
+            try_advance();
+
+            const std::uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+            auto& retired_list = slot->retired_list;
+
+            auto is_safe = [epoch](const retired& item) { return item.epoch + 2 <= epoch; };
+            auto first_kept = std::partition(retired_list.begin(), retired_list.end(),
+                                             [&](const retired& item) { return !is_safe(item); });
+
+            for (auto it = first_kept; it != retired_list.end(); ++it)
+            {
+                it->deleter(it->pointer);
+            }
+            retired_list.erase(first_kept, retired_list.end());
+        }
+
+    private:
+        static constexpr std::uint64_t idle = std::numeric_limits<std::uint64_t>::max();
+        static constexpr std::size_t collect_threshold = 64;
+
+        // zero-initialized like any thread_local
+        struct slot_hint
+        {
+            std::uint64_t domain_id;
+            participant* slot;
+        };
+
+        // ids tell domains apart even if one is allocated where another used to be
+        inline static std::atomic<std::uint64_t> next_id{1};
+        inline static thread_local slot_hint hint;
+
+        std::atomic<std::uint64_t> global_epoch{0};
+        std::atomic<participant*> participants{nullptr};
+        const std::uint64_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+    };
+
+} // namespace tree::detail
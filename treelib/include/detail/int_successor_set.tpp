@@ -0,0 +1,312 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <unsigned Bits>
+    int_successor_set<Bits>::const_iterator::const_iterator(const self_type* owner, std::uint64_t value)
+        : owner{owner}, value{value}, key{static_cast<key_type>(value)}
+    { }
+
+    template <unsigned Bits>
+    const std::uint32_t& int_successor_set<Bits>::const_iterator::operator * () const
+    {
+        return key;
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator& int_successor_set<Bits>::const_iterator::operator ++ ()
+    {
+        if (value != detail::veb_none)
+        {
+            value = owner->set.successor(value);
+            key = static_cast<key_type>(value);
+        }
+        return *this;
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator& int_successor_set<Bits>::const_iterator::operator -- ()
+    {
+        if (value == detail::veb_none)
+        {   // prev from end()
+            value = owner->set.max();
+        }
+        else
+        {
+            value = owner->set.predecessor(value);
+        }
+        key = static_cast<key_type>(value);
+        return *this;
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::const_iterator::operator -- (int)
+    {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::const_iterator::operator == (const const_iterator& other) const
+    {
+        return value == other.value;
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <unsigned Bits>
+    int_successor_set<Bits>::int_successor_set() = default;
+
+    template <unsigned Bits>
+    int_successor_set<Bits>::int_successor_set(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <unsigned Bits>
+    int_successor_set<Bits>::int_successor_set(std::initializer_list<key_type>&& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <unsigned Bits>
+    int_successor_set<Bits>::int_successor_set(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <unsigned Bits>
+    int_successor_set<Bits>::int_successor_set(self_type&& other) noexcept
+    {
+        std::swap(this->set, other.set);
+        std::swap(this->m_size, other.m_size);
+    }
+
+    template <unsigned Bits>
+    int_successor_set<Bits>& int_successor_set<Bits>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <unsigned Bits>
+    int_successor_set<Bits>& int_successor_set<Bits>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->set, other.set);
+            std::swap(this->m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::iterator int_successor_set<Bits>::begin()
+    {
+        return iterator(this, empty() ? detail::veb_none : set.min());
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::begin() const
+    {
+        return const_iterator(this, empty() ? detail::veb_none : set.min());
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::iterator int_successor_set<Bits>::end()
+    {
+        return iterator(this, detail::veb_none);
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::end() const
+    {
+        return const_iterator(this, detail::veb_none);
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <unsigned Bits>
+    std::size_t int_successor_set<Bits>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <unsigned Bits>
+    void int_successor_set<Bits>::clear() noexcept
+    {
+        set = detail::veb_set<Bits>();
+        m_size = 0;
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::insert(key_type key)
+    {
+        if (!in_universe(key))
+        {
+            throw std::out_of_range("key is outside of the universe");
+        }
+
+        const bool inserted = set.insert(key);
+        m_size += inserted ? 1 : 0;
+        return inserted;
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::erase(key_type key)
+    {
+        if (!in_universe(key))
+        {
+            return false;
+        }
+
+        const bool erased = set.erase(key);
+        m_size -= erased ? 1 : 0;
+        return erased;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::iterator int_successor_set<Bits>::find(key_type value)
+    {
+        return iterator(this, contains(value) ? value : detail::veb_none);
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::find(key_type value) const
+    {
+        return const_iterator(this, contains(value) ? value : detail::veb_none);
+    }
+
+    template <unsigned Bits>
+    typename int_successor_set<Bits>::const_iterator int_successor_set<Bits>::lower_bound(key_type value) const
+    {
+        if (contains(value))
+        {
+            return const_iterator(this, value);
+        }
+        const auto next = successor(value);
+        return const_iterator(this, next.has_value() ? *next : detail::veb_none);
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::contains(key_type value) const noexcept
+    {
+        return !empty() && in_universe(value) && set.contains(value);
+    }
+
+    template <unsigned Bits>
+    std::optional<std::uint32_t> int_successor_set<Bits>::successor(key_type value) const noexcept
+    {
+        if (empty() || !in_universe(value))
+        {
+            return std::nullopt;
+        }
+
+        const std::uint64_t next = set.successor(value);
+        return next != detail::veb_none ? std::make_optional(static_cast<key_type>(next)) : std::nullopt;
+    }
+
+    template <unsigned Bits>
+    std::optional<std::uint32_t> int_successor_set<Bits>::predecessor(key_type value) const noexcept
+    {
+        if (empty())
+        {
+            return std::nullopt;
+        }
+        if (!in_universe(value))
+        {
+            return static_cast<key_type>(set.max());
+        }
+
+        const std::uint64_t previous = set.predecessor(value);
+        return previous != detail::veb_none ? std::make_optional(static_cast<key_type>(previous)) : std::nullopt;
+    }
+
+    template <unsigned Bits>
+    static_set<std::uint32_t, std::less<std::uint32_t>> int_successor_set<Bits>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::is_veb() const noexcept
+    {
+        return set.is_consistent() && set.count() == m_size;
+    }
+
+    template <unsigned Bits>
+    bool int_successor_set<Bits>::in_universe(key_type value) noexcept
+    {
+        return static_cast<std::uint64_t>(value) < universe_size;
+    }
+
+} // namespace tree
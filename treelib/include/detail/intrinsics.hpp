@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ThreadSanitizer is on; it reports the races that seqlock readers tolerate
+#if defined(__SANITIZE_THREAD__)
+#define TREELIB_THREAD_SANITIZER 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define TREELIB_THREAD_SANITIZER 1
+#endif
+#endif
+#ifndef TREELIB_THREAD_SANITIZER
+#define TREELIB_THREAD_SANITIZER 0
+#endif
+
+namespace tree::detail
+{
+    /////////////////////
+    //   PREFETCHING   //
+    /////////////////////
+
+    constexpr std::size_t cache_line_size = 64;
+
+    inline void prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    ////////////////////////
+    //   BIT OPERATIONS   //
+    ////////////////////////
+
+    // number of trailing zero bits, value must not be zero
+    inline unsigned count_trailing_zeros(std::uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+        unsigned count = 0;
+        while ((value & 1u) == 0)
+        {
+            value >>= 1u;
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    inline unsigned count_trailing_ones(std::uint64_t value) noexcept
+    {
+        return ~value == 0 ? 64u : count_trailing_zeros(~value);
+    }
+
+    // number of leading zero bits, value must not be zero
+    inline unsigned count_leading_zeros(std::uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned count = 0;
+        while ((value & (std::uint64_t(1) << 63u)) == 0)
+        {
+            value <<= 1u;
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    inline unsigned population_count(std::uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcountll(value));
+#else
+        unsigned count = 0;
+        for (; value != 0; value &= value - 1)
+        {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    ////////////////////
+    //   RACY LOADS   //
+    ////////////////////
+
+    // A link read in one piece from memory that a writer may change at the same time, for
+    // readers that validate afterwards what they read (seqlocks). The load is an acquire, so
+    // the node behind the link is read after the link itself.
+    template <typename T>
+    inline T* load_racy(T* const& link) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __atomic_load_n(&link, __ATOMIC_ACQUIRE);
+#else
+        return *static_cast<T* const volatile*>(&link);
+#endif
+    }
+
+} // namespace tree::detail
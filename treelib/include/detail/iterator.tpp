@@ -55,7 +55,7 @@ namespace tree
     }
 
     template <typename Node>
-    typename Node::value_type& NodeIterator<Node>::operator * ()
+    typename NodeIterator<Node>::reference NodeIterator<Node>::operator * ()
     {
         return node_stack.top()->value;
     }
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <exception>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
 
 namespace tree::detail
 {
@@ -29,9 +33,39 @@ namespace tree::detail
         Node* right  = nullptr;
     };
 
-    ///////////////////
+    ////////////////////
+    //   SPLAY NODE   //
+    ////////////////////
+
+    template <typename ValueType>
+    struct NodeSplay
+    {
+        using value_type = ValueType;
+        explicit NodeSplay(ValueType key) : value{key} { }
+
+        void set_left(NodeSplay* subtree) noexcept
+        {
+            this->left = subtree;
+        }
+
+        void set_right(NodeSplay* subtree) noexcept
+        {
+            this->right = subtree;
+        }
+
+        ValueType value = ValueType();
+
+        // finds that hit the node while access counting is on, saturating;
+        // next to a small key it takes the padding before the pointers
+        std::uint32_t accesses = 0;
+
+        NodeSplay* left   = nullptr;
+        NodeSplay* right  = nullptr;
+    };
+
+    //////////////////
     //   AVL NODE   //
-    ///////////////////
+    //////////////////
 
     enum class balance_factor : char {lhs_2 = -2, lhs_1 = -1, zero = 0, rhs_1 = 1, rhs_2 = 2};
 
@@ -94,12 +128,18 @@ namespace tree::detail
 
         balance_factor balance = balance_factor::zero;
 
+        // relaxed mode: the subtree changed since the balance factor was last right
+        bool is_marked = false;
+
+        // finds that hit the node while access counting is on, saturating
+        std::uint32_t accesses = 0;
+
         using value_type = ValueType;
     };
 
-    ///////////////////
-    //   AVL NODE   //
-    ///////////////////
+    ////////////////////////
+    //   CARTESIAN NODE   //
+    ////////////////////////
 
     template <typename ValueType>
     struct NodeCartesian
@@ -124,7 +164,282 @@ namespace tree::detail
         NodeCartesian* right  = nullptr;
         int priority = 0;
 
+        // finds that hit the node in the frequency-biased mode, saturating;
+        // it takes the padding after the priority
+        std::uint32_t accesses = 0;
+
+        using value_type = ValueType;
+    };
+
+    //////////////////
+    //   ZIP NODE   //
+    //////////////////
+
+    // The rank is geometric with mean 1, so a byte is plenty; next to the key
+    // it fits into the padding before the pointers for keys of up to 7 bytes.
+    template <typename ValueType>
+    struct NodeZip
+    {
+        explicit NodeZip(ValueType value, std::uint8_t rank)
+            : value{std::move(value)},
+              rank{rank}
+        { }
+
+        ValueType value = ValueType();
+        std::uint8_t rank = 0;
+        NodeZip* left   = nullptr;
+        NodeZip* right  = nullptr;
+
+        using value_type = ValueType;
+    };
+
+    ///////////////////
+    //   WAVL NODE   //
+    ///////////////////
+
+    // Rank differences of the two children, each either 1 or 2, packed into two bits:
+    // a set bit marks a 2-child. Like the zip rank it sits in the padding before the pointers.
+    constexpr std::uint8_t wavl_left_two = 1;
+    constexpr std::uint8_t wavl_right_two = 2;
+
+    template <typename ValueType>
+    struct NodeWAVL
+    {
+        explicit NodeWAVL(ValueType value) : value{std::move(value)} { }
+
+        ValueType value = ValueType();
+        std::uint8_t rank_diff = 0;
+        NodeWAVL* left   = nullptr;
+        NodeWAVL* right  = nullptr;
+
         using value_type = ValueType;
     };
 
-}
\ No newline at end of file
+    ////////////////////////
+    //   RED-BLACK NODE   //
+    ////////////////////////
+
+    enum class color : char {red, black};
+
+    template <typename ValueType>
+    struct NodeRB
+    {
+        explicit NodeRB(ValueType value) : value{std::move(value)} { }
+
+        void set_left(NodeRB<ValueType>* subtree) noexcept
+        {
+            this->left = subtree;
+        }
+
+        void set_right(NodeRB<ValueType>* subtree) noexcept
+        {
+            this->right = subtree;
+        }
+
+        ValueType value = ValueType();
+        NodeRB* left   = nullptr;
+        NodeRB* right  = nullptr;
+
+        color node_color = color::red;
+
+        using value_type = ValueType;
+    };
+
+    //////////////////////////////
+    //   WEIGHT-BALANCED NODE   //
+    //////////////////////////////
+
+    template <typename ValueType>
+    struct NodeWB
+    {
+        explicit NodeWB(ValueType value) : value{std::move(value)} { }
+
+        void set_left(NodeWB<ValueType>* subtree) noexcept
+        {
+            this->left = subtree;
+        }
+
+        void set_right(NodeWB<ValueType>* subtree) noexcept
+        {
+            this->right = subtree;
+        }
+
+        ValueType value = ValueType();
+        NodeWB* left   = nullptr;
+        NodeWB* right  = nullptr;
+
+        // number of nodes in the subtree rooted here
+        std::size_t size = 1;
+
+        using value_type = ValueType;
+    };
+
+    ////////////////////////
+    //   SKIP LIST NODE   //
+    ////////////////////////
+
+    // The links to the next node on each of the height levels are allocated right after
+    // the node. The lowest bit of a link marks the node as being erased on that level.
+    template <typename ValueType>
+    struct alignas(std::atomic<std::uintptr_t>) NodeSkipList
+    {
+        using link_type = std::atomic<std::uintptr_t>;
+
+        NodeSkipList(ValueType value, std::uint8_t height)
+            : value{std::move(value)},
+              height{height}
+        { }
+
+        link_type* links() noexcept
+        {
+            return reinterpret_cast<link_type*>(this + 1);
+        }
+
+        const link_type* links() const noexcept
+        {
+            return reinterpret_cast<const link_type*>(this + 1);
+        }
+
+        ValueType value;
+
+        // the inserting thread holds one reference until it is done,
+        // and every level the node is linked on holds one
+        std::atomic<std::uint32_t> references{1};
+        std::uint8_t height;
+
+        using value_type = ValueType;
+    };
+
+    /////////////////////////////
+    //   CONCURRENT AVL NODE   //
+    /////////////////////////////
+
+    // Links, height and version are read without the lock, so they are atomic. The version
+    // changes whenever a rotation moves keys out of the subtree, readers that passed the node
+    // compare it to the one they saw. A routing node keeps its place in the tree after its key
+    // was erased, until it has at most one child and can be unlinked.
+    template <typename ValueType>
+    struct NodeConcurrentAVL
+    {
+        NodeConcurrentAVL(ValueType value, NodeConcurrentAVL* parent, bool is_present)
+            : value{std::move(value)},
+              parent{parent},
+              is_present{is_present}
+        { }
+
+        const ValueType value;
+        std::atomic<NodeConcurrentAVL*> left{nullptr};
+        std::atomic<NodeConcurrentAVL*> right{nullptr};
+
+        // only followed by threads that hold the parent's lock and check the link back
+        std::atomic<NodeConcurrentAVL*> parent;
+
+        std::atomic<std::uint64_t> version{0};
+        std::atomic<int> height{1};
+        std::atomic<bool> is_present;
+
+        std::mutex mutex;
+
+        using value_type = ValueType;
+    };
+
+    /////////////////////////
+    //   RADIX TREE NODE   //
+    /////////////////////////
+
+    enum class art_node_type : std::uint8_t {node4, node16, node48, node256};
+
+    // longest part of a compressed path kept in the node itself, longer prefixes
+    // are completed from a leaf below
+    constexpr std::size_t art_max_prefix_length = 8;
+
+    struct NodeART
+    {
+        explicit NodeART(art_node_type type) : type{type} { }
+
+        art_node_type type;
+        std::uint16_t count = 0;
+        std::uint32_t prefix_length = 0;
+        std::uint8_t prefix[art_max_prefix_length] = { };
+    };
+
+    // keys are sorted, keys[i] leads to children[i]
+    struct NodeART4 : NodeART
+    {
+        NodeART4() : NodeART(art_node_type::node4) { }
+
+        std::uint8_t keys[4] = { };
+        NodeART* children[4] = { };
+    };
+
+    struct NodeART16 : NodeART
+    {
+        NodeART16() : NodeART(art_node_type::node16) { }
+
+        std::uint8_t keys[16] = { };
+        NodeART* children[16] = { };
+    };
+
+    // child_index[byte] is one past the slot of the child in children, 0 if there is none
+    struct NodeART48 : NodeART
+    {
+        NodeART48() : NodeART(art_node_type::node48) { }
+
+        std::uint8_t child_index[256] = { };
+        NodeART* children[48] = { };
+    };
+
+    struct NodeART256 : NodeART
+    {
+        NodeART256() : NodeART(art_node_type::node256) { }
+
+        NodeART* children[256] = { };
+    };
+
+    // leaves are referenced through NodeART pointers with the lowest bit set
+    template <typename ValueType>
+    struct alignas(2) NodeARTLeaf
+    {
+        explicit NodeARTLeaf(ValueType value) : value{std::move(value)} { }
+
+        ValueType value;
+
+        using value_type = ValueType;
+    };
+
+    /////////////////////
+    //   B-TREE NODE   //
+    /////////////////////
+
+    template <typename ValueType>
+    struct NodeBTree
+    {
+        explicit NodeBTree(bool is_leaf) : is_leaf{is_leaf} { }
+
+        std::uint16_t count = 0;
+        bool is_leaf = true;
+
+        using value_type = ValueType;
+    };
+
+    template <typename ValueType, std::size_t Capacity>
+    struct NodeBTreeLeaf : NodeBTree<ValueType>
+    {
+        NodeBTreeLeaf() : NodeBTree<ValueType>(true) { }
+
+        ValueType keys[Capacity];
+        NodeBTreeLeaf* prev = nullptr;
+        NodeBTreeLeaf* next = nullptr;
+    };
+
+    // keys[i] separates children[i] (keys less than it) from children[i + 1]
+    template <typename ValueType, std::size_t Capacity>
+    struct NodeBTreeInner : NodeBTree<ValueType>
+    {
+        NodeBTreeInner() : NodeBTree<ValueType>(false) { }
+
+        ValueType keys[Capacity];
+        NodeBTree<ValueType>* children[Capacity + 1] = { };
+    };
+
+}
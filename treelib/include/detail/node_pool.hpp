@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace tree::detail
+{
+    ///////////////////
+    //   NODE POOL   //
+    ///////////////////
+
+    // Type-stable node memory: a released node goes to a free list instead of back to the heap
+    // and is only ever reused for a node of the same type, so whoever still holds a pointer to
+    // it reads stale values but never freed or foreign memory. Fresh storage is zeroed when it
+    // is taken from the heap, so the links of a node that was never constructed are null.
+    //
+    // The memory goes back to the heap with the pool, every node has to be released by then.
+    template <typename Node>
+    class node_pool
+    {
+    public:
+        node_pool() = default;
+
+        node_pool(const node_pool&) = delete;
+        node_pool& operator = (const node_pool&) = delete;
+
+        ~node_pool()
+        {
+            for (void* storage : free_list)
+            {
+                ::operator delete(storage);
+            }
+        }
+
+        // takes storage from the heap now rather than in create() until count nodes are available
+        void reserve(std::size_t count)
+        {
+            if (free_list.size() >= count)
+            {
+                return;
+            }
+
+            // the free list keeps room for every node there is, so release() never allocates
+            const std::size_t needed = nodes_count + count - free_list.size();
+            if (free_list.capacity() < needed)
+            {
+                free_list.reserve(std::max(needed, 2 * free_list.capacity()));
+            }
+
+            while (free_list.size() < count)
+            {
+                void* storage = ::operator new(sizeof(Node));
+                std::memset(storage, 0, sizeof(Node));
+                free_list.push_back(storage);
+                nodes_count++;
+            }
+        }
+
+        template <typename... Args>
+        Node* create(Args&&... args)
+        {
+            if (free_list.empty())
+            {
+                reserve(1);
+            }
+
+            void* storage = free_list.back();
+            Node* node = ::new (storage) Node(std::forward<Args>(args)...);
+            free_list.pop_back();
+            return node;
+        }
+
+        void release(Node* node) noexcept
+        {
+            node->~Node();
+            free_list.push_back(node);
+        }
+
+        // nodes that create() hands out before it takes storage from the heap
+        std::size_t available() const noexcept
+        {
+            return free_list.size();
+        }
+
+    private:
+        std::vector<void*> free_list;
+
+        // taken from the heap so far, in the free list or not
+        std::size_t nodes_count = 0;
+    };
+
+} // namespace tree::detail
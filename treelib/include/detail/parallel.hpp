@@ -0,0 +1,282 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
+#include "../execution.hpp"
+
+namespace tree::detail
+{
+    /////////////////////////////
+    //   PARALLEL ALGORITHMS   //
+    /////////////////////////////
+
+    // smaller ranges are sorted, merged, scanned or built on one thread
+    inline constexpr std::size_t parallel_grain = 1 << 14;
+
+    // calls function(first, last) on disjoint blocks of [first, last) of at most grain
+    // elements, forking on the executor if there is one
+    template <typename Function>
+    void parallel_blocks(thread_pool* executor, std::size_t first, std::size_t last, std::size_t grain,
+                         const Function& function)
+    {
+        if (executor == nullptr || last - first <= grain)
+        {
+            function(first, last);
+            return;
+        }
+
+        const std::size_t middle = first + (last - first) / 2;
+        executor->fork_join([&]() { parallel_blocks(executor, first, middle, grain, function); },
+                            [&]() { parallel_blocks(executor, middle, last, grain, function); });
+    }
+
+    // Moves two sorted runs into out as one, equal elements of lhs first. The larger run is
+    // cut in the middle and the other one where its pivot would go, and both parts go on.
+    template <typename T, typename Compare>
+    void parallel_merge(T* lhs, std::size_t lhs_count, T* rhs, std::size_t rhs_count, T* out,
+                        const Compare& cmp, thread_pool* executor)
+    {
+        if (executor == nullptr || lhs_count + rhs_count <= parallel_grain)
+        {
+            std::merge(std::make_move_iterator(lhs), std::make_move_iterator(lhs + lhs_count),
+                       std::make_move_iterator(rhs), std::make_move_iterator(rhs + rhs_count), out, cmp);
+            return;
+        }
+
+        std::size_t lhs_middle = lhs_count / 2;
+        std::size_t rhs_middle = rhs_count / 2;
+        if (lhs_count >= rhs_count)
+        {
+            // elements of rhs equal to the pivot come after it
+            rhs_middle = static_cast<std::size_t>(std::lower_bound(rhs, rhs + rhs_count, lhs[lhs_middle], cmp) - rhs);
+        }
+        else
+        {
+            // elements of lhs equal to the pivot come before it
+            lhs_middle = static_cast<std::size_t>(std::upper_bound(lhs, lhs + lhs_count, rhs[rhs_middle], cmp) - lhs);
+        }
+
+        executor->fork_join(
+                [&]() { parallel_merge(lhs, lhs_middle, rhs, rhs_middle, out, cmp, executor); },
+                [&]()
+                {
+                    parallel_merge(lhs + lhs_middle, lhs_count - lhs_middle, rhs + rhs_middle, rhs_count - rhs_middle,
+                                   out + lhs_middle + rhs_middle, cmp, executor);
+                });
+    }
+
+    // stable merge sort of data, the buffer holds as many elements and is left unspecified
+    template <typename T, typename Compare>
+    void parallel_stable_sort(T* data, T* buffer, std::size_t count, const Compare& cmp, thread_pool* executor)
+    {
+        if (executor == nullptr || count <= parallel_grain)
+        {
+            std::stable_sort(data, data + count, cmp);
+            return;
+        }
+
+        const std::size_t half = count / 2;
+        executor->fork_join([&]() { parallel_stable_sort(data, buffer, half, cmp, executor); },
+                            [&]() { parallel_stable_sort(data + half, buffer + half, count - half, cmp, executor); });
+
+        parallel_merge(data, half, data + half, count - half, buffer, cmp, executor);
+        parallel_blocks(executor, 0, count, parallel_grain, [&](std::size_t first, std::size_t last)
+        {
+            std::move(buffer + first, buffer + last, data + first);
+        });
+    }
+
+    // the distinct keys of [first, last) in order, the first of equal ones kept like a
+    // sequence of inserts would; blocks count their distinct keys, then move them in place
+    template <typename Key, typename InputIt, typename Compare>
+    std::vector<Key> sorted_unique(InputIt first, InputIt last, const Compare& cmp, thread_pool* executor)
+    {
+        std::vector<Key> keys(first, last);
+        std::vector<Key> buffer(keys.size());
+        parallel_stable_sort(keys.data(), buffer.data(), keys.size(), cmp, executor);
+
+        const std::size_t blocks_count = (keys.size() + parallel_grain - 1) / parallel_grain;
+        std::vector<unsigned char> is_first(keys.size());
+        std::vector<std::size_t> offsets(blocks_count + 1, 0);
+
+        parallel_blocks(executor, 0, blocks_count, 1, [&](std::size_t first_block, std::size_t last_block)
+        {
+            for (std::size_t block = first_block; block < last_block; block++)
+            {
+                const std::size_t end = std::min(keys.size(), (block + 1) * parallel_grain);
+                for (std::size_t index = block * parallel_grain; index < end; index++)
+                {
+                    is_first[index] = index == 0 || cmp(keys[index - 1], keys[index]);
+                    offsets[block + 1] += is_first[index];
+                }
+            }
+        });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        parallel_blocks(executor, 0, blocks_count, 1, [&](std::size_t first_block, std::size_t last_block)
+        {
+            for (std::size_t block = first_block; block < last_block; block++)
+            {
+                const std::size_t end = std::min(keys.size(), (block + 1) * parallel_grain);
+                std::size_t position = offsets[block];
+                for (std::size_t index = block * parallel_grain; index < end; index++)
+                {
+                    if (is_first[index])
+                    {
+                        buffer[position++] = std::move(keys[index]);
+                    }
+                }
+            }
+        });
+
+        buffer.resize(offsets.back());
+        return buffer;
+    }
+
+    ////////////////////////////
+    //   PARALLEL TRAVERSAL   //
+    ////////////////////////////
+
+    // levels below the root where a tree of size nodes forks, as far as its subtrees are
+    // expected to be over the grain and a few more, so that the thieves still find work on
+    // a skewed tree such as a splayed one
+    inline std::size_t fork_depth(std::size_t size) noexcept
+    {
+        if (size <= parallel_grain)
+        {
+            return 0;
+        }
+
+        std::size_t depth = 4;
+        for (; size > parallel_grain; size /= 2)
+        {
+            depth++;
+        }
+        return depth;
+    }
+
+    // calls visit(node) on every node of the subtree in order; the stack is explicit, as a
+    // splay tree may be as deep as it is large
+    template <typename Node, typename Visit>
+    void visit_in_order(const Node* root, const Visit& visit)
+    {
+        std::vector<const Node*> path;
+        const Node* current = root;
+        while (current != nullptr || !path.empty())
+        {
+            while (current != nullptr)
+            {
+                path.push_back(current);
+                current = current->left;
+            }
+
+            current = path.back();
+            path.pop_back();
+            visit(current);
+            current = current->right;
+        }
+    }
+
+    // visit_in_order with the subtrees of the top depth levels on the workers, so the nodes
+    // are visited concurrently and in no particular order
+    template <typename Node, typename Visit>
+    void parallel_visit(const Node* root, std::size_t depth, thread_pool* executor, const Visit& visit)
+    {
+        if (executor == nullptr || depth == 0 || root == nullptr)
+        {
+            visit_in_order(root, visit);
+            return;
+        }
+
+        executor->fork_join([&]() { parallel_visit(root->left, depth - 1, executor, visit); },
+                            [&]()
+                            {
+                                visit(root);
+                                parallel_visit(root->right, depth - 1, executor, visit);
+                            });
+    }
+
+    // the keys of the subtree folded in order by accumulate, starting from identity; the
+    // subtrees of the top depth levels are folded on the workers and joined by combine
+    template <typename T, typename Node, typename Accumulate, typename Combine>
+    T parallel_reduce(const Node* root, std::size_t depth, thread_pool* executor, const T& identity,
+                      const Accumulate& accumulate, const Combine& combine)
+    {
+        if (executor == nullptr || depth == 0 || root == nullptr)
+        {
+            T result = identity;
+            visit_in_order(root, [&](const Node* node) { result = accumulate(std::move(result), node->value); });
+            return result;
+        }
+
+        auto [lhs, rhs] = executor->fork_join(
+                [&]() { return parallel_reduce(root->left, depth - 1, executor, identity, accumulate, combine); },
+                [&]()
+                {
+                    return combine(accumulate(identity, root->value),
+                                   parallel_reduce(root->right, depth - 1, executor, identity, accumulate, combine));
+                });
+        return combine(std::move(lhs), std::move(rhs));
+    }
+
+    // a copy of the subtree node for node, every node allocated before its subtrees
+    template <typename Node>
+    Node* clone_subtree(const Node* root)
+    {
+        Node* result = nullptr;
+
+        // nodes to copy and where their copies go
+        std::vector<std::pair<const Node*, Node**>> pending;
+        if (root != nullptr)
+        {
+            pending.emplace_back(root, &result);
+        }
+
+        while (!pending.empty())
+        {
+            const auto [source, slot] = pending.back();
+            pending.pop_back();
+
+            Node* copy = new Node(*source);
+            copy->left = nullptr;
+            copy->right = nullptr;
+            *slot = copy;
+
+            if (source->right != nullptr)
+            {
+                pending.emplace_back(source->right, &copy->right);
+            }
+            if (source->left != nullptr)
+            {
+                pending.emplace_back(source->left, &copy->left);
+            }
+        }
+
+        return result;
+    }
+
+    // clone_subtree with the subtrees of the top depth levels copied on the workers
+    template <typename Node>
+    Node* parallel_clone(const Node* root, std::size_t depth, thread_pool* executor)
+    {
+        if (executor == nullptr || depth == 0 || root == nullptr)
+        {
+            return clone_subtree(root);
+        }
+
+        Node* copy = new Node(*root);
+        const auto [lhs, rhs] = executor->fork_join(
+                [&]() { return parallel_clone<Node>(root->left, depth - 1, executor); },
+                [&]() { return parallel_clone<Node>(root->right, depth - 1, executor); });
+
+        copy->left = lhs;
+        copy->right = rhs;
+        return copy;
+    }
+
+} // namespace tree::detail
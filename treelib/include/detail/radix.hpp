@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "intrinsics.hpp"
+#include "simd.hpp"
+
+namespace tree::detail
+{
+    //////////////////////
+    //   KEY ENCODING   //
+    //////////////////////
+
+    // Binary-comparable byte strings: comparing the bytes of two encodings one by one
+    // orders them like the keys, and no encoding is a prefix of another.
+    template <typename Key, typename = void>
+    struct radix_key;
+
+    // big-endian, with the sign bit flipped so negative numbers come first
+    template <typename Key>
+    struct radix_key<Key, std::enable_if_t<std::is_integral_v<Key> && !std::is_same_v<Key, bool>>>
+    {
+        using unsigned_type = std::make_unsigned_t<Key>;
+
+        struct bytes_type
+        {
+            std::uint8_t data[sizeof(Key)];
+
+            static constexpr std::size_t size() noexcept
+            {
+                return sizeof(Key);
+            }
+
+            std::uint8_t operator [] (std::size_t index) const noexcept
+            {
+                return data[index];
+            }
+        };
+
+        static bytes_type encode(Key key) noexcept
+        {
+            auto bits = static_cast<unsigned_type>(key);
+            if constexpr (std::is_signed_v<Key>)
+            {
+                bits ^= static_cast<unsigned_type>(unsigned_type(1) << (8 * sizeof(Key) - 1));
+            }
+
+            bytes_type bytes;
+            for (std::size_t i = 0; i < sizeof(Key); i++)
+            {
+                bytes.data[sizeof(Key) - 1 - i] = static_cast<std::uint8_t>(bits >> (8 * i));
+            }
+            return bytes;
+        }
+    };
+
+    // the characters followed by a terminating zero, so strings must not contain '\0'
+    template <>
+    struct radix_key<std::string>
+    {
+        struct bytes_type
+        {
+            std::string_view view;
+
+            std::size_t size() const noexcept
+            {
+                return view.size() + 1;
+            }
+
+            std::uint8_t operator [] (std::size_t index) const noexcept
+            {
+                return index < view.size() ? static_cast<std::uint8_t>(view[index]) : 0;
+            }
+        };
+
+        // refers to the key, which must outlive the encoding
+        static bytes_type encode(const std::string& key) noexcept
+        {
+            return {key};
+        }
+    };
+
+    ///////////////////////////
+    //   SMALL BYTE ARRAYS   //
+    ///////////////////////////
+
+    // Child lookups in the inner nodes of radix trees: keys holds count <= 16 sorted bytes
+    // in a 16-byte array, whose slots past count may hold anything.
+
+    // index of the byte, count if it is missing
+    inline unsigned find_byte16(const std::uint8_t* keys, unsigned count, std::uint8_t byte) noexcept
+    {
+#if TREELIB_SIMD_X86 && defined(__SSE2__)
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(byte));
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+        const auto equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))) &
+                           ((1u << count) - 1);
+        return equal != 0 ? count_trailing_zeros(equal) : count;
+#else
+        for (unsigned i = 0; i < count; i++)
+        {
+            if (keys[i] == byte)
+            {
+                return i;
+            }
+        }
+        return count;
+#endif
+    }
+
+    // number of keys not greater than the byte
+    inline unsigned count_bytes_not_greater(const std::uint8_t* keys, unsigned count, std::uint8_t byte) noexcept
+    {
+#if TREELIB_SIMD_X86 && defined(__SSE2__)
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(byte));
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+        const __m128i not_greater = _mm_cmpeq_epi8(_mm_max_epu8(block, needle), needle);
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(not_greater)) & ((1u << count) - 1);
+        return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+        unsigned rank = 0;
+        while (rank < count && keys[rank] <= byte)
+        {
+            rank++;
+        }
+        return rank;
+#endif
+    }
+
+} // namespace tree::detail
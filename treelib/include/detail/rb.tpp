@@ -0,0 +1,627 @@
+#pragma once
+
+#include <iostream>
+
+namespace tree
+{
+    template <typename Key, typename Compare>
+    rb<Key, Compare>::rb() = default;
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>::rb(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>::rb(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>::rb(const rb<key_type, key_compare>& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>::rb(rb<key_type, key_compare>&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+        std::swap(this->m_size, other.m_size);
+    }
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>::~rb()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>& rb<Key, Compare>::operator = (const rb<key_type, key_compare>& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    rb<Key, Compare>& rb<Key, Compare>::operator = (rb<key_type, key_compare>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+            std::swap(this->m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::iterator rb<Key, Compare>::begin()
+    {
+        return iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::const_iterator rb<Key, Compare>::begin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::const_iterator rb<Key, Compare>::cbegin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::iterator rb<Key, Compare>::end()
+    {
+        return iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::const_iterator rb<Key, Compare>::end() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::const_iterator rb<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool rb<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t rb<Key, Compare>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void rb<Key, Compare>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+        m_size = 0;
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::node_ptr rb<Key, Compare>::insert(key_type key)
+    {
+        path_cache.clear();
+
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            path_cache.push_back(current);
+
+            if (key_cmp(key, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                current = current->right;
+            }
+            else
+            {
+                return current;
+            }
+        }
+
+        auto child = new node_type(std::move(key));
+        if (path_cache.empty())
+        {
+            head = child;
+        }
+        else
+        {
+            node_ptr parent = path_cache.back();
+            if (key_cmp(child->value, parent->value))
+            {
+                parent->left = child;
+            }
+            else
+            {
+                parent->right = child;
+            }
+        }
+
+        m_size++;
+        fix_insert(child);
+        return child;
+    }
+
+    template <typename Key, typename Compare>
+    void rb<Key, Compare>::erase(const key_type& key)
+    {
+        path_cache.clear();
+
+        // caching until the key
+        node_ptr node = head;
+        while (node != nullptr)
+        {
+            if (key_cmp(key, node->value))
+            {
+                path_cache.push_back(node);
+                node = node->left;
+            }
+            else if (key_cmp(node->value, key))
+            {
+                path_cache.push_back(node);
+                node = node->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (node == nullptr)
+        {   // no such key found
+            return;
+        }
+
+        detail::color removed_color = node->node_color;
+        node_ptr replacement = nullptr;
+        bool is_left_child = false;
+
+        if (node->left != nullptr && node->right != nullptr)
+        {
+            // the node has both children: its in-order successor takes its place,
+            // the successor's old position is the one that lost a node
+            const std::size_t node_position = path_cache.size();
+            path_cache.push_back(node);
+
+            node_ptr next = node->right;
+            while (next->left != nullptr)
+            {
+                path_cache.push_back(next);
+                next = next->left;
+            }
+
+            removed_color = next->node_color;
+            replacement = next->right;
+
+            node_ptr next_parent = path_cache.back();
+            if (next_parent == node)
+            {
+                is_left_child = false;
+            }
+            else
+            {
+                next_parent->left = replacement;
+                next->right = node->right;
+                is_left_child = true;
+            }
+
+            next->left = node->left;
+            next->node_color = node->node_color;
+            replace_child(node_position > 0 ? path_cache[node_position - 1] : nullptr, node, next);
+            path_cache[node_position] = next;
+        }
+        else
+        {
+            // Case with at most one child - splice the node out
+            replacement = node->left != nullptr ? node->left : node->right;
+
+            node_ptr parent = path_cache.empty() ? nullptr : path_cache.back();
+            is_left_child = parent != nullptr && parent->left == node;
+            replace_child(parent, node, replacement);
+        }
+
+        delete node;
+        m_size--;
+
+        if (removed_color == detail::color::black)
+        {
+            fix_erase(replacement, is_left_child);
+        }
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::iterator rb<Key, Compare>::find(const key_type& value)
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return iterator(head, current);
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::const_iterator rb<Key, Compare>::find(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return const_iterator(head, current);
+    }
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare> rb<Key, Compare>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key, typename Compare>
+    [[nodiscard]] bool rb<Key, Compare>::is_ordered(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return true;
+        }
+
+        const key_type& key = subtree->value;
+
+        node_ptr subtree_lhs = subtree->left;
+        bool is_lhs_ordered =
+                subtree_lhs == nullptr ||
+                (key_cmp(subtree_lhs->value, key) && is_ordered(subtree_lhs));
+
+        node_ptr subtree_rhs = subtree->right;
+        bool is_rhs_ordered =
+                subtree_rhs == nullptr ||
+                (key_cmp(key, subtree_rhs->value) && is_ordered(subtree_rhs));
+
+        return is_lhs_ordered && is_rhs_ordered;
+    }
+
+    template <typename Key, typename Compare>
+    [[nodiscard]] bool rb<Key, Compare>::is_rb(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            subtree = head;
+            if (is_red(head))
+            {
+                return false;
+            }
+        }
+
+        return is_ordered(subtree) && check_black_height(subtree) >= 0;
+    }
+
+    template <typename Key, typename Compare>
+    int rb<Key, Compare>::check_black_height(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return 0;
+        }
+
+        if (is_red(subtree) && (is_red(subtree->left) || is_red(subtree->right)))
+        {
+            return -1;
+        }
+
+        const int left_height = check_black_height(subtree->left);
+        const int right_height = check_black_height(subtree->right);
+        if (left_height < 0 || left_height != right_height)
+        {
+            return -1;
+        }
+
+        return left_height + (is_red(subtree) ? 0 : 1);
+    }
+
+    ///////////////////
+    //   BALANCING   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void rb<Key, Compare>::fix_insert(node_ptr node)
+    {
+        using detail::color;
+
+        // path_cache holds the ancestors of the red node
+        while (true)
+        {
+            if (path_cache.empty())
+            {
+                // the node is root
+                node->node_color = color::black;
+                return;
+            }
+
+            node_ptr parent = path_cache.back();
+            if (!is_red(parent))
+            {
+                return;
+            }
+
+            // a red parent is never the root, so the grandparent exists
+            node_ptr grand_parent = path_cache[path_cache.size() - 2];
+            const bool is_parent_left = grand_parent->left == parent;
+            node_ptr uncle = is_parent_left ? grand_parent->right : grand_parent->left;
+
+            if (is_red(uncle))
+            {
+                // recolor and continue two levels up
+                parent->node_color = color::black;
+                uncle->node_color = color::black;
+                grand_parent->node_color = color::red;
+
+                node = grand_parent;
+                path_cache.pop_back();
+                path_cache.pop_back();
+                continue;
+            }
+
+            node_ptr great_grand_parent = path_cache.size() > 2 ? path_cache[path_cache.size() - 3] : nullptr;
+            node_ptr subtree = nullptr;
+
+            if (is_parent_left)
+            {
+                if (parent->right == node)
+                {
+                    grand_parent->left = rotate_left(parent);
+                }
+                subtree = rotate_right(grand_parent);
+            }
+            else
+            {
+                if (parent->left == node)
+                {
+                    grand_parent->right = rotate_right(parent);
+                }
+                subtree = rotate_left(grand_parent);
+            }
+
+            subtree->node_color = color::black;
+            grand_parent->node_color = color::red;
+            replace_child(great_grand_parent, grand_parent, subtree);
+            return;
+        }
+    }
+
+    template <typename Key, typename Compare>
+    void rb<Key, Compare>::fix_erase(node_ptr node, bool is_left_child)
+    {
+        using detail::color;
+
+        // node (possibly nullptr) lacks one black, path_cache holds its ancestors
+        while (!path_cache.empty() && !is_red(node))
+        {
+            node_ptr parent = path_cache.back();
+            node_ptr grand_parent = path_cache.size() > 1 ? path_cache[path_cache.size() - 2] : nullptr;
+
+            if (is_left_child)
+            {
+                node_ptr sibling = parent->right;
+
+                if (is_red(sibling))
+                {
+                    // make the sibling black by rotating the parent down
+                    sibling->node_color = color::black;
+                    parent->node_color = color::red;
+                    replace_child(grand_parent, parent, rotate_left(parent));
+
+                    path_cache.back() = sibling;
+                    path_cache.push_back(parent);
+                    grand_parent = sibling;
+                    sibling = parent->right;
+                }
+
+                if (!is_red(sibling->left) && !is_red(sibling->right))
+                {
+                    // push the missing black up
+                    sibling->node_color = color::red;
+                    node = parent;
+                    path_cache.pop_back();
+                    is_left_child = grand_parent != nullptr && grand_parent->left == node;
+                    continue;
+                }
+
+                if (!is_red(sibling->right))
+                {
+                    sibling->left->node_color = color::black;
+                    sibling->node_color = color::red;
+                    parent->right = rotate_right(sibling);
+                    sibling = parent->right;
+                }
+
+                sibling->node_color = parent->node_color;
+                parent->node_color = color::black;
+                sibling->right->node_color = color::black;
+                replace_child(grand_parent, parent, rotate_left(parent));
+                return;
+            }
+            else
+            {
+                node_ptr sibling = parent->left;
+
+                if (is_red(sibling))
+                {
+                    // make the sibling black by rotating the parent down
+                    sibling->node_color = color::black;
+                    parent->node_color = color::red;
+                    replace_child(grand_parent, parent, rotate_right(parent));
+
+                    path_cache.back() = sibling;
+                    path_cache.push_back(parent);
+                    grand_parent = sibling;
+                    sibling = parent->left;
+                }
+
+                if (!is_red(sibling->left) && !is_red(sibling->right))
+                {
+                    // push the missing black up
+                    sibling->node_color = color::red;
+                    node = parent;
+                    path_cache.pop_back();
+                    is_left_child = grand_parent != nullptr && grand_parent->left == node;
+                    continue;
+                }
+
+                if (!is_red(sibling->left))
+                {
+                    sibling->right->node_color = color::black;
+                    sibling->node_color = color::red;
+                    parent->left = rotate_left(sibling);
+                    sibling = parent->left;
+                }
+
+                sibling->node_color = parent->node_color;
+                parent->node_color = color::black;
+                sibling->left->node_color = color::black;
+                replace_child(grand_parent, parent, rotate_right(parent));
+                return;
+            }
+        }
+
+        if (node != nullptr)
+        {
+            node->node_color = color::black;
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::node_ptr rb<Key, Compare>::rotate_right(node_ptr subtree) noexcept
+    {
+#if RB_TREE_DEBUG_ROTATIONS == 1
+        std::cerr << "right rotation on " << subtree->value << std::endl;
+#endif
+
+        node_ptr root = subtree->left;
+        subtree->left = root->right;
+        root->right = subtree;
+        return root;
+    }
+
+    template <typename Key, typename Compare>
+    typename rb<Key, Compare>::node_ptr rb<Key, Compare>::rotate_left(node_ptr subtree) noexcept
+    {
+#if RB_TREE_DEBUG_ROTATIONS == 1
+        std::cerr << "left rotation on " << subtree->value << std::endl;
+#endif
+
+        node_ptr root = subtree->right;
+        subtree->right = root->left;
+        root->left = subtree;
+        return root;
+    }
+
+    template <typename Key, typename Compare>
+    void rb<Key, Compare>::replace_child(node_ptr parent, node_ptr old_child, node_ptr new_child) noexcept
+    {
+        if (parent == nullptr)
+        {
+            head = new_child;
+        }
+        else if (parent->left == old_child)
+        {
+            parent->left = new_child;
+        }
+        else
+        {
+            parent->right = new_child;
+        }
+    }
+
+    template <typename Key, typename Compare>
+    bool rb<Key, Compare>::is_red(node_ptr node) noexcept
+    {
+        return node != nullptr && node->node_color == detail::color::red;
+    }
+
+    template <typename Key, typename Compare>
+    void rb<Key, Compare>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left);
+        destroy(subtree->right);
+        delete subtree;
+    }
+
+} // namespace tree
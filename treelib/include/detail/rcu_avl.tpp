@@ -0,0 +1,688 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::const_iterator::const_iterator()
+        : position{nullptr}
+    { }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::const_iterator::const_iterator(std::shared_ptr<guard_type> guard,
+                                                          NodeIterator<const node_type> position)
+        : guard{std::move(guard)}, position{std::move(position)}
+    { }
+
+    template <typename Key, typename Compare>
+    const Key& rcu_avl<Key, Compare>::const_iterator::operator * () const
+    {
+        return *position;
+    }
+
+    template <typename Key, typename Compare>
+    const Key* rcu_avl<Key, Compare>::const_iterator::operator -> () const
+    {
+        return &*position;
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator& rcu_avl<Key, Compare>::const_iterator::operator ++ ()
+    {
+        ++position;
+        if (position.get_ptr() == nullptr)
+        {
+            // the end, the version is no longer needed
+            guard.reset();
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::const_iterator::operator == (const const_iterator& other) const
+    {
+        // every end iterator has a null node on top
+        return position.get_ptr() == other.position.get_ptr();
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////
+    //   SNAPSHOT   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::snapshot::snapshot(const self_type* owner,
+                                              std::shared_ptr<guard_type> guard,
+                                              const node_type* root)
+        : owner{owner}, guard{std::move(guard)}, root{root}
+    { }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::snapshot::begin() const
+    {
+        if (root == nullptr)
+        {
+            return const_iterator();
+        }
+        return const_iterator(guard, NodeIterator<const node_type>(root));
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::snapshot::end() const
+    {
+        return const_iterator();
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::snapshot::find(const key_type& value) const
+    {
+        const node_type* node = owner->search(root, value);
+        if (node == nullptr)
+        {
+            return const_iterator();
+        }
+        return const_iterator(guard, NodeIterator<const node_type>(root, node));
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::snapshot::contains(const key_type& value) const
+    {
+        return owner->search(root, value) != nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::snapshot::empty() const noexcept
+    {
+        return root == nullptr;
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::rcu_avl() = default;
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::rcu_avl(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::rcu_avl(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::rcu_avl(const self_type& other)
+    {
+        // the keys come sorted, so the copy is built balanced in one go
+        const std::vector<key_type> keys(other.begin(), other.end());
+        int height = 0;
+        head.store(build(keys, 0, keys.size(), height), std::memory_order_release);
+        m_size.store(keys.size(), std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::rcu_avl(self_type&& other) noexcept
+    {
+        head.store(other.head.exchange(nullptr), std::memory_order_release);
+        m_size.store(other.m_size.exchange(0), std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>::~rcu_avl()
+    {
+        // nodes retired earlier are freed with the epoch domain
+        destroy(head.load(std::memory_order_acquire));
+    }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>& rcu_avl<Key, Compare>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            const std::vector<key_type> keys(other.begin(), other.end());
+            int height = 0;
+            destroy(head.exchange(build(keys, 0, keys.size(), height)));
+            m_size.store(keys.size(), std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    rcu_avl<Key, Compare>& rcu_avl<Key, Compare>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            node_ptr other_head = other.head.exchange(head.load());
+            head.store(other_head);
+
+            std::size_t other_size = other.m_size.exchange(m_size.load());
+            m_size.store(other_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::begin() const
+    {
+        return read().begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::end() const
+    {
+        return const_iterator();
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t rcu_avl<Key, Compare>::size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void rcu_avl<Key, Compare>::clear()
+    {
+        std::lock_guard lock(writer_mutex);
+
+        // every node of the old version is replaced
+        std::vector<node_ptr> stack;
+        if (head.load(std::memory_order_relaxed) != nullptr)
+        {
+            stack.push_back(head.load(std::memory_order_relaxed));
+        }
+        while (!stack.empty())
+        {
+            node_ptr node = stack.back();
+            stack.pop_back();
+            replaced.push_back(node);
+
+            if (node->left != nullptr)
+            {
+                stack.push_back(node->left);
+            }
+            if (node->right != nullptr)
+            {
+                stack.push_back(node->right);
+            }
+        }
+
+        publish(nullptr);
+        m_size.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::insert(key_type key)
+    {
+        std::lock_guard lock(writer_mutex);
+
+        bool grew = false;
+        node_ptr root = insert_copy(head.load(std::memory_order_relaxed), key, grew);
+        if (root == nullptr)
+        {
+            return false;
+        }
+
+        publish(root);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::erase(const key_type& key)
+    {
+        std::lock_guard lock(writer_mutex);
+
+        bool shrank = false;
+        bool found = false;
+        node_ptr root = erase_copy(head.load(std::memory_order_relaxed), key, shrank, found);
+        if (!found)
+        {
+            return false;
+        }
+
+        publish(root);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::snapshot rcu_avl<Key, Compare>::read() const
+    {
+        auto guard = std::make_shared<guard_type>(epochs.pin());
+        return snapshot(this, std::move(guard), head.load(std::memory_order_acquire));
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::const_iterator rcu_avl<Key, Compare>::find(const key_type& value) const
+    {
+        return read().find(value);
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::contains(const key_type& value) const
+    {
+        guard_type guard = epochs.pin();
+        return search(head.load(std::memory_order_acquire), value) != nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    bool rcu_avl<Key, Compare>::is_avl() const
+    {
+        guard_type guard = epochs.pin();
+        return check(head.load(std::memory_order_acquire), nullptr, nullptr) >= 0;
+    }
+
+    //////////////////////
+    //   PATH COPYING   //
+    //////////////////////
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr
+    rcu_avl<Key, Compare>::insert_copy(node_ptr subtree, key_type& key, bool& grew)
+    {
+        if (subtree == nullptr)
+        {
+            grew = true;
+            return new node_type(std::move(key));
+        }
+
+        bool is_left = true;
+        if (key_cmp(key, subtree->value))
+        {
+            is_left = true;
+        }
+        else if (key_cmp(subtree->value, key))
+        {
+            is_left = false;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        node_ptr child = insert_copy(is_left ? subtree->left : subtree->right, key, grew);
+        if (child == nullptr)
+        {
+            return nullptr;
+        }
+
+        node_ptr copy = clone(subtree);
+        (is_left ? copy->left : copy->right) = child;
+        if (!grew)
+        {
+            return copy;
+        }
+
+        copy->balance = is_left ? detail::shift_left(copy->balance) : detail::shift_right(copy->balance);
+        switch (copy->balance)
+        {
+            case detail::balance_factor::zero:
+                grew = false;
+                return copy;
+            case detail::balance_factor::lhs_1:
+            case detail::balance_factor::rhs_1:
+                return copy;
+            default:
+            {
+                // the heavy child and its inner child are on the path, so both are copies already
+                bool shrank = false;
+                grew = false;
+                return rotate(copy, shrank);
+            }
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr
+    rcu_avl<Key, Compare>::erase_copy(node_ptr subtree, const key_type& key, bool& shrank, bool& found)
+    {
+        if (subtree == nullptr)
+        {
+            found = false;
+            return nullptr;
+        }
+
+        if (key_cmp(key, subtree->value) || key_cmp(subtree->value, key))
+        {
+            const bool is_left = key_cmp(key, subtree->value);
+            node_ptr child = erase_copy(is_left ? subtree->left : subtree->right, key, shrank, found);
+            if (!found)
+            {
+                return subtree;
+            }
+
+            node_ptr copy = clone(subtree);
+            (is_left ? copy->left : copy->right) = child;
+            if (!shrank)
+            {
+                return copy;
+            }
+
+            copy->balance = is_left ? detail::shift_right(copy->balance) : detail::shift_left(copy->balance);
+            return fix_after_erase(copy, shrank);
+        }
+
+        found = true;
+        if (subtree->left == nullptr || subtree->right == nullptr)
+        {
+            replaced.push_back(subtree);
+            shrank = true;
+            return subtree->left != nullptr ? subtree->left : subtree->right;
+        }
+
+        // two children: the successor takes the place of the key
+        node_ptr min_node = nullptr;
+        node_ptr right = erase_min_copy(subtree->right, shrank, min_node);
+
+        node_ptr copy = clone(subtree);
+        copy->value = min_node->value;
+        copy->right = right;
+        if (!shrank)
+        {
+            return copy;
+        }
+
+        copy->balance = detail::shift_left(copy->balance);
+        return fix_after_erase(copy, shrank);
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr
+    rcu_avl<Key, Compare>::erase_min_copy(node_ptr subtree, bool& shrank, node_ptr& min_node)
+    {
+        if (subtree->left == nullptr)
+        {
+            // retired only after the publish, so its key can still be read
+            min_node = subtree;
+            replaced.push_back(subtree);
+            shrank = true;
+            return subtree->right;
+        }
+
+        node_ptr child = erase_min_copy(subtree->left, shrank, min_node);
+        node_ptr copy = clone(subtree);
+        copy->left = child;
+        if (!shrank)
+        {
+            return copy;
+        }
+
+        copy->balance = detail::shift_right(copy->balance);
+        return fix_after_erase(copy, shrank);
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr rcu_avl<Key, Compare>::fix_after_erase(node_ptr subtree, bool& shrank)
+    {
+        switch (subtree->balance)
+        {
+            case detail::balance_factor::zero:
+                // the longer side lost a level
+                shrank = true;
+                return subtree;
+            case detail::balance_factor::lhs_1:
+            case detail::balance_factor::rhs_1:
+                shrank = false;
+                return subtree;
+            default:
+                break;
+        }
+
+        // the heavy side is off the path and still shared with the published version
+        const bool is_left_heavy = subtree->balance == detail::balance_factor::lhs_2;
+        node_ptr& heavy = is_left_heavy ? subtree->left : subtree->right;
+        heavy = clone(heavy);
+
+        const bool is_double = heavy->balance == (is_left_heavy ? detail::balance_factor::rhs_1
+                                                                : detail::balance_factor::lhs_1);
+        if (is_double)
+        {
+            node_ptr& inner = is_left_heavy ? heavy->right : heavy->left;
+            inner = clone(inner);
+        }
+
+        return rotate(subtree, shrank);
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr rcu_avl<Key, Compare>::rotate(node_ptr subtree, bool& shrank) noexcept
+    {
+        using detail::balance_factor;
+
+        const bool is_left_heavy = subtree->balance == balance_factor::lhs_2;
+        node_ptr heavy = is_left_heavy ? subtree->left : subtree->right;
+        const balance_factor outer = is_left_heavy ? balance_factor::lhs_1 : balance_factor::rhs_1;
+        const balance_factor inner = is_left_heavy ? balance_factor::rhs_1 : balance_factor::lhs_1;
+
+        if (heavy->balance == inner)
+        {
+            // double rotation, the inner grandchild becomes the root
+            node_ptr middle = is_left_heavy ? heavy->right : heavy->left;
+            if (is_left_heavy)
+            {
+                heavy->right = middle->left;
+                subtree->left = middle->right;
+                middle->left = heavy;
+                middle->right = subtree;
+            }
+            else
+            {
+                heavy->left = middle->right;
+                subtree->right = middle->left;
+                middle->right = heavy;
+                middle->left = subtree;
+            }
+
+            // each side keeps the grandchild subtree that was on it, the lower one gets the lean
+            heavy->balance = middle->balance == inner ? outer : balance_factor::zero;
+            subtree->balance = middle->balance == outer ? inner : balance_factor::zero;
+            middle->balance = balance_factor::zero;
+
+            shrank = true;
+            return middle;
+        }
+
+        // single rotation
+        if (is_left_heavy)
+        {
+            subtree->left = heavy->right;
+            heavy->right = subtree;
+        }
+        else
+        {
+            subtree->right = heavy->left;
+            heavy->left = subtree;
+        }
+
+        if (heavy->balance == outer)
+        {
+            subtree->balance = balance_factor::zero;
+            heavy->balance = balance_factor::zero;
+            shrank = true;
+        }
+        else
+        {
+            // only after an erase: the heavy child was balanced and the height stays
+            subtree->balance = outer;
+            heavy->balance = inner;
+            shrank = false;
+        }
+        return heavy;
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr rcu_avl<Key, Compare>::clone(node_ptr node)
+    {
+        replaced.push_back(node);
+        return new node_type(*node);
+    }
+
+    template <typename Key, typename Compare>
+    void rcu_avl<Key, Compare>::publish(node_ptr root)
+    {
+        // the copies are complete before readers can reach them
+        head.store(root, std::memory_order_release);
+
+        guard_type guard = epochs.pin();
+        for (const auto& node : replaced)
+        {
+            guard.retire(node, &destroy_node);
+        }
+        replaced.clear();
+    }
+
+    template <typename Key, typename Compare>
+    typename rcu_avl<Key, Compare>::node_ptr
+    rcu_avl<Key, Compare>::build(const std::vector<key_type>& keys, std::size_t first, std::size_t last, int& height)
+    {
+        if (first == last)
+        {
+            height = 0;
+            return nullptr;
+        }
+
+        const std::size_t middle = first + (last - first) / 2;
+        int lhs_height = 0;
+        int rhs_height = 0;
+
+        auto node = new node_type(keys[middle]);
+        node->left = build(keys, first, middle, lhs_height);
+        node->right = build(keys, middle + 1, last, rhs_height);
+        node->balance = static_cast<detail::balance_factor>(rhs_height - lhs_height);
+
+        height = std::max(lhs_height, rhs_height) + 1;
+        return node;
+    }
+
+    template <typename Key, typename Compare>
+    int rcu_avl<Key, Compare>::check(const node_type* subtree, const key_type* lower, const key_type* upper) const
+    {
+        if (subtree == nullptr)
+        {
+            return 0;
+        }
+
+        const key_type& key = subtree->value;
+        if ((lower != nullptr && !key_cmp(*lower, key)) || (upper != nullptr && !key_cmp(key, *upper)))
+        {
+            return -1;
+        }
+
+        const int lhs_height = check(subtree->left, lower, &key);
+        const int rhs_height = check(subtree->right, &key, upper);
+        if (lhs_height < 0 || rhs_height < 0)
+        {
+            return -1;
+        }
+
+        if (rhs_height - lhs_height != static_cast<int>(subtree->balance) || std::abs(rhs_height - lhs_height) > 1)
+        {
+            return -1;
+        }
+        return std::max(lhs_height, rhs_height) + 1;
+    }
+
+    template <typename Key, typename Compare>
+    const typename rcu_avl<Key, Compare>::node_type*
+    rcu_avl<Key, Compare>::search(const node_type* root, const key_type& value) const
+    {
+        const node_type* current = root;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return current;
+    }
+
+    template <typename Key, typename Compare>
+    void rcu_avl<Key, Compare>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left);
+        destroy(subtree->right);
+        delete subtree;
+    }
+
+    template <typename Key, typename Compare>
+    void rcu_avl<Key, Compare>::destroy_node(void* node) noexcept
+    {
+        delete static_cast<node_ptr>(node);
+    }
+
+} // namespace tree
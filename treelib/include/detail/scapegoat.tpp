@@ -0,0 +1,504 @@
+#pragma once
+
+#include <iostream>
+#include <algorithm>
+
+namespace tree
+{
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>::scapegoat() = default;
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>::scapegoat(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>::scapegoat(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>::scapegoat(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>::scapegoat(self_type&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+        std::swap(this->m_size, other.m_size);
+        std::swap(this->max_size, other.max_size);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>::~scapegoat()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>& scapegoat<Key, Compare, Alpha>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    scapegoat<Key, Compare, Alpha>& scapegoat<Key, Compare, Alpha>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+            std::swap(this->m_size, other.m_size);
+            std::swap(this->max_size, other.max_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::iterator scapegoat<Key, Compare, Alpha>::begin()
+    {
+        return iterator(head);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::const_iterator scapegoat<Key, Compare, Alpha>::begin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::const_iterator scapegoat<Key, Compare, Alpha>::cbegin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::iterator scapegoat<Key, Compare, Alpha>::end()
+    {
+        return iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::const_iterator scapegoat<Key, Compare, Alpha>::end() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::const_iterator scapegoat<Key, Compare, Alpha>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare, typename Alpha>
+    bool scapegoat<Key, Compare, Alpha>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    std::size_t scapegoat<Key, Compare, Alpha>::size() const noexcept
+    {
+        return m_size;
+    }
+
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare, typename Alpha>
+    void scapegoat<Key, Compare, Alpha>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+        m_size = 0;
+        max_size = 0;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::node_ptr scapegoat<Key, Compare, Alpha>::insert(key_type key)
+    {
+        path_cache.clear();
+
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            path_cache.push_back(current);
+
+            if (key_cmp(key, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                current = current->right;
+            }
+            else
+            {
+                return current;
+            }
+        }
+
+        auto child = new node_type(std::move(key));
+        if (path_cache.empty())
+        {
+            head = child;
+        }
+        else
+        {
+            node_ptr parent = path_cache.back();
+            if (key_cmp(child->value, parent->value))
+            {
+                parent->left = child;
+            }
+            else
+            {
+                parent->right = child;
+            }
+        }
+
+        m_size++;
+        max_size = std::max(max_size, m_size);
+
+        if (path_cache.size() > max_depth(m_size))
+        {
+            // the new node is too deep, so one of its ancestors holds more than
+            // Alpha of its subtree on the side of the node: that one is the scapegoat
+            node_ptr node = child;
+            std::size_t node_size = 1;
+
+            for (std::size_t depth = path_cache.size(); depth-- > 0; )
+            {
+                node_ptr parent = path_cache[depth];
+                node_ptr sibling = parent->left == node ? parent->right : parent->left;
+                const std::size_t parent_size = node_size + 1 + subtree_size(sibling);
+
+                if (node_size * alpha::den > alpha::num * parent_size)
+                {
+#if SCAPEGOAT_TREE_DEBUG_REBUILDS == 1
+                    std::cerr << "rebuild of " << parent_size << " nodes on " << parent->value << std::endl;
+#endif
+                    rebuild(link_to(depth), parent_size);
+                    break;
+                }
+
+                node = parent;
+                node_size = parent_size;
+            }
+        }
+
+        return child;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    void scapegoat<Key, Compare, Alpha>::erase(const key_type& key)
+    {
+        // link is the pointer to the current node in its parent (or the head)
+        node_ptr* link = &head;
+        while (*link != nullptr)
+        {
+            if (key_cmp(key, (*link)->value))
+            {
+                link = &(*link)->left;
+            }
+            else if (key_cmp((*link)->value, key))
+            {
+                link = &(*link)->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        node_ptr node = *link;
+        if (node == nullptr)
+        {   // no such key found
+            return;
+        }
+
+        if (node->left != nullptr && node->right != nullptr)
+        {
+            // the in-order successor takes the place of the node
+            node_ptr* next_link = &node->right;
+            while ((*next_link)->left != nullptr)
+            {
+                next_link = &(*next_link)->left;
+            }
+
+            node_ptr next = *next_link;
+            *next_link = next->right;
+
+            next->left = node->left;
+            next->right = node->right;
+            *link = next;
+        }
+        else
+        {
+            *link = node->left != nullptr ? node->left : node->right;
+        }
+
+        delete node;
+        m_size--;
+
+        if (m_size * alpha::den < alpha::num * max_size)
+        {
+#if SCAPEGOAT_TREE_DEBUG_REBUILDS == 1
+            std::cerr << "full rebuild of " << m_size << " nodes" << std::endl;
+#endif
+            rebuild(head, m_size);
+            max_size = m_size;
+        }
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::iterator scapegoat<Key, Compare, Alpha>::find(const key_type& value)
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return iterator(head, current);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::const_iterator scapegoat<Key, Compare, Alpha>::find(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return const_iterator(head, current);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    static_set<Key, Compare> scapegoat<Key, Compare, Alpha>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    [[nodiscard]] bool scapegoat<Key, Compare, Alpha>::is_ordered(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return true;
+        }
+
+        const key_type& key = subtree->value;
+
+        node_ptr subtree_lhs = subtree->left;
+        bool is_lhs_ordered =
+                subtree_lhs == nullptr ||
+                (key_cmp(subtree_lhs->value, key) && is_ordered(subtree_lhs));
+
+        node_ptr subtree_rhs = subtree->right;
+        bool is_rhs_ordered =
+                subtree_rhs == nullptr ||
+                (key_cmp(key, subtree_rhs->value) && is_ordered(subtree_rhs));
+
+        return is_lhs_ordered && is_rhs_ordered;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    [[nodiscard]] bool scapegoat<Key, Compare, Alpha>::is_scapegoat() const noexcept
+    {
+        if (head == nullptr)
+        {
+            return m_size == 0;
+        }
+
+        // height counts the nodes on the longest path, depth counts the edges
+        return is_ordered(head) &&
+               subtree_size(head) == m_size &&
+               height(head) <= max_depth(max_size) + 1;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    std::size_t scapegoat<Key, Compare, Alpha>::height(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return 0;
+        }
+
+        return 1 + std::max(height(subtree->left), height(subtree->right));
+    }
+
+    ///////////////////
+    //   BALANCING   //
+    ///////////////////
+
+    template <typename Key, typename Compare, typename Alpha>
+    std::size_t scapegoat<Key, Compare, Alpha>::max_depth(std::size_t size) noexcept
+    {
+        static const double log_inverse_alpha =
+                std::log(static_cast<double>(alpha::den) / static_cast<double>(alpha::num));
+
+        if (size <= 1)
+        {
+            return 0;
+        }
+
+        return static_cast<std::size_t>(std::log(static_cast<double>(size)) / log_inverse_alpha);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    void scapegoat<Key, Compare, Alpha>::rebuild(node_ptr& link, std::size_t size) noexcept
+    {
+        if (size < 3)
+        {
+            return;
+        }
+
+        flatten(link);
+
+        // the largest perfect tree that fits, the rest goes to its bottom level
+        std::size_t perfect_size = 1;
+        while (2 * perfect_size + 1 <= size)
+        {
+            perfect_size = 2 * perfect_size + 1;
+        }
+
+        compress(link, size - perfect_size);
+        for (std::size_t count = perfect_size / 2; count > 0; count /= 2)
+        {
+            compress(link, count);
+        }
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    void scapegoat<Key, Compare, Alpha>::flatten(node_ptr& link) noexcept
+    {
+        node_ptr* scanner = &link;
+        while (*scanner != nullptr)
+        {
+            node_ptr node = *scanner;
+            if (node->left != nullptr)
+            {
+                // rotate right, the left child moves onto the vine
+                node_ptr child = node->left;
+                node->left = child->right;
+                child->right = node;
+                *scanner = child;
+            }
+            else
+            {
+                scanner = &node->right;
+            }
+        }
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    void scapegoat<Key, Compare, Alpha>::compress(node_ptr& link, std::size_t count) noexcept
+    {
+        node_ptr* scanner = &link;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            // rotate left, every other node of the vine goes down to the left
+            node_ptr node = *scanner;
+            node_ptr child = node->right;
+            node->right = child->left;
+            child->left = node;
+            *scanner = child;
+            scanner = &child->right;
+        }
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    std::size_t scapegoat<Key, Compare, Alpha>::subtree_size(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return 0;
+        }
+
+        return 1 + subtree_size(subtree->left) + subtree_size(subtree->right);
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    typename scapegoat<Key, Compare, Alpha>::node_ptr& scapegoat<Key, Compare, Alpha>::link_to(std::size_t depth) noexcept
+    {
+        if (depth == 0)
+        {
+            return head;
+        }
+
+        node_ptr parent = path_cache[depth - 1];
+        return parent->left == path_cache[depth] ? parent->left : parent->right;
+    }
+
+    template <typename Key, typename Compare, typename Alpha>
+    void scapegoat<Key, Compare, Alpha>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left);
+        destroy(subtree->right);
+        delete subtree;
+    }
+
+} // namespace tree
@@ -0,0 +1,266 @@
+#pragma once
+
+namespace tree
+{
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Tree>
+    seqlocked<Tree>::seqlocked()
+    {
+        tree.pool = &pool;
+    }
+
+    template <typename Tree>
+    seqlocked<Tree>::seqlocked(const std::initializer_list<key_type>& data) : seqlocked()
+    {
+        for (const auto& element : data)
+        {
+            tree.insert(element);
+        }
+        m_size.store(tree.size(), std::memory_order_relaxed);
+    }
+
+    template <typename Tree>
+    seqlocked<Tree>::seqlocked(std::initializer_list<key_type>&& data) : seqlocked()
+    {
+        for (auto&& element : data)
+        {
+            tree.insert(std::move(element));
+        }
+        m_size.store(tree.size(), std::memory_order_relaxed);
+    }
+
+    template <typename Tree>
+    seqlocked<Tree>::write_guard::write_guard(std::atomic<std::uint64_t>& sequence) noexcept
+        : sequence{sequence}
+    {
+        // the writer is the only one to change the counter
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // keeps the changes to the tree after the odd counter
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    template <typename Tree>
+    seqlocked<Tree>::write_guard::~write_guard()
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Tree>
+    bool seqlocked<Tree>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Tree>
+    std::size_t seqlocked<Tree>::size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Tree>
+    void seqlocked<Tree>::clear()
+    {
+        std::lock_guard lock(writer_mutex);
+        {
+            write_guard guard(sequence);
+            tree.clear();
+        }
+        m_size.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename Tree>
+    bool seqlocked<Tree>::insert(key_type key)
+    {
+        std::lock_guard lock(writer_mutex);
+
+        // the writer's own lookups need no counter, and a key that is there
+        // changes nothing the readers would have to retry for
+        const tree_type& current = tree;
+        if (current.find(key) != current.end())
+        {
+            return false;
+        }
+
+        // fresh storage is zeroed before the change, not while readers walk into it
+        pool.reserve(1);
+        {
+            write_guard guard(sequence);
+            tree.insert(std::move(key));
+        }
+        m_size.store(tree.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    template <typename Tree>
+    bool seqlocked<Tree>::erase(const key_type& key)
+    {
+        std::lock_guard lock(writer_mutex);
+
+        const tree_type& current = tree;
+        if (current.find(key) == current.end())
+        {
+            return false;
+        }
+
+        {
+            write_guard guard(sequence);
+            tree.erase(key);
+        }
+        m_size.store(tree.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Tree>
+    std::optional<typename Tree::key_type> seqlocked<Tree>::find(const key_type& value) const
+    {
+        auto bound = lower_bound(value);
+        if (bound.has_value() && key_cmp(value, *bound))
+        {
+            return std::nullopt;
+        }
+        return bound;
+    }
+
+    template <typename Tree>
+    std::optional<typename Tree::key_type> seqlocked<Tree>::lower_bound(const key_type& value) const
+    {
+        while (true)
+        {
+            const std::uint64_t start = read_begin();
+
+            std::optional<key_type> bound;
+            if (attempt_lower_bound(value, start, bound) && read_validate(start))
+            {
+                return bound;
+            }
+        }
+    }
+
+    template <typename Tree>
+    bool seqlocked<Tree>::contains(const key_type& value) const
+    {
+        return find(value).has_value();
+    }
+
+    template <typename Tree>
+    std::vector<typename Tree::key_type> seqlocked<Tree>::keys() const
+    {
+        std::vector<key_type> result;
+        while (true)
+        {
+            const std::uint64_t start = read_begin();
+
+            result.clear();
+            if (attempt_keys(start, result) && read_validate(start))
+            {
+                return result;
+            }
+        }
+    }
+
+    /////////////////
+    //   READING   //
+    /////////////////
+
+    template <typename Tree>
+    std::uint64_t seqlocked<Tree>::read_begin() const noexcept
+    {
+        std::uint64_t start = sequence.load(std::memory_order_acquire);
+        for (unsigned spin = 0; start % 2 != 0; spin++)
+        {
+            // the writer may be waiting for the core this reader spins on
+            if (spin >= 64)
+            {
+                std::this_thread::yield();
+            }
+            start = sequence.load(std::memory_order_acquire);
+        }
+        return start;
+    }
+
+    template <typename Tree>
+    bool seqlocked<Tree>::read_validate(std::uint64_t start) const noexcept
+    {
+        // keeps the reads of the tree before the second read of the counter
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == start;
+    }
+
+    template <typename Tree>
+    bool seqlocked<Tree>::attempt_lower_bound(const key_type& value, std::uint64_t start,
+                                              std::optional<key_type>& bound) const
+    {
+        node_ptr node = detail::load_racy(tree.head);
+        for (std::size_t steps = 1; node != nullptr; steps++)
+        {
+            if (steps % check_interval == 0 && !read_validate(start))
+            {
+                return false;
+            }
+
+            // one copy, so both comparisons see the same key
+            const key_type current = node->value;
+            if (key_cmp(current, value))
+            {
+                node = detail::load_racy(node->right);
+            }
+            else
+            {
+                bound = current;
+                if (!key_cmp(value, current))
+                {
+                    break;
+                }
+                node = detail::load_racy(node->left);
+            }
+        }
+        return true;
+    }
+
+    template <typename Tree>
+    bool seqlocked<Tree>::attempt_keys(std::uint64_t start, std::vector<key_type>& result) const
+    {
+        std::vector<node_ptr> stack;
+        node_ptr node = detail::load_racy(tree.head);
+
+        for (std::size_t steps = 1; node != nullptr || !stack.empty(); steps++)
+        {
+            if (steps % check_interval == 0 && !read_validate(start))
+            {
+                return false;
+            }
+
+            if (node != nullptr)
+            {
+                stack.push_back(node);
+                node = detail::load_racy(node->left);
+            }
+            else
+            {
+                node = stack.back();
+                stack.pop_back();
+
+                result.push_back(node->value);
+                node = detail::load_racy(node->right);
+            }
+        }
+        return true;
+    }
+
+} // namespace tree
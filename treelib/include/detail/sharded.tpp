@@ -0,0 +1,479 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Tree, std::size_t Shards>
+    sharded<Tree, Shards>::const_iterator::const_iterator(const self_type* owner, std::vector<key_type> chunk,
+                                                          std::size_t next_shard, std::uint64_t version)
+        : owner{chunk.empty() ? nullptr : owner},
+          chunk{std::move(chunk)},
+          next_shard{next_shard},
+          version{version}
+    { }
+
+    template <typename Tree, std::size_t Shards>
+    const typename sharded<Tree, Shards>::key_type& sharded<Tree, Shards>::const_iterator::operator * () const
+    {
+        return chunk[position];
+    }
+
+    template <typename Tree, std::size_t Shards>
+    const typename sharded<Tree, Shards>::key_type* sharded<Tree, Shards>::const_iterator::operator -> () const
+    {
+        return &chunk[position];
+    }
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator& sharded<Tree, Shards>::const_iterator::operator ++ ()
+    {
+        position++;
+        if (position == chunk.size())
+        {
+            auto next = owner->next_chunk(&chunk.back(), next_shard, version);
+            if (next.empty())
+            {
+                *this = const_iterator();
+            }
+            else
+            {
+                chunk = std::move(next);
+                position = 0;
+            }
+        }
+        return *this;
+    }
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator sharded<Tree, Shards>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::const_iterator::operator == (const const_iterator& other) const
+    {
+        if (owner != other.owner)
+        {
+            return false;
+        }
+        return owner == nullptr ||
+               (!owner->key_cmp(**this, *other) && !owner->key_cmp(*other, **this));
+    }
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Tree, std::size_t Shards>
+    sharded<Tree, Shards>::sharded()
+    {
+        auto initial = new boundaries();
+        initial->version = 1;
+        current_boundaries.store(initial, std::memory_order_release);
+    }
+
+    template <typename Tree, std::size_t Shards>
+    sharded<Tree, Shards>::sharded(const std::initializer_list<key_type>& data)
+        : sharded()
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Tree, std::size_t Shards>
+    sharded<Tree, Shards>::sharded(std::initializer_list<key_type>&& data)
+        : sharded()
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Tree, std::size_t Shards>
+    sharded<Tree, Shards>::~sharded()
+    {
+        // boundaries replaced earlier were retired and are freed with the epoch domain
+        delete current_boundaries.load(std::memory_order_acquire);
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator sharded<Tree, Shards>::begin() const
+    {
+        std::size_t next_shard = 0;
+        std::uint64_t version = 0;
+        auto chunk = next_chunk(nullptr, next_shard, version);
+        return const_iterator(this, std::move(chunk), next_shard, version);
+    }
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator sharded<Tree, Shards>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator sharded<Tree, Shards>::end() const
+    {
+        return const_iterator();
+    }
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator sharded<Tree, Shards>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template <typename Tree, std::size_t Shards>
+    std::size_t sharded<Tree, Shards>::size() const
+    {
+        std::size_t total = 0;
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            total += shard_size(index);
+        }
+        return total;
+    }
+
+    template <typename Tree, std::size_t Shards>
+    std::size_t sharded<Tree, Shards>::shard_size(std::size_t index) const
+    {
+        std::lock_guard lock(shards[index].mutex);
+        return shards[index].tree.size();
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Tree, std::size_t Shards>
+    void sharded<Tree, Shards>::clear()
+    {
+        std::lock_guard rebalance_lock(rebalance_mutex);
+        std::array<std::unique_lock<std::mutex>, Shards> locks;
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            locks[index] = std::unique_lock(shards[index].mutex);
+            shards[index].tree.clear();
+        }
+
+        auto fresh = new boundaries();
+        fresh->version = current_boundaries.load(std::memory_order_relaxed)->version + 1;
+        publish(fresh);
+        split_threshold.store(2 * min_shard_size, std::memory_order_relaxed);
+    }
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::insert(key_type key)
+    {
+        bool is_overfull = false;
+        const bool is_inserted = with_shard(key, [&](tree_type& tree, std::size_t, std::uint64_t)
+        {
+            const std::size_t size_before = tree.size();
+            tree.insert(std::move(key));
+            is_overfull = tree.size() > split_threshold.load(std::memory_order_relaxed);
+            return tree.size() != size_before;
+        });
+
+        // the shard lock is released by now, rebalance takes all of them in order
+        if (is_inserted && is_overfull)
+        {
+            try_rebalance();
+        }
+        return is_inserted;
+    }
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::erase(const key_type& key)
+    {
+        return with_shard(key, [&](tree_type& tree, std::size_t, std::uint64_t)
+        {
+            const std::size_t size_before = tree.size();
+            tree.erase(key);
+            return tree.size() != size_before;
+        });
+    }
+
+    template <typename Tree, std::size_t Shards>
+    void sharded<Tree, Shards>::rebalance()
+    {
+        std::lock_guard rebalance_lock(rebalance_mutex);
+        std::array<std::unique_lock<std::mutex>, Shards> locks;
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            locks[index] = std::unique_lock(shards[index].mutex);
+        }
+
+        rebalance_locked();
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Tree, std::size_t Shards>
+    typename sharded<Tree, Shards>::const_iterator sharded<Tree, Shards>::find(const key_type& value) const
+    {
+        std::vector<key_type> chunk;
+        std::size_t next_shard = 0;
+        std::uint64_t version = 0;
+        with_shard(value, [&](tree_type& tree, std::size_t index, std::uint64_t current_version)
+        {
+            if (tree.find(value) != tree.end())
+            {
+                chunk.push_back(value);
+            }
+            // the keys after it in the same shard come next
+            next_shard = index;
+            version = current_version;
+        });
+
+        return const_iterator(this, std::move(chunk), next_shard, version);
+    }
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::contains(const key_type& value) const
+    {
+        return with_shard(value, [&](tree_type& tree, std::size_t, std::uint64_t)
+        {
+            return tree.find(value) != tree.end();
+        });
+    }
+
+    template <typename Tree, std::size_t Shards>
+    bool sharded<Tree, Shards>::is_sharded() const
+    {
+        const boundaries* current = current_boundaries.load(std::memory_order_acquire);
+        if (!std::is_sorted(current->keys.begin(), current->keys.end(), key_cmp))
+        {
+            return false;
+        }
+
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            const key_type* previous = nullptr;
+            for (const auto& key : shards[index].tree)
+            {
+                if (shard_of(*current, key) != index)
+                {
+                    return false;
+                }
+                if (previous != nullptr && !key_cmp(*previous, key))
+                {
+                    return false;
+                }
+                previous = &key;
+            }
+        }
+        return true;
+    }
+
+    /////////////////
+    //   HELPERS   //
+    /////////////////
+
+    template <typename Tree, std::size_t Shards>
+    template <typename Operation>
+    decltype(auto) sharded<Tree, Shards>::with_shard(const key_type& key, Operation operation) const
+    {
+        while (true)
+        {
+            // pinned, so the boundaries read here are not freed under us
+            guard_type guard = epochs.pin();
+            const boundaries* current = current_boundaries.load(std::memory_order_acquire);
+            const std::size_t index = shard_of(*current, key);
+
+            std::lock_guard lock(shards[index].mutex);
+
+            // the boundaries only change while every shard is locked
+            if (current_boundaries.load(std::memory_order_acquire) == current)
+            {
+                return operation(shards[index].tree, index, current->version);
+            }
+        }
+    }
+
+    template <typename Tree, std::size_t Shards>
+    std::size_t sharded<Tree, Shards>::shard_of(const boundaries& current, const key_type& key) const
+    {
+        const auto it = std::upper_bound(current.keys.begin(), current.keys.end(), key, key_cmp);
+        return static_cast<std::size_t>(it - current.keys.begin());
+    }
+
+    template <typename Tree, std::size_t Shards>
+    std::vector<typename sharded<Tree, Shards>::key_type>
+    sharded<Tree, Shards>::next_chunk(const key_type* after, std::size_t& next_shard, std::uint64_t& version) const
+    {
+        std::vector<key_type> chunk;
+        while (true)
+        {
+            guard_type guard = epochs.pin();
+            const boundaries* current = current_boundaries.load(std::memory_order_acquire);
+            if (current->version != version)
+            {
+                // the boundaries moved since the last chunk, look the last key up again
+                next_shard = after != nullptr ? shard_of(*current, *after) : 0;
+                version = current->version;
+            }
+
+            if (next_shard >= Shards)
+            {
+                return chunk;
+            }
+
+            {
+                std::lock_guard lock(shards[next_shard].mutex);
+                if (current_boundaries.load(std::memory_order_acquire) != current)
+                {
+                    continue;
+                }
+
+                for (const auto& key : shards[next_shard].tree)
+                {
+                    if (after == nullptr || key_cmp(*after, key))
+                    {
+                        chunk.push_back(key);
+                    }
+                }
+            }
+
+            next_shard++;
+            if (!chunk.empty())
+            {
+                return chunk;
+            }
+        }
+    }
+
+    template <typename Tree, std::size_t Shards>
+    void sharded<Tree, Shards>::try_rebalance()
+    {
+        std::unique_lock rebalance_lock(rebalance_mutex, std::try_to_lock);
+        if (!rebalance_lock.owns_lock())
+        {
+            return;
+        }
+
+        std::array<std::unique_lock<std::mutex>, Shards> locks;
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            locks[index] = std::unique_lock(shards[index].mutex);
+        }
+
+        // another thread may have rebalanced since the insert saw its shard overfull
+        const std::size_t threshold = split_threshold.load(std::memory_order_relaxed);
+        for (const auto& current : shards)
+        {
+            if (current.tree.size() > threshold)
+            {
+                rebalance_locked();
+                return;
+            }
+        }
+    }
+
+    template <typename Tree, std::size_t Shards>
+    void sharded<Tree, Shards>::rebalance_locked()
+    {
+        // the shards hold consecutive key ranges, so their keys one after another are sorted
+        std::vector<key_type> keys;
+        std::array<std::size_t, Shards + 1> old_offsets = { };
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            old_offsets[index] = keys.size();
+            for (const auto& key : shards[index].tree)
+            {
+                keys.push_back(key);
+            }
+        }
+        old_offsets[Shards] = keys.size();
+
+        // shard i gets the keys from i * count / Shards on, with fewer keys than shards
+        // some boundaries repeat and the shards between them stay empty
+        const std::size_t count = keys.size();
+        std::array<std::size_t, Shards + 1> offsets = { };
+        for (std::size_t index = 0; index <= Shards; index++)
+        {
+            offsets[index] = index * count / Shards;
+        }
+
+        auto fresh = new boundaries();
+        fresh->version = current_boundaries.load(std::memory_order_relaxed)->version + 1;
+        if (count > 0)
+        {
+            fresh->keys.reserve(Shards - 1);
+            for (std::size_t index = 1; index < Shards; index++)
+            {
+                fresh->keys.push_back(keys[offsets[index]]);
+            }
+        }
+
+        // only the shards whose range changed are refilled
+        for (std::size_t index = 0; index < Shards; index++)
+        {
+            if (offsets[index] == old_offsets[index] && offsets[index + 1] == old_offsets[index + 1])
+            {
+                continue;
+            }
+
+            // in random order: sorted inserts would leave a splay shard as a path
+            const auto first = keys.begin() + static_cast<std::ptrdiff_t>(offsets[index]);
+            const auto last = keys.begin() + static_cast<std::ptrdiff_t>(offsets[index + 1]);
+            std::shuffle(first, last, gen);
+
+            auto& tree = shards[index].tree;
+            tree.clear();
+            for (auto it = first; it != last; ++it)
+            {
+                tree.insert(*it);
+            }
+        }
+
+        split_threshold.store(2 * std::max(count / Shards, min_shard_size), std::memory_order_relaxed);
+        publish(fresh);
+    }
+
+    template <typename Tree, std::size_t Shards>
+    void sharded<Tree, Shards>::publish(boundaries* fresh)
+    {
+        const boundaries* old = current_boundaries.exchange(fresh, std::memory_order_acq_rel);
+
+        guard_type guard = epochs.pin();
+        guard.retire(const_cast<boundaries*>(old), &destroy_boundaries);
+    }
+
+    template <typename Tree, std::size_t Shards>
+    void sharded<Tree, Shards>::destroy_boundaries(void* pointer) noexcept
+    {
+        delete static_cast<boundaries*>(pointer);
+    }
+
+} // namespace tree
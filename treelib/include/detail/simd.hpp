@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "intrinsics.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TREELIB_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define TREELIB_SIMD_X86 0
+#endif
+
+namespace tree::detail
+{
+    ///////////////////////////
+    //   FEATURE DETECTION   //
+    ///////////////////////////
+
+    enum class simd_isa : char {scalar, sse, avx2};
+
+    inline simd_isa detect_simd_isa() noexcept
+    {
+#if TREELIB_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return simd_isa::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2"))
+        {
+            return simd_isa::sse;
+        }
+#endif
+        return simd_isa::scalar;
+    }
+
+    inline simd_isa supported_simd_isa() noexcept
+    {
+        static const simd_isa isa = detect_simd_isa();
+        return isa;
+    }
+
+    ////////////////////
+    //   BLOCK RANK   //
+    ////////////////////
+
+    // Number of keys less than x in a cache-line block of signed integers.
+    // Blocks hold 64 bytes: 16 x int32 or 8 x int64, aligned to the cache line.
+
+    template <typename Key, std::size_t B>
+    inline unsigned block_rank_scalar(const Key* block, Key x) noexcept
+    {
+        unsigned rank = 0;
+        for (std::size_t i = 0; i < B; i++)
+        {
+            rank += static_cast<unsigned>(block[i] < x);
+        }
+        return rank;
+    }
+
+#if TREELIB_SIMD_X86
+    template <typename Key, std::size_t B>
+    __attribute__((target("sse4.2")))
+    inline unsigned block_rank_sse(const Key* block, Key x) noexcept
+    {
+        unsigned rank = 0;
+        if constexpr (sizeof(Key) == 4)
+        {
+            const __m128i needle = _mm_set1_epi32(static_cast<int>(x));
+            for (std::size_t i = 0; i < B; i += 4)
+            {
+                const __m128i keys = _mm_load_si128(reinterpret_cast<const __m128i*>(block + i));
+                const __m128i less = _mm_cmpgt_epi32(needle, keys);
+                rank += static_cast<unsigned>(__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(less))));
+            }
+        }
+        else
+        {
+            const __m128i needle = _mm_set1_epi64x(static_cast<long long>(x));
+            for (std::size_t i = 0; i < B; i += 2)
+            {
+                const __m128i keys = _mm_load_si128(reinterpret_cast<const __m128i*>(block + i));
+                const __m128i less = _mm_cmpgt_epi64(needle, keys);
+                rank += static_cast<unsigned>(__builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(less))));
+            }
+        }
+        return rank;
+    }
+
+    template <typename Key, std::size_t B>
+    __attribute__((target("avx2")))
+    inline unsigned block_rank_avx2(const Key* block, Key x) noexcept
+    {
+        unsigned rank = 0;
+        if constexpr (sizeof(Key) == 4)
+        {
+            const __m256i needle = _mm256_set1_epi32(static_cast<int>(x));
+            for (std::size_t i = 0; i < B; i += 8)
+            {
+                const __m256i keys = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + i));
+                const __m256i less = _mm256_cmpgt_epi32(needle, keys);
+                rank += static_cast<unsigned>(__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(less))));
+            }
+        }
+        else
+        {
+            const __m256i needle = _mm256_set1_epi64x(static_cast<long long>(x));
+            for (std::size_t i = 0; i < B; i += 4)
+            {
+                const __m256i keys = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + i));
+                const __m256i less = _mm256_cmpgt_epi64(needle, keys);
+                rank += static_cast<unsigned>(__builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(less))));
+            }
+        }
+        return rank;
+    }
+#endif
+
+    ////////////////////////////
+    //   K-ARY TREE DESCENT   //
+    ////////////////////////////
+
+    // Static B+ tree of blocks: layer 0 is the sorted keys padded up to whole blocks,
+    // layer h holds B separators per block for B + 1 children in layer h - 1.
+    template <typename Key>
+    struct kary_layout
+    {
+        const Key* keys = nullptr;            // all layers, block after block
+        const std::size_t* offsets = nullptr; // first block of every layer
+        std::size_t height = 0;               // number of layers
+    };
+
+    // batched lookups descend this many keys level by level to overlap their cache misses
+    constexpr std::size_t kary_batch_group = 16;
+
+    // one of the block_rank kernels
+    template <typename Key>
+    using block_rank_kernel = unsigned (*)(const Key*, Key) noexcept;
+
+    // The descents below are shared by every instruction set. A kernel with a target cannot be
+    // inlined into a function without it, so every instruction set has a wrapper compiled for
+    // it that flattens the descent and the kernel into itself.
+
+    // returns the position of the lower bound in layer 0
+    template <typename Key, std::size_t B, block_rank_kernel<Key> Rank>
+    std::size_t kary_search(const kary_layout<Key>& layout, Key x) noexcept
+    {
+        std::size_t block = 0;
+        for (std::size_t h = layout.height - 1; h > 0; h--)
+        {
+            const Key* keys = layout.keys + (layout.offsets[h] + block) * B;
+            block = block * (B + 1) + Rank(keys, x);
+        }
+        return block * B + Rank(layout.keys + block * B, x);
+    }
+
+    template <typename Key, std::size_t B, block_rank_kernel<Key> Rank>
+    void kary_search_batch(const kary_layout<Key>& layout,
+                           const Key* xs, std::size_t count, std::size_t* positions) noexcept
+    {
+        for (std::size_t first = 0; first < count; first += kary_batch_group)
+        {
+            const std::size_t group = count - first < kary_batch_group ? count - first : kary_batch_group;
+            std::size_t blocks[kary_batch_group] = { };
+
+            for (std::size_t h = layout.height - 1; h > 0; h--)
+            {
+                for (std::size_t q = 0; q < group; q++)
+                {
+                    const Key* keys = layout.keys + (layout.offsets[h] + blocks[q]) * B;
+                    blocks[q] = blocks[q] * (B + 1) + Rank(keys, xs[first + q]);
+                    prefetch(layout.keys + (layout.offsets[h - 1] + blocks[q]) * B);
+                }
+            }
+
+            for (std::size_t q = 0; q < group; q++)
+            {
+                const Key* keys = layout.keys + blocks[q] * B;
+                positions[first + q] = blocks[q] * B + Rank(keys, xs[first + q]);
+            }
+        }
+    }
+
+    template <typename Key, std::size_t B>
+    std::size_t kary_search_scalar(const kary_layout<Key>& layout, Key x) noexcept
+    {
+        return kary_search<Key, B, &block_rank_scalar<Key, B>>(layout, x);
+    }
+
+    template <typename Key, std::size_t B>
+    void kary_search_batch_scalar(const kary_layout<Key>& layout,
+                                  const Key* xs, std::size_t count, std::size_t* positions) noexcept
+    {
+        kary_search_batch<Key, B, &block_rank_scalar<Key, B>>(layout, xs, count, positions);
+    }
+
+#if TREELIB_SIMD_X86
+    template <typename Key, std::size_t B>
+    __attribute__((target("sse4.2"), flatten))
+    std::size_t kary_search_sse(const kary_layout<Key>& layout, Key x) noexcept
+    {
+        return kary_search<Key, B, &block_rank_sse<Key, B>>(layout, x);
+    }
+
+    template <typename Key, std::size_t B>
+    __attribute__((target("sse4.2"), flatten))
+    void kary_search_batch_sse(const kary_layout<Key>& layout,
+                               const Key* xs, std::size_t count, std::size_t* positions) noexcept
+    {
+        kary_search_batch<Key, B, &block_rank_sse<Key, B>>(layout, xs, count, positions);
+    }
+
+    template <typename Key, std::size_t B>
+    __attribute__((target("avx2"), flatten))
+    std::size_t kary_search_avx2(const kary_layout<Key>& layout, Key x) noexcept
+    {
+        return kary_search<Key, B, &block_rank_avx2<Key, B>>(layout, x);
+    }
+
+    template <typename Key, std::size_t B>
+    __attribute__((target("avx2"), flatten))
+    void kary_search_batch_avx2(const kary_layout<Key>& layout,
+                                const Key* xs, std::size_t count, std::size_t* positions) noexcept
+    {
+        kary_search_batch<Key, B, &block_rank_avx2<Key, B>>(layout, xs, count, positions);
+    }
+#endif
+
+} // namespace tree::detail
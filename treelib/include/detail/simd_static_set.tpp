@@ -0,0 +1,236 @@
+#pragma once
+
+namespace tree
+{
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key>
+    simd_static_set<Key>::simd_static_set() = default;
+
+    template <typename Key>
+    template <typename InputIt>
+    simd_static_set<Key>::simd_static_set(InputIt first, InputIt last, isa_type isa)
+    {
+        // never run instructions the CPU does not have
+        const isa_type supported = detail::supported_simd_isa();
+        m_isa = static_cast<char>(isa) <= static_cast<char>(supported) ? isa : supported;
+
+        // step 1: layer 0 is the sorted keys themselves, padded with the maximum key
+        constexpr key_type padding = std::numeric_limits<key_type>::max();
+        for (; first != last; ++first)
+        {
+            const std::size_t slot = m_size % block_size;
+            if (slot == 0)
+            {
+                blocks.emplace_back();
+            }
+            blocks.back().keys[slot] = *first;
+            m_size++;
+        }
+
+        if (blocks.empty())
+        {
+            return;
+        }
+
+        for (std::size_t slot = m_size % block_size; slot != 0 && slot < block_size; slot++)
+        {
+            blocks.back().keys[slot] = padding;
+        }
+
+        // step 2: every separator is the smallest key of the subtree to its right,
+        //         which is the first key of that subtree's leftmost leaf block
+        const std::size_t leaf_blocks = blocks.size();
+        offsets.push_back(0);
+
+        std::size_t layer_blocks = leaf_blocks;
+        std::size_t leaves_per_child = 1;
+        while (layer_blocks > 1)
+        {
+            layer_blocks = (layer_blocks + block_size) / (block_size + 1);
+            offsets.push_back(blocks.size());
+
+            for (std::size_t j = 0; j < layer_blocks; j++)
+            {
+                block separators;
+                for (std::size_t i = 0; i < block_size; i++)
+                {
+                    const std::size_t leaf = (j * (block_size + 1) + i + 1) * leaves_per_child;
+                    separators.keys[i] = leaf < leaf_blocks ? blocks[leaf].keys[0] : padding;
+                }
+                blocks.push_back(separators);
+            }
+
+            leaves_per_child *= block_size + 1;
+        }
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key>
+    typename simd_static_set<Key>::const_iterator simd_static_set<Key>::begin() const
+    {
+        return blocks.empty() ? nullptr : blocks.front().keys;
+    }
+
+    template <typename Key>
+    typename simd_static_set<Key>::const_iterator simd_static_set<Key>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key>
+    typename simd_static_set<Key>::const_iterator simd_static_set<Key>::end() const
+    {
+        return begin() + m_size;
+    }
+
+    template <typename Key>
+    typename simd_static_set<Key>::const_iterator simd_static_set<Key>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key>
+    bool simd_static_set<Key>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key>
+    std::size_t simd_static_set<Key>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    template <typename Key>
+    typename simd_static_set<Key>::isa_type simd_static_set<Key>::isa() const noexcept
+    {
+        return m_isa;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key>
+    typename simd_static_set<Key>::const_iterator simd_static_set<Key>::find(key_type value) const
+    {
+        const auto it = lower_bound(value);
+        return it != end() && *it == value ? it : end();
+    }
+
+    template <typename Key>
+    typename simd_static_set<Key>::const_iterator simd_static_set<Key>::lower_bound(key_type value) const
+    {
+        return begin() + rank(value);
+    }
+
+    template <typename Key>
+    bool simd_static_set<Key>::contains(key_type value) const
+    {
+        return find(value) != end();
+    }
+
+    template <typename Key>
+    std::size_t simd_static_set<Key>::rank(key_type value) const
+    {
+        const std::size_t position = search(value);
+        return position < m_size ? position : m_size;
+    }
+
+    template <typename Key>
+    void simd_static_set<Key>::batch_rank(const key_type* values, std::size_t count, std::size_t* ranks) const
+    {
+        if (empty())
+        {
+            std::fill(ranks, ranks + count, 0);
+            return;
+        }
+
+        switch (m_isa)
+        {
+#if TREELIB_SIMD_X86
+            case isa_type::avx2:
+            {
+                detail::kary_search_batch_avx2<key_type, block_size>(layout(), values, count, ranks);
+                break;
+            }
+            case isa_type::sse:
+            {
+                detail::kary_search_batch_sse<key_type, block_size>(layout(), values, count, ranks);
+                break;
+            }
+#endif
+            default:
+            {
+                detail::kary_search_batch_scalar<key_type, block_size>(layout(), values, count, ranks);
+                break;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            ranks[i] = ranks[i] < m_size ? ranks[i] : m_size;
+        }
+    }
+
+    template <typename Key>
+    void simd_static_set<Key>::batch_contains(const key_type* values, std::size_t count, bool* found) const
+    {
+        std::size_t ranks[detail::kary_batch_group];
+
+        for (std::size_t first = 0; first < count; first += detail::kary_batch_group)
+        {
+            const std::size_t group = std::min(count - first, detail::kary_batch_group);
+            batch_rank(values + first, group, ranks);
+
+            for (std::size_t q = 0; q < group; q++)
+            {
+                found[first + q] = ranks[q] < m_size && begin()[ranks[q]] == values[first + q];
+            }
+        }
+    }
+
+    template <typename Key>
+    std::size_t simd_static_set<Key>::search(key_type value) const
+    {
+        if (empty())
+        {
+            return 0;
+        }
+
+        switch (m_isa)
+        {
+#if TREELIB_SIMD_X86
+            case isa_type::avx2:
+            {
+                return detail::kary_search_avx2<key_type, block_size>(layout(), value);
+            }
+            case isa_type::sse:
+            {
+                return detail::kary_search_sse<key_type, block_size>(layout(), value);
+            }
+#endif
+            default:
+            {
+                return detail::kary_search_scalar<key_type, block_size>(layout(), value);
+            }
+        }
+    }
+
+    template <typename Key>
+    detail::kary_layout<Key> simd_static_set<Key>::layout() const noexcept
+    {
+        return {blocks.front().keys, offsets.data(), offsets.size()};
+    }
+
+} // namespace tree
@@ -59,6 +59,35 @@ namespace tree
 		this->clear();
 	}
 
+	template <typename Key, typename Compare>
+	template <typename InputIt, typename ExecutionPolicy>
+	splay<Key, Compare> splay<Key, Compare>::from_unsorted(InputIt first, InputIt last, const ExecutionPolicy& policy)
+	{
+		static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+		thread_pool* executor = detail::executor_of(policy);
+
+		splay<key_type, key_compare> result;
+		auto keys = detail::sorted_unique<key_type>(first, last, result.key_cmp, executor);
+		result.head = build_sorted(keys, 0, keys.size(), executor);
+		result.m_size = keys.size();
+		return result;
+	}
+
+	template <typename Key, typename Compare>
+	template <typename ExecutionPolicy>
+	splay<Key, Compare> splay<Key, Compare>::clone(const ExecutionPolicy& policy) const
+	{
+		static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+		splay<key_type, key_compare> result;
+		result.head = detail::parallel_clone<node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy));
+		result.m_size = m_size;
+		result.key_cmp = key_cmp;
+		result.count_accesses = count_accesses;
+		return result;
+	}
+
         template <typename Key, typename Compare>
         typename splay<Key, Compare>::iterator splay<Key, Compare>::begin()
         {
@@ -95,6 +124,27 @@ namespace tree
                 return const_iterator(std::make_optional<node_ptr>(nullptr));
         }
 
+	template <typename Key, typename Compare>
+	template <typename Function, typename ExecutionPolicy>
+	void splay<Key, Compare>::for_each(Function function, const ExecutionPolicy& policy) const
+	{
+		static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+		detail::parallel_visit<node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy),
+		                                  [&](const node_type* node) { function(node->value); });
+	}
+
+	template <typename Key, typename Compare>
+	template <typename T, typename Accumulate, typename Combine, typename ExecutionPolicy>
+	T splay<Key, Compare>::reduce(T identity, Accumulate accumulate, Combine combine,
+	                              const ExecutionPolicy& policy) const
+	{
+		static_assert(is_execution_policy_v<ExecutionPolicy>, "the policy is either tree::seq or tree::par");
+
+		return detail::parallel_reduce<T, node_type>(head, detail::fork_depth(m_size), detail::executor_of(policy),
+		                                             identity, accumulate, combine);
+	}
+
 	template <typename Key, typename Compare>
 	bool splay<Key, Compare>::empty() const noexcept
 	{
@@ -182,6 +232,10 @@ namespace tree
 				break;
 			}
 		}
+		if (count_accesses && current != nullptr)
+		{
+			current->accesses += current->accesses != std::numeric_limits<std::uint32_t>::max() ? 1 : 0;
+		}
 		splay_operation(current);
 		return iterator(head, current);
 	}
@@ -205,10 +259,121 @@ namespace tree
 				break;
 			}
 		}
+		if (count_accesses && current != nullptr)
+		{
+			current->accesses += current->accesses != std::numeric_limits<std::uint32_t>::max() ? 1 : 0;
+		}
 		splay_operation(current);
 		return const_iterator(head, current);
 	}
 
+	template <typename Key, typename Compare>
+	static_set<Key, Compare> splay<Key, Compare>::freeze() const
+	{
+		return static_set<key_type, key_compare>(begin(), end());
+	}
+
+	template <typename Key, typename Compare>
+	void splay<Key, Compare>::set_access_counting(bool enabled)
+	{
+		if (enabled)
+		{
+			std::vector<node_ptr> stack;
+			if (head != nullptr)
+			{
+				stack.push_back(head);
+			}
+			while (!stack.empty())
+			{
+				node_ptr node = stack.back();
+				stack.pop_back();
+				node->accesses = 0;
+
+				if (node->left != nullptr)
+				{
+					stack.push_back(node->left);
+				}
+				if (node->right != nullptr)
+				{
+					stack.push_back(node->right);
+				}
+			}
+		}
+		count_accesses = enabled;
+	}
+
+	template <typename Key, typename Compare>
+	std::vector<std::pair<Key, std::size_t>> splay<Key, Compare>::access_weights() const
+	{
+		std::vector<std::pair<key_type, std::size_t>> weights;
+		weights.reserve(m_size);
+
+		// in-order walk over the nodes
+		std::vector<node_ptr> stack;
+		node_ptr node = head;
+		while (node != nullptr || !stack.empty())
+		{
+			while (node != nullptr)
+			{
+				stack.push_back(node);
+				node = node->left;
+			}
+			node = stack.back();
+			stack.pop_back();
+
+			weights.emplace_back(node->value, node->accesses);
+			node = node->right;
+		}
+
+		return weights;
+	}
+
+	template <typename Key, typename Compare>
+	std::size_t splay<Key, Compare>::depth(const key_type& value) const
+	{
+		std::size_t depth = 1;
+		node_ptr current = head;
+		while (current != nullptr)
+		{
+			if (key_cmp(value, current->value))
+			{
+				current = current->left;
+			}
+			else if (key_cmp(current->value, value))
+			{
+				current = current->right;
+			}
+			else
+			{
+				return depth;
+			}
+			depth++;
+		}
+		return 0;
+	}
+
+	template <typename Key, typename Compare>
+	const typename splay<Key, Compare>::node_type* splay<Key, Compare>::lookup(const key_type& value) const
+	{
+		node_ptr current = head;
+		while (current != nullptr)
+		{
+			if (key_cmp(value, current->value))
+			{
+				current = current->left;
+			}
+			else if (key_cmp(current->value, value))
+			{
+				current = current->right;
+			}
+			else
+			{
+				break;
+			}
+		}
+		return current;
+	}
+
 	template <typename Key, typename Compare>
 	void splay<Key, Compare>::erase(const key_type& key)
 	{
@@ -444,4 +609,28 @@ namespace tree
 		head = current;
 	}
 
+	template <typename Key, typename Compare>
+	typename splay<Key, Compare>::node_ptr
+	splay<Key, Compare>::build_sorted(std::vector<key_type>& keys, std::size_t first, std::size_t last,
+	                                  thread_pool* executor)
+	{
+		if (first == last)
+		{
+			return nullptr;
+		}
+
+		// the parent is allocated before its subtrees, so a path down the tree goes forward in memory
+		const std::size_t middle = first + (last - first) / 2;
+		node_ptr node = new node_type(std::move(keys[middle]));
+
+		const auto [lhs, rhs] = detail::fork_join(
+				last - first > detail::parallel_grain ? executor : nullptr,
+				[&]() { return build_sorted(keys, first, middle, executor); },
+				[&]() { return build_sorted(keys, middle + 1, last, executor); });
+
+		node->left = lhs;
+		node->right = rhs;
+		return node;
+	}
+
 }
\ No newline at end of file
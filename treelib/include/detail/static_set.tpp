@@ -0,0 +1,329 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare>::const_iterator::const_iterator(const self_type* owner, std::size_t index)
+        : owner{owner}, index{index}
+    { }
+
+    template <typename Key, typename Compare>
+    const Key& static_set<Key, Compare>::const_iterator::operator * () const
+    {
+        return owner->data[index];
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator&
+    static_set<Key, Compare>::const_iterator::operator ++ ()
+    {
+        index = owner->next_index(index);
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator
+    static_set<Key, Compare>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator&
+    static_set<Key, Compare>::const_iterator::operator -- ()
+    {
+        index = owner->prev_index(index);
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator
+    static_set<Key, Compare>::const_iterator::operator -- (int)
+    {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare>
+    bool static_set<Key, Compare>::const_iterator::operator == (const const_iterator& other) const
+    {
+        return owner == other.owner && index == other.index;
+    }
+
+    template <typename Key, typename Compare>
+    bool static_set<Key, Compare>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::const_iterator::get_index() const noexcept
+    {
+        return index;
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare>::static_set() = default;
+
+    template <typename Key, typename Compare>
+    template <typename InputIt>
+    static_set<Key, Compare>::static_set(InputIt first, InputIt last)
+    {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+        {
+            const auto count = static_cast<std::size_t>(std::distance(first, last));
+            assign_sorted(first, count);
+        }
+        else
+        {
+            const std::vector<key_type> sorted(first, last);
+            assign_sorted(sorted.cbegin(), sorted.size());
+        }
+    }
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare>::static_set(std::initializer_list<key_type> data)
+    {
+        std::vector<key_type> sorted(data);
+        std::sort(sorted.begin(), sorted.end(), key_cmp);
+
+        auto equal = [this](const key_type& lhs, const key_type& rhs)
+        {
+            return !key_cmp(lhs, rhs) && !key_cmp(rhs, lhs);
+        };
+        sorted.erase(std::unique(sorted.begin(), sorted.end(), equal), sorted.end());
+
+        assign_sorted(sorted.cbegin(), sorted.size());
+    }
+
+    template <typename Key, typename Compare>
+    template <typename InputIt>
+    void static_set<Key, Compare>::assign_sorted(InputIt first, std::size_t count)
+    {
+        m_size = count;
+        data.assign(count + 1, key_type());
+
+        // visiting Eytzinger positions in-order consumes the sorted input front to back
+        std::size_t index = first_index();
+        for (std::size_t rank = 0; rank < count; rank++, ++first)
+        {
+            data[index] = *first;
+            index = next_index(index);
+        }
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator static_set<Key, Compare>::begin() const
+    {
+        return const_iterator(this, first_index());
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator static_set<Key, Compare>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator static_set<Key, Compare>::end() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator static_set<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool static_set<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator
+    static_set<Key, Compare>::find(const key_type& value) const
+    {
+        const std::size_t index = search(value);
+        if (index != 0 && !key_cmp(value, data[index]))
+        {
+            return const_iterator(this, index);
+        }
+
+        return end();
+    }
+
+    template <typename Key, typename Compare>
+    typename static_set<Key, Compare>::const_iterator
+    static_set<Key, Compare>::lower_bound(const key_type& value) const
+    {
+        return const_iterator(this, search(value));
+    }
+
+    template <typename Key, typename Compare>
+    bool static_set<Key, Compare>::contains(const key_type& value) const
+    {
+        return find(value) != end();
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::rank(const key_type& value) const
+    {
+        const std::size_t index = search(value);
+        return index != 0 ? rank_of(index) : m_size;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::search(const key_type& value) const
+    {
+        constexpr std::size_t levels = prefetch_levels();
+        const key_type* const base = data.data();
+
+        // the descendants on the last levels may lie past the end, so their address is
+        // computed as an integer rather than by pointer arithmetic
+        const auto address = reinterpret_cast<std::uintptr_t>(base);
+
+        // branchless descent: go right while the node is less than the value
+        std::size_t index = 1;
+        while (index <= m_size)
+        {
+            detail::prefetch(reinterpret_cast<const void*>(address + (index << levels) * sizeof(key_type)));
+            index = 2 * index + static_cast<std::size_t>(key_cmp(base[index], value));
+        }
+
+        // the answer is the last node where the descent went left:
+        // strip the trailing right turns and that one left turn
+        return index >> (detail::count_trailing_ones(index) + 1);
+    }
+
+    ////////////////////
+    //   NAVIGATION   //
+    ////////////////////
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::first_index() const noexcept
+    {
+        if (m_size == 0)
+        {
+            return 0;
+        }
+
+        std::size_t index = 1;
+        while (2 * index <= m_size)
+        {
+            index = 2 * index;
+        }
+        return index;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::last_index() const noexcept
+    {
+        if (m_size == 0)
+        {
+            return 0;
+        }
+
+        std::size_t index = 1;
+        while (2 * index + 1 <= m_size)
+        {
+            index = 2 * index + 1;
+        }
+        return index;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::next_index(std::size_t index) const noexcept
+    {
+        if (index == 0)
+        {
+            return 0;
+        }
+
+        if (2 * index + 1 <= m_size)
+        {
+            // if there is right subtree - go to the smallest node in it
+            index = 2 * index + 1;
+            while (2 * index <= m_size)
+            {
+                index = 2 * index;
+            }
+            return index;
+        }
+
+        // go up while being a right child, then once more
+        return index >> (detail::count_trailing_ones(index) + 1);
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::prev_index(std::size_t index) const noexcept
+    {
+        if (index == 0)
+        {
+            // prev from end()
+            return last_index();
+        }
+
+        if (2 * index <= m_size)
+        {
+            // if there is left subtree - go to the biggest node in it
+            index = 2 * index;
+            while (2 * index + 1 <= m_size)
+            {
+                index = 2 * index + 1;
+            }
+            return index;
+        }
+
+        // go up while being a left child, then once more
+        return index >> (detail::count_trailing_zeros(index) + 1);
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t static_set<Key, Compare>::rank_of(std::size_t index) const noexcept
+    {
+        // the position in the perfect tree of the same height, less the slots of the
+        // last level that are empty and come before it; those sit at even positions
+        const std::size_t height = 63 - detail::count_leading_zeros(m_size);
+        const std::size_t depth = 63 - detail::count_leading_zeros(index);
+        const std::size_t offset = index - (std::size_t{1} << depth);
+        const std::size_t perfect = ((2 * offset + 1) << (height - depth)) - 1;
+
+        const std::size_t last_level = m_size - ((std::size_t{1} << height) - 1);
+        const std::size_t slots_before = (perfect + 1) / 2;
+        return slots_before > last_level ? perfect - (slots_before - last_level) : perfect;
+    }
+
+} // namespace tree
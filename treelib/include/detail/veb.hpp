@@ -0,0 +1,469 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+#include "intrinsics.hpp"
+
+namespace tree::detail
+{
+    // Building blocks of int_successor_set over the universe [0, 2^Bits):
+    // values are passed as std::uint64_t, and veb_none stands for a missing one.
+    constexpr std::uint64_t veb_none = ~std::uint64_t(0);
+
+    // largest universe kept as a flat bitmap
+    constexpr unsigned veb_leaf_bits = 12;
+
+    /////////////////////
+    //   BITMAP LEAF   //
+    /////////////////////
+
+    // One bit per value in up to 64 words, plus a summary word with a bit per non-empty word,
+    // so every operation is a couple of ctz/clz on two words.
+    template <unsigned Bits>
+    class bitmap_leaf
+    {
+        static_assert(Bits >= 1 && Bits <= veb_leaf_bits, "a bitmap leaf holds at most 64 words");
+
+    public:
+        static constexpr unsigned word_count = Bits > 6 ? 1u << (Bits - 6) : 1u;
+
+        bool empty() const noexcept
+        {
+            return summary == 0;
+        }
+
+        bool contains(std::uint64_t x) const noexcept
+        {
+            return (words[x >> 6u] >> (x & 63u) & 1u) != 0;
+        }
+
+        // false if x was already there
+        bool insert(std::uint64_t x) noexcept
+        {
+            const std::uint64_t bit = std::uint64_t(1) << (x & 63u);
+            std::uint64_t& word = words[x >> 6u];
+            if ((word & bit) != 0)
+            {
+                return false;
+            }
+            word |= bit;
+            summary |= std::uint64_t(1) << (x >> 6u);
+            return true;
+        }
+
+        // false if x was not there
+        bool erase(std::uint64_t x) noexcept
+        {
+            const std::uint64_t bit = std::uint64_t(1) << (x & 63u);
+            std::uint64_t& word = words[x >> 6u];
+            if ((word & bit) == 0)
+            {
+                return false;
+            }
+            word &= ~bit;
+            if (word == 0)
+            {
+                summary &= ~(std::uint64_t(1) << (x >> 6u));
+            }
+            return true;
+        }
+
+        // the leaf must not be empty
+        std::uint64_t min() const noexcept
+        {
+            const unsigned w = count_trailing_zeros(summary);
+            return (std::uint64_t(w) << 6u) | count_trailing_zeros(words[w]);
+        }
+
+        std::uint64_t max() const noexcept
+        {
+            const unsigned w = 63u - count_leading_zeros(summary);
+            return (std::uint64_t(w) << 6u) | (63u - count_leading_zeros(words[w]));
+        }
+
+        // smallest value greater than x
+        std::uint64_t successor(std::uint64_t x) const noexcept
+        {
+            const auto w = static_cast<unsigned>(x >> 6u);
+            const auto b = static_cast<unsigned>(x & 63u);
+
+            const std::uint64_t above = b == 63u ? 0 : words[w] & (~std::uint64_t(0) << (b + 1u));
+            if (above != 0)
+            {
+                return (std::uint64_t(w) << 6u) | count_trailing_zeros(above);
+            }
+
+            const std::uint64_t next_words = w == 63u ? 0 : summary & (~std::uint64_t(0) << (w + 1u));
+            if (next_words == 0)
+            {
+                return veb_none;
+            }
+            const unsigned next = count_trailing_zeros(next_words);
+            return (std::uint64_t(next) << 6u) | count_trailing_zeros(words[next]);
+        }
+
+        // largest value less than x
+        std::uint64_t predecessor(std::uint64_t x) const noexcept
+        {
+            const auto w = static_cast<unsigned>(x >> 6u);
+            const auto b = static_cast<unsigned>(x & 63u);
+
+            const std::uint64_t below = words[w] & ((std::uint64_t(1) << b) - 1u);
+            if (below != 0)
+            {
+                return (std::uint64_t(w) << 6u) | (63u - count_leading_zeros(below));
+            }
+
+            const std::uint64_t previous_words = summary & ((std::uint64_t(1) << w) - 1u);
+            if (previous_words == 0)
+            {
+                return veb_none;
+            }
+            const unsigned previous = 63u - count_leading_zeros(previous_words);
+            return (std::uint64_t(previous) << 6u) | (63u - count_leading_zeros(words[previous]));
+        }
+
+        // number of values less than x
+        std::size_t rank(std::uint64_t x) const noexcept
+        {
+            const auto w = static_cast<unsigned>(x >> 6u);
+            std::size_t count = population_count(words[w] & ((std::uint64_t(1) << (x & 63u)) - 1u));
+            for (unsigned i = 0; i < w; i++)
+            {
+                count += population_count(words[i]);
+            }
+            return count;
+        }
+
+        std::size_t count() const noexcept
+        {
+            std::size_t count = 0;
+            for (unsigned i = 0; i < word_count; i++)
+            {
+                count += population_count(words[i]);
+            }
+            return count;
+        }
+
+        bool is_consistent() const noexcept
+        {
+            for (unsigned i = 0; i < word_count; i++)
+            {
+                if ((words[i] != 0) != ((summary >> i & 1u) != 0))
+                {
+                    return false;
+                }
+            }
+            return word_count == 64 || (summary >> word_count) == 0;
+        }
+
+    private:
+        std::uint64_t summary = 0;
+        std::uint64_t words[word_count] = { };
+    };
+
+    ///////////////////////
+    //   VAN EMDE BOAS   //
+    ///////////////////////
+
+    template <unsigned Bits>
+    class veb_node;
+
+    template <unsigned Bits>
+    using veb_set = std::conditional_t<(Bits <= veb_leaf_bits), bitmap_leaf<Bits>, veb_node<Bits>>;
+
+    // Values split into a high and a low half: the cluster of the high half holds the low
+    // halves, and the summary holds the high halves of non-empty clusters. The minimum is
+    // kept out of the clusters, so inserting into an empty cluster and erasing the last value
+    // of one take O(1) and every operation recurses into one half: O(log Bits) levels.
+    template <unsigned Bits>
+    class veb_node
+    {
+    public:
+        static constexpr unsigned low_bits = Bits / 2;
+        static constexpr unsigned high_bits = Bits - low_bits;
+
+        using summary_type = veb_set<high_bits>;
+        using cluster_type = veb_set<low_bits>;
+
+        // Over a bitmap summary clusters are packed in the order of their high halves and found
+        // by rank, otherwise the table of all 2^high_bits clusters is allocated on first use.
+        static constexpr bool compact = high_bits <= veb_leaf_bits;
+
+        bool empty() const noexcept
+        {
+            return min_value == veb_none;
+        }
+
+        std::uint64_t min() const noexcept
+        {
+            return min_value;
+        }
+
+        std::uint64_t max() const noexcept
+        {
+            return max_value;
+        }
+
+        bool contains(std::uint64_t x) const noexcept
+        {
+            if (x == min_value || x == max_value)
+            {
+                return true;
+            }
+            if (empty() || x < min_value || x > max_value)
+            {
+                return false;
+            }
+            const cluster_type* cluster = cluster_of(high(x));
+            return cluster != nullptr && cluster->contains(low(x));
+        }
+
+        bool insert(std::uint64_t x)
+        {
+            if (empty())
+            {
+                min_value = x;
+                max_value = x;
+                return true;
+            }
+            if (x == min_value)
+            {
+                return false;
+            }
+            if (x < min_value)
+            {   // the new minimum stays out of the clusters, the old one goes in
+                std::swap(x, min_value);
+            }
+            if (x > max_value)
+            {
+                max_value = x;
+            }
+
+            const std::uint64_t h = high(x);
+            cluster_type* cluster = cluster_of(h);
+            if (cluster == nullptr)
+            {
+                cluster = add_cluster(h);
+            }
+            return cluster->insert(low(x));
+        }
+
+        bool erase(std::uint64_t x)
+        {
+            if (empty() || x < min_value || x > max_value)
+            {
+                return false;
+            }
+            if (min_value == max_value)
+            {
+                min_value = veb_none;
+                max_value = veb_none;
+                return true;
+            }
+
+            if (x == min_value)
+            {   // the next value becomes the minimum and leaves its cluster
+                const std::uint64_t h = summary.min();
+                x = index(h, cluster_of(h)->min());
+                min_value = x;
+            }
+
+            const std::uint64_t h = high(x);
+            cluster_type* cluster = cluster_of(h);
+            if (cluster == nullptr || !cluster->erase(low(x)))
+            {
+                return false;
+            }
+
+            if (cluster->empty())
+            {
+                remove_cluster(h);
+                if (x == max_value)
+                {
+                    max_value = summary.empty() ? min_value : index(summary.max(), cluster_of(summary.max())->max());
+                }
+            }
+            else if (x == max_value)
+            {
+                max_value = index(h, cluster->max());
+            }
+            return true;
+        }
+
+        std::uint64_t successor(std::uint64_t x) const noexcept
+        {
+            if (empty() || x >= max_value)
+            {
+                return veb_none;
+            }
+            if (x < min_value)
+            {
+                return min_value;
+            }
+
+            // x < max, so a greater value is in the clusters
+            const std::uint64_t h = high(x);
+            const cluster_type* cluster = cluster_of(h);
+            if (cluster != nullptr && low(x) < cluster->max())
+            {
+                return index(h, cluster->successor(low(x)));
+            }
+            const std::uint64_t next = summary.successor(h);
+            return index(next, cluster_of(next)->min());
+        }
+
+        std::uint64_t predecessor(std::uint64_t x) const noexcept
+        {
+            if (empty() || x <= min_value)
+            {
+                return veb_none;
+            }
+            if (x > max_value)
+            {
+                return max_value;
+            }
+
+            const std::uint64_t h = high(x);
+            const cluster_type* cluster = cluster_of(h);
+            if (cluster != nullptr && low(x) > cluster->min())
+            {
+                return index(h, cluster->predecessor(low(x)));
+            }
+            const std::uint64_t previous = summary.empty() ? veb_none : summary.predecessor(h);
+            if (previous == veb_none)
+            {
+                return min_value;
+            }
+            return index(previous, cluster_of(previous)->max());
+        }
+
+        std::size_t count() const noexcept
+        {
+            if (empty())
+            {
+                return 0;
+            }
+
+            std::size_t count = 1;
+            for (const auto& cluster : clusters)
+            {
+                count += cluster != nullptr ? cluster->count() : 0;
+            }
+            return count;
+        }
+
+        // the summary lists exactly the non-empty clusters, and min and max bound them
+        bool is_consistent() const noexcept
+        {
+            if (empty())
+            {
+                return max_value == veb_none && summary.empty() && count_clusters() == 0;
+            }
+            if (!summary.is_consistent() || min_value > max_value)
+            {
+                return false;
+            }
+
+            std::size_t listed = 0;
+            for (std::uint64_t h = summary.empty() ? veb_none : summary.min(); h != veb_none; h = summary.successor(h))
+            {
+                const cluster_type* cluster = cluster_of(h);
+                if (cluster == nullptr || cluster->empty() || !cluster->is_consistent() ||
+                    index(h, cluster->min()) <= min_value || index(h, cluster->max()) > max_value)
+                {
+                    return false;
+                }
+                listed++;
+            }
+            if (listed != count_clusters())
+            {
+                return false;
+            }
+            return summary.empty() ? min_value == max_value
+                                   : index(summary.max(), cluster_of(summary.max())->max()) == max_value;
+        }
+
+    private:
+        static std::uint64_t high(std::uint64_t x) noexcept
+        {
+            return x >> low_bits;
+        }
+
+        static std::uint64_t low(std::uint64_t x) noexcept
+        {
+            return x & ((std::uint64_t(1) << low_bits) - 1u);
+        }
+
+        static std::uint64_t index(std::uint64_t h, std::uint64_t l) noexcept
+        {
+            return (h << low_bits) | l;
+        }
+
+        cluster_type* cluster_of(std::uint64_t h) const noexcept
+        {
+            if constexpr (compact)
+            {
+                return summary.contains(h) ? clusters[summary.rank(h)].get() : nullptr;
+            }
+            else
+            {
+                return clusters.empty() ? nullptr : clusters[h].get();
+            }
+        }
+
+        cluster_type* add_cluster(std::uint64_t h)
+        {
+            auto cluster = std::make_unique<cluster_type>();
+            cluster_type* result = cluster.get();
+            if constexpr (compact)
+            {
+                clusters.insert(clusters.begin() + summary.rank(h), std::move(cluster));
+            }
+            else
+            {
+                if (clusters.empty())
+                {
+                    clusters.resize(std::size_t(1) << high_bits);
+                }
+                clusters[h] = std::move(cluster);
+            }
+            summary.insert(h);
+            return result;
+        }
+
+        void remove_cluster(std::uint64_t h)
+        {
+            if constexpr (compact)
+            {
+                clusters.erase(clusters.begin() + summary.rank(h));
+            }
+            else
+            {
+                clusters[h].reset();
+            }
+            summary.erase(h);
+        }
+
+        std::size_t count_clusters() const noexcept
+        {
+            std::size_t count = 0;
+            for (const auto& cluster : clusters)
+            {
+                count += cluster != nullptr ? 1 : 0;
+            }
+            return count;
+        }
+
+    private:
+        std::uint64_t min_value = veb_none;
+        std::uint64_t max_value = veb_none;
+        summary_type summary;
+        std::vector<std::unique_ptr<cluster_type>> clusters;
+    };
+
+} // namespace tree::detail
@@ -0,0 +1,600 @@
+#pragma once
+
+namespace tree
+{
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>::wavl() = default;
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>::wavl(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>::wavl(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>::wavl(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>::wavl(self_type&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+        std::swap(this->m_size, other.m_size);
+    }
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>::~wavl()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>& wavl<Key, Compare>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    wavl<Key, Compare>& wavl<Key, Compare>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+            std::swap(this->m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::iterator wavl<Key, Compare>::begin()
+    {
+        return iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::const_iterator wavl<Key, Compare>::begin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::const_iterator wavl<Key, Compare>::cbegin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::iterator wavl<Key, Compare>::end()
+    {
+        return iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::const_iterator wavl<Key, Compare>::end() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::const_iterator wavl<Key, Compare>::cend() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool wavl<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t wavl<Key, Compare>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+        m_size = 0;
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::node_ptr wavl<Key, Compare>::insert(key_type key)
+    {
+        path_cache.clear();
+
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            path_cache.push_back(current);
+
+            if (key_cmp(key, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                current = current->right;
+            }
+            else
+            {
+                return current;
+            }
+        }
+
+        auto leaf = new node_type(std::move(key));
+        m_size++;
+
+        if (path_cache.empty())
+        {
+            head = leaf;
+            return leaf;
+        }
+
+        node_ptr parent = path_cache.back();
+        const bool is_left_child = key_cmp(leaf->value, parent->value);
+        child(parent, is_left_child) = leaf;
+
+        // the new leaf has rank 0 and the missing child it replaces had -1
+        if (is_two_child(parent, is_left_child))
+        {   // the parent was unary, now it is 1,1
+            set_two_child(parent, is_left_child, false);
+        }
+        else
+        {   // the parent was a leaf
+            fix_insert(is_left_child);
+        }
+        return leaf;
+    }
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::erase(const key_type& key)
+    {
+        path_cache.clear();
+
+        // caching until the key
+        node_ptr node = head;
+        while (node != nullptr)
+        {
+            if (key_cmp(key, node->value))
+            {
+                path_cache.push_back(node);
+                node = node->left;
+            }
+            else if (key_cmp(node->value, key))
+            {
+                path_cache.push_back(node);
+                node = node->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (node == nullptr)
+        {   // no such key found
+            return;
+        }
+
+        bool is_left_child = false;
+
+        if (node->left != nullptr && node->right != nullptr)
+        {
+            // the node has both children: its in-order successor takes its place and rank,
+            // the successor's old position is the one that lost a node
+            const std::size_t node_position = path_cache.size();
+            path_cache.push_back(node);
+
+            node_ptr next = node->right;
+            while (next->left != nullptr)
+            {
+                path_cache.push_back(next);
+                next = next->left;
+            }
+
+            node_ptr next_parent = path_cache.back();
+            if (next_parent == node)
+            {
+                is_left_child = false;
+            }
+            else
+            {
+                next_parent->left = next->right;
+                next->right = node->right;
+                is_left_child = true;
+            }
+
+            next->left = node->left;
+            next->rank_diff = node->rank_diff;
+            replace_child(node_position > 0 ? path_cache[node_position - 1] : nullptr, node, next);
+            path_cache[node_position] = next;
+        }
+        else
+        {
+            // Case with at most one child - splice the node out,
+            // the child of a unary node is a leaf
+            node_ptr replacement = node->left != nullptr ? node->left : node->right;
+
+            node_ptr parent = path_cache.empty() ? nullptr : path_cache.back();
+            is_left_child = parent != nullptr && parent->left == node;
+            replace_child(parent, node, replacement);
+        }
+
+        delete node;
+        m_size--;
+
+        if (path_cache.empty())
+        {
+            return;
+        }
+
+        // the removed node is replaced by a subtree one rank lower
+        node_ptr parent = path_cache.back();
+        if (is_two_child(parent, is_left_child))
+        {
+            fix_erase(is_left_child);
+            return;
+        }
+        set_two_child(parent, is_left_child, true);
+
+        if (parent->left != nullptr || parent->right != nullptr)
+        {
+            return;
+        }
+
+        // a 2,2 leaf is demoted, which makes it one rank further from its parent
+        parent->rank_diff = 0;
+        path_cache.pop_back();
+        if (path_cache.empty())
+        {
+            return;
+        }
+
+        node_ptr grand_parent = path_cache.back();
+        is_left_child = grand_parent->left == parent;
+        if (is_two_child(grand_parent, is_left_child))
+        {
+            fix_erase(is_left_child);
+        }
+        else
+        {
+            set_two_child(grand_parent, is_left_child, true);
+        }
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::iterator wavl<Key, Compare>::find(const key_type& value)
+    {
+        return iterator(head, find_node(value));
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::const_iterator wavl<Key, Compare>::find(const key_type& value) const
+    {
+        return const_iterator(head, find_node(value));
+    }
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare> wavl<Key, Compare>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key, typename Compare>
+    [[nodiscard]] bool wavl<Key, Compare>::is_wavl() const noexcept
+    {
+        return check(head, nullptr, nullptr) != -2;
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::node_ptr wavl<Key, Compare>::find_node(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return current;
+    }
+
+    template <typename Key, typename Compare>
+    int wavl<Key, Compare>::check(node_ptr subtree, const key_type* lower, const key_type* upper) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return -1;
+        }
+
+        const key_type& key = subtree->value;
+        if ((lower != nullptr && !key_cmp(*lower, key)) || (upper != nullptr && !key_cmp(key, *upper)))
+        {
+            return -2;
+        }
+
+        if (subtree->left == nullptr && subtree->right == nullptr && subtree->rank_diff != 0)
+        {   // leaves are 1,1
+            return -2;
+        }
+
+        const int left_rank = check(subtree->left, lower, &key);
+        const int right_rank = check(subtree->right, &key, upper);
+        if (left_rank == -2 || right_rank == -2)
+        {
+            return -2;
+        }
+
+        const int rank = left_rank + (is_two_child(subtree, true) ? 2 : 1);
+        if (rank != right_rank + (is_two_child(subtree, false) ? 2 : 1))
+        {
+            return -2;
+        }
+        return rank;
+    }
+
+    ///////////////////
+    //   BALANCING   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::fix_insert(bool is_left_child)
+    {
+        // ranks are only known relative to each other, a promotion or a demotion
+        // changes the differences to the children and to the parent
+        while (true)
+        {
+            node_ptr parent = path_cache.back();
+            if (!is_two_child(parent, !is_left_child))
+            {
+                // 0,1: promote the parent and continue one level up
+                parent->rank_diff = is_left_child ? detail::wavl_right_two : detail::wavl_left_two;
+
+                path_cache.pop_back();
+                if (path_cache.empty())
+                {
+                    return;
+                }
+
+                node_ptr grand_parent = path_cache.back();
+                is_left_child = grand_parent->left == parent;
+                if (is_two_child(grand_parent, is_left_child))
+                {
+                    set_two_child(grand_parent, is_left_child, false);
+                    return;
+                }
+                continue;
+            }
+
+            // 0,2: the 0-child was just promoted, so it is 1,2 or 2,1
+            node_ptr node = child(parent, is_left_child);
+            node_ptr grand_parent = path_cache.size() > 1 ? path_cache[path_cache.size() - 2] : nullptr;
+            node_ptr subtree = nullptr;
+
+            if (is_two_child(node, !is_left_child))
+            {
+                // the outer child is a 1-child: single rotation, the parent is demoted
+                subtree = rotate(parent, is_left_child);
+                node->rank_diff = 0;
+                parent->rank_diff = 0;
+            }
+            else
+            {
+                // the inner child is a 1-child: double rotation, it is promoted
+                // and takes the place of the parent, both of them are demoted
+                node_ptr inner = child(node, !is_left_child);
+                const bool is_node_side_two = is_two_child(inner, is_left_child);
+                const bool is_parent_side_two = is_two_child(inner, !is_left_child);
+
+                child(parent, is_left_child) = rotate(node, !is_left_child);
+                subtree = rotate(parent, is_left_child);
+
+                inner->rank_diff = 0;
+                node->rank_diff = 0;
+                set_two_child(node, !is_left_child, is_node_side_two);
+                parent->rank_diff = 0;
+                set_two_child(parent, is_left_child, is_parent_side_two);
+            }
+
+            replace_child(grand_parent, parent, subtree);
+            return;
+        }
+    }
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::fix_erase(bool is_left_child)
+    {
+        // the 3-child keeps the bit of a 2-child until the parent is demoted
+        while (true)
+        {
+            node_ptr parent = path_cache.back();
+
+            // a 3-child means the parent has rank 2 or more, so the sibling exists
+            node_ptr sibling = child(parent, !is_left_child);
+            const bool is_sibling_two = is_two_child(parent, !is_left_child);
+
+            if (is_sibling_two || sibling->rank_diff == (detail::wavl_left_two | detail::wavl_right_two))
+            {
+                // 3,2: demote the parent; 3,1 with a 2,2 sibling: demote both
+                if (!is_sibling_two)
+                {
+                    sibling->rank_diff = 0;
+                }
+                parent->rank_diff = is_left_child ? detail::wavl_left_two : detail::wavl_right_two;
+
+                path_cache.pop_back();
+                if (path_cache.empty())
+                {
+                    return;
+                }
+
+                node_ptr grand_parent = path_cache.back();
+                is_left_child = grand_parent->left == parent;
+                if (!is_two_child(grand_parent, is_left_child))
+                {
+                    set_two_child(grand_parent, is_left_child, true);
+                    return;
+                }
+                continue;
+            }
+
+            // 3,1 with a sibling that has a 1-child: one rotation and done
+            node_ptr grand_parent = path_cache.size() > 1 ? path_cache[path_cache.size() - 2] : nullptr;
+            node_ptr subtree = nullptr;
+
+            if (!is_two_child(sibling, !is_left_child))
+            {
+                // the outer child of the sibling is a 1-child: single rotation,
+                // the sibling is promoted and the parent demoted
+                const bool is_inner_two = is_two_child(sibling, is_left_child);
+                subtree = rotate(parent, !is_left_child);
+
+                sibling->rank_diff = 0;
+                parent->rank_diff = 0;
+                if (parent->left == nullptr && parent->right == nullptr)
+                {   // a leaf is demoted once more
+                    set_two_child(sibling, is_left_child, true);
+                }
+                else
+                {
+                    set_two_child(parent, is_left_child, true);
+                    set_two_child(parent, !is_left_child, is_inner_two);
+                }
+                set_two_child(sibling, !is_left_child, true);
+            }
+            else
+            {
+                // double rotation: the inner child of the sibling is promoted twice
+                // and takes the place of the parent, the parent is demoted twice and the sibling once
+                node_ptr inner = child(sibling, is_left_child);
+                const bool is_parent_side_two = is_two_child(inner, is_left_child);
+                const bool is_sibling_side_two = is_two_child(inner, !is_left_child);
+
+                child(parent, !is_left_child) = rotate(sibling, is_left_child);
+                subtree = rotate(parent, !is_left_child);
+
+                inner->rank_diff = detail::wavl_left_two | detail::wavl_right_two;
+                parent->rank_diff = 0;
+                set_two_child(parent, !is_left_child, is_parent_side_two);
+                sibling->rank_diff = 0;
+                set_two_child(sibling, is_left_child, is_sibling_side_two);
+            }
+
+            replace_child(grand_parent, parent, subtree);
+            return;
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::node_ptr wavl<Key, Compare>::rotate(node_ptr subtree, bool is_left_child) noexcept
+    {
+        node_ptr root = child(subtree, is_left_child);
+        child(subtree, is_left_child) = child(root, !is_left_child);
+        child(root, !is_left_child) = subtree;
+        return root;
+    }
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::replace_child(node_ptr parent, node_ptr old_child, node_ptr new_child) noexcept
+    {
+        if (parent == nullptr)
+        {
+            head = new_child;
+        }
+        else if (parent->left == old_child)
+        {
+            parent->left = new_child;
+        }
+        else
+        {
+            parent->right = new_child;
+        }
+    }
+
+    template <typename Key, typename Compare>
+    typename wavl<Key, Compare>::node_ptr& wavl<Key, Compare>::child(node_ptr node, bool is_left_child) noexcept
+    {
+        return is_left_child ? node->left : node->right;
+    }
+
+    template <typename Key, typename Compare>
+    bool wavl<Key, Compare>::is_two_child(node_ptr parent, bool is_left_child) noexcept
+    {
+        return (parent->rank_diff & (is_left_child ? detail::wavl_left_two : detail::wavl_right_two)) != 0;
+    }
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::set_two_child(node_ptr parent, bool is_left_child, bool is_two) noexcept
+    {
+        const std::uint8_t bit = is_left_child ? detail::wavl_left_two : detail::wavl_right_two;
+        parent->rank_diff = static_cast<std::uint8_t>(is_two ? parent->rank_diff | bit : parent->rank_diff & ~bit);
+    }
+
+    template <typename Key, typename Compare>
+    void wavl<Key, Compare>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left);
+        destroy(subtree->right);
+        delete subtree;
+    }
+
+} // namespace tree
@@ -0,0 +1,730 @@
+#pragma once
+
+namespace tree
+{
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>::weight_balanced() = default;
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>::weight_balanced(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>::weight_balanced(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>::weight_balanced(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>::weight_balanced(self_type&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+    }
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>::~weight_balanced()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>& weight_balanced<Key, Compare>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    weight_balanced<Key, Compare>& weight_balanced<Key, Compare>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::iterator weight_balanced<Key, Compare>::begin()
+    {
+        return iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::const_iterator weight_balanced<Key, Compare>::begin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::const_iterator weight_balanced<Key, Compare>::cbegin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::iterator weight_balanced<Key, Compare>::end()
+    {
+        return iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::const_iterator weight_balanced<Key, Compare>::end() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::const_iterator weight_balanced<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool weight_balanced<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t weight_balanced<Key, Compare>::size() const noexcept
+    {
+        return size_of(head);
+    }
+
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr weight_balanced<Key, Compare>::insert(key_type key)
+    {
+        node_ptr node = new node_type(std::move(key));
+        head = insert_node(head, node);
+        return node;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::erase(const key_type& key)
+    {
+        head = erase_node(head, key);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::self_type weight_balanced<Key, Compare>::split(const key_type& key)
+    {
+        auto [lhs, found, rhs] = split_nodes(head, key);
+
+        self_type greater;
+        head = lhs;
+        greater.head = found != nullptr ? insert_min(rhs, found) : rhs;
+        return greater;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::join(self_type&& other)
+    {
+        head = join_nodes(head, other.head);
+        other.head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::unite(self_type&& other, const sequenced_policy&)
+    {
+        head = unite_nodes(head, other.head, nullptr);
+        other.head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::unite(self_type&& other, const parallel_policy& policy)
+    {
+        head = unite_nodes(head, other.head, detail::executor_of(policy));
+        other.head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::intersect(self_type&& other, const sequenced_policy&)
+    {
+        head = intersect_nodes(head, other.head, nullptr);
+        other.head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::intersect(self_type&& other, const parallel_policy& policy)
+    {
+        head = intersect_nodes(head, other.head, detail::executor_of(policy));
+        other.head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::subtract(self_type&& other, const sequenced_policy&)
+    {
+        head = subtract_nodes(head, other.head, nullptr);
+        other.head = nullptr;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::subtract(self_type&& other, const parallel_policy& policy)
+    {
+        head = subtract_nodes(head, other.head, detail::executor_of(policy));
+        other.head = nullptr;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::iterator weight_balanced<Key, Compare>::find(const key_type& value)
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return iterator(head, current);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::const_iterator weight_balanced<Key, Compare>::find(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return const_iterator(head, current);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::iterator weight_balanced<Key, Compare>::select(std::size_t index)
+    {
+        return iterator(head, select_node(index));
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::const_iterator weight_balanced<Key, Compare>::select(std::size_t index) const
+    {
+        return const_iterator(head, select_node(index));
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t weight_balanced<Key, Compare>::rank(const key_type& value) const
+    {
+        std::size_t result = 0;
+
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(current->value, value))
+            {
+                result += size_of(current->left) + 1;
+                current = current->right;
+            }
+            else
+            {
+                current = current->left;
+            }
+        }
+
+        return result;
+    }
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare> weight_balanced<Key, Compare>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key, typename Compare>
+    [[nodiscard]] bool weight_balanced<Key, Compare>::is_ordered(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return true;
+        }
+
+        const key_type& key = subtree->value;
+
+        node_ptr subtree_lhs = subtree->left;
+        bool is_lhs_ordered =
+                subtree_lhs == nullptr ||
+                (key_cmp(subtree_lhs->value, key) && is_ordered(subtree_lhs));
+
+        node_ptr subtree_rhs = subtree->right;
+        bool is_rhs_ordered =
+                subtree_rhs == nullptr ||
+                (key_cmp(key, subtree_rhs->value) && is_ordered(subtree_rhs));
+
+        return is_lhs_ordered && is_rhs_ordered;
+    }
+
+    template <typename Key, typename Compare>
+    [[nodiscard]] bool weight_balanced<Key, Compare>::is_weight_balanced(node_ptr subtree) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return head == nullptr || (is_ordered(head) && is_weight_balanced(head));
+        }
+
+        node_ptr subtree_lhs = subtree->left;
+        node_ptr subtree_rhs = subtree->right;
+
+        return subtree->size == size_of(subtree_lhs) + size_of(subtree_rhs) + 1 &&
+               is_balanced(size_of(subtree_lhs), size_of(subtree_rhs)) &&
+               (subtree_lhs == nullptr || is_weight_balanced(subtree_lhs)) &&
+               (subtree_rhs == nullptr || is_weight_balanced(subtree_rhs));
+    }
+
+    ///////////////////
+    //   BALANCING   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    std::size_t weight_balanced<Key, Compare>::size_of(node_ptr subtree) noexcept
+    {
+        return subtree != nullptr ? subtree->size : 0;
+    }
+
+    template <typename Key, typename Compare>
+    bool weight_balanced<Key, Compare>::is_balanced(std::size_t lhs_size, std::size_t rhs_size) noexcept
+    {
+        return lhs_size + rhs_size <= 1 ||
+               (lhs_size <= delta * rhs_size && rhs_size <= delta * lhs_size);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr weight_balanced<Key, Compare>::update(node_ptr subtree) noexcept
+    {
+        subtree->size = size_of(subtree->left) + size_of(subtree->right) + 1;
+        return subtree;
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr weight_balanced<Key, Compare>::balance(node_ptr subtree) noexcept
+    {
+        const std::size_t lhs_size = size_of(subtree->left);
+        const std::size_t rhs_size = size_of(subtree->right);
+
+        if (lhs_size + rhs_size > 1)
+        {
+            if (rhs_size > delta * lhs_size)
+            {
+                node_ptr rhs = subtree->right;
+                if (size_of(rhs->left) >= gamma * size_of(rhs->right))
+                {
+                    subtree->right = rotate_right(rhs);
+                }
+                return rotate_left(subtree);
+            }
+
+            if (lhs_size > delta * rhs_size)
+            {
+                node_ptr lhs = subtree->left;
+                if (size_of(lhs->right) >= gamma * size_of(lhs->left))
+                {
+                    subtree->left = rotate_left(lhs);
+                }
+                return rotate_right(subtree);
+            }
+        }
+
+        return update(subtree);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr weight_balanced<Key, Compare>::rotate_left(node_ptr subtree) noexcept
+    {
+        node_ptr root = subtree->right;
+        subtree->right = root->left;
+        root->left = update(subtree);
+        return update(root);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr weight_balanced<Key, Compare>::rotate_right(node_ptr subtree) noexcept
+    {
+        node_ptr root = subtree->left;
+        subtree->left = root->right;
+        root->right = update(subtree);
+        return update(root);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::link(node_ptr lhs, node_ptr middle, node_ptr rhs) noexcept
+    {
+        if (lhs == nullptr)
+        {
+            return insert_min(rhs, middle);
+        }
+        if (rhs == nullptr)
+        {
+            return insert_max(lhs, middle);
+        }
+
+        // descend along the spine of the heavier tree until the sizes are comparable
+        if (delta * lhs->size < rhs->size)
+        {
+            rhs->left = link(lhs, middle, rhs->left);
+            return balance(rhs);
+        }
+        if (delta * rhs->size < lhs->size)
+        {
+            lhs->right = link(lhs->right, middle, rhs);
+            return balance(lhs);
+        }
+
+        middle->left = lhs;
+        middle->right = rhs;
+        return update(middle);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::join_nodes(node_ptr lhs, node_ptr rhs) noexcept
+    {
+        if (lhs == nullptr)
+        {
+            return rhs;
+        }
+        if (rhs == nullptr)
+        {
+            return lhs;
+        }
+
+        if (delta * lhs->size < rhs->size)
+        {
+            rhs->left = join_nodes(lhs, rhs->left);
+            return balance(rhs);
+        }
+        if (delta * rhs->size < lhs->size)
+        {
+            lhs->right = join_nodes(lhs->right, rhs);
+            return balance(lhs);
+        }
+
+        node_ptr middle = nullptr;
+        rhs = remove_min(rhs, middle);
+        middle->left = lhs;
+        middle->right = rhs;
+        return balance(middle);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::insert_min(node_ptr subtree, node_ptr node) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            node->left = nullptr;
+            node->right = nullptr;
+            return update(node);
+        }
+
+        subtree->left = insert_min(subtree->left, node);
+        return balance(subtree);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::insert_max(node_ptr subtree, node_ptr node) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            node->left = nullptr;
+            node->right = nullptr;
+            return update(node);
+        }
+
+        subtree->right = insert_max(subtree->right, node);
+        return balance(subtree);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::remove_min(node_ptr subtree, node_ptr& node) noexcept
+    {
+        if (subtree->left == nullptr)
+        {
+            node = subtree;
+            return subtree->right;
+        }
+
+        subtree->left = remove_min(subtree->left, node);
+        return balance(subtree);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::split_result
+    weight_balanced<Key, Compare>::split_nodes(node_ptr subtree, const key_type& key) const
+    {
+        if (subtree == nullptr)
+        {
+            return {nullptr, nullptr, nullptr};
+        }
+
+        if (key_cmp(key, subtree->value))
+        {
+            auto [lhs, found, rhs] = split_nodes(subtree->left, key);
+            return {lhs, found, link(rhs, subtree, subtree->right)};
+        }
+        if (key_cmp(subtree->value, key))
+        {
+            auto [lhs, found, rhs] = split_nodes(subtree->right, key);
+            return {link(subtree->left, subtree, lhs), found, rhs};
+        }
+
+        node_ptr lhs = subtree->left;
+        node_ptr rhs = subtree->right;
+        subtree->left = nullptr;
+        subtree->right = nullptr;
+        return {lhs, update(subtree), rhs};
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::insert_node(node_ptr subtree, node_ptr& node)
+    {
+        if (subtree == nullptr)
+        {
+            return node;
+        }
+
+        if (key_cmp(node->value, subtree->value))
+        {
+            subtree->left = insert_node(subtree->left, node);
+        }
+        else if (key_cmp(subtree->value, node->value))
+        {
+            subtree->right = insert_node(subtree->right, node);
+        }
+        else
+        {
+            // the key is already there
+            delete node;
+            node = subtree;
+            return subtree;
+        }
+
+        return balance(subtree);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::erase_node(node_ptr subtree, const key_type& key)
+    {
+        if (subtree == nullptr)
+        {   // no such key found
+            return nullptr;
+        }
+
+        if (key_cmp(key, subtree->value))
+        {
+            subtree->left = erase_node(subtree->left, key);
+        }
+        else if (key_cmp(subtree->value, key))
+        {
+            subtree->right = erase_node(subtree->right, key);
+        }
+        else
+        {
+            node_ptr lhs = subtree->left;
+            node_ptr rhs = subtree->right;
+            delete subtree;
+            return join_nodes(lhs, rhs);
+        }
+
+        return balance(subtree);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::unite_nodes(node_ptr lhs, node_ptr rhs, thread_pool* executor) const
+    {
+        if (lhs == nullptr)
+        {
+            return rhs;
+        }
+        if (rhs == nullptr)
+        {
+            return lhs;
+        }
+
+        const std::size_t work = lhs->size + rhs->size;
+        const split_result rhs_split = split_nodes(rhs, lhs->value);
+        delete rhs_split.found;
+
+        node_ptr lhs_less = lhs->left;
+        node_ptr lhs_greater = lhs->right;
+
+        const auto result = detail::fork_join(
+                work >= parallel_cutoff ? executor : nullptr,
+                [&]() { return unite_nodes(lhs_less, rhs_split.lhs, executor); },
+                [&]() { return unite_nodes(lhs_greater, rhs_split.rhs, executor); });
+
+        return link(result.first, lhs, result.second);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::intersect_nodes(node_ptr lhs, node_ptr rhs, thread_pool* executor) const
+    {
+        if (lhs == nullptr || rhs == nullptr)
+        {
+            destroy(lhs);
+            destroy(rhs);
+            return nullptr;
+        }
+
+        const std::size_t work = lhs->size + rhs->size;
+        const split_result rhs_split = split_nodes(rhs, lhs->value);
+
+        node_ptr lhs_less = lhs->left;
+        node_ptr lhs_greater = lhs->right;
+
+        const auto result = detail::fork_join(
+                work >= parallel_cutoff ? executor : nullptr,
+                [&]() { return intersect_nodes(lhs_less, rhs_split.lhs, executor); },
+                [&]() { return intersect_nodes(lhs_greater, rhs_split.rhs, executor); });
+
+        if (rhs_split.found != nullptr)
+        {
+            delete rhs_split.found;
+            return link(result.first, lhs, result.second);
+        }
+
+        delete lhs;
+        return join_nodes(result.first, result.second);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::subtract_nodes(node_ptr lhs, node_ptr rhs, thread_pool* executor) const
+    {
+        if (lhs == nullptr || rhs == nullptr)
+        {
+            destroy(rhs);
+            return lhs;
+        }
+
+        const std::size_t work = lhs->size + rhs->size;
+        const split_result lhs_split = split_nodes(lhs, rhs->value);
+        delete lhs_split.found;
+
+        node_ptr rhs_less = rhs->left;
+        node_ptr rhs_greater = rhs->right;
+        delete rhs;
+
+        const auto result = detail::fork_join(
+                work >= parallel_cutoff ? executor : nullptr,
+                [&]() { return subtract_nodes(lhs_split.lhs, rhs_less, executor); },
+                [&]() { return subtract_nodes(lhs_split.rhs, rhs_greater, executor); });
+
+        return join_nodes(result.first, result.second);
+    }
+
+    template <typename Key, typename Compare>
+    typename weight_balanced<Key, Compare>::node_ptr
+    weight_balanced<Key, Compare>::select_node(std::size_t index) const noexcept
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            const std::size_t lhs_size = size_of(current->left);
+            if (index < lhs_size)
+            {
+                current = current->left;
+            }
+            else if (index == lhs_size)
+            {
+                break;
+            }
+            else
+            {
+                index -= lhs_size + 1;
+                current = current->right;
+            }
+        }
+
+        return current;
+    }
+
+    template <typename Key, typename Compare>
+    void weight_balanced<Key, Compare>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left);
+        destroy(subtree->right);
+        delete subtree;
+    }
+
+} // namespace tree
@@ -0,0 +1,344 @@
+#pragma once
+
+namespace tree
+{
+    ////////////////////////
+    //   CONST ITERATOR   //
+    ////////////////////////
+
+    template <typename Key, typename Compare>
+    weighted_static<Key, Compare>::const_iterator::const_iterator(const self_type* owner, std::size_t position)
+        : owner{owner}, position{position}
+    { }
+
+    template <typename Key, typename Compare>
+    const Key& weighted_static<Key, Compare>::const_iterator::operator * () const
+    {
+        return owner->nodes[owner->in_order[position]].key;
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator&
+    weighted_static<Key, Compare>::const_iterator::operator ++ ()
+    {
+        position++;
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator
+    weighted_static<Key, Compare>::const_iterator::operator ++ (int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator&
+    weighted_static<Key, Compare>::const_iterator::operator -- ()
+    {
+        position--;
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator
+    weighted_static<Key, Compare>::const_iterator::operator -- (int)
+    {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    template <typename Key, typename Compare>
+    bool weighted_static<Key, Compare>::const_iterator::operator == (const const_iterator& other) const
+    {
+        return owner == other.owner && position == other.position;
+    }
+
+    template <typename Key, typename Compare>
+    bool weighted_static<Key, Compare>::const_iterator::operator != (const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    //////////////////////
+    //   CONSTRUCTION   //
+    //////////////////////
+
+    template <typename Key, typename Compare>
+    weighted_static<Key, Compare>::weighted_static() = default;
+
+    template <typename Key, typename Compare>
+    template <typename InputIt>
+    weighted_static<Key, Compare>::weighted_static(InputIt first, InputIt last)
+    {
+        std::vector<std::pair<key_type, weight_type>> weights;
+        for (; first != last; ++first)
+        {
+            weights.emplace_back(first->first, static_cast<weight_type>(first->second));
+        }
+        build(std::move(weights));
+    }
+
+    template <typename Key, typename Compare>
+    weighted_static<Key, Compare>::weighted_static(std::initializer_list<std::pair<key_type, weight_type>> data)
+    {
+        build(std::vector<std::pair<key_type, weight_type>>(data));
+    }
+
+    template <typename Key, typename Compare>
+    void weighted_static<Key, Compare>::build(std::vector<std::pair<key_type, weight_type>> weights)
+    {
+        auto less = [this](const auto& lhs, const auto& rhs) { return key_cmp(lhs.first, rhs.first); };
+        std::stable_sort(weights.begin(), weights.end(), less);
+
+        // merge equal keys
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < weights.size(); i++)
+        {
+            if (weights[i].second < 0)
+            {
+                throw std::invalid_argument("weights cannot be negative");
+            }
+
+            if (count > 0 && !key_cmp(weights[count - 1].first, weights[i].first))
+            {
+                weights[count - 1].second += weights[i].second;
+            }
+            else
+            {
+                weights[count++] = std::move(weights[i]);
+            }
+        }
+        weights.resize(count);
+
+        if (count >= none)
+        {
+            throw std::length_error("too many keys for 32-bit node indices");
+        }
+
+        // prefix[i] is the total weight of the keys before the i-th one
+        std::vector<weight_type> prefix(count + 1, 0);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            prefix[i + 1] = prefix[i] + weights[i].second;
+        }
+
+        nodes.clear();
+        nodes.reserve(count);
+        in_order.assign(count, none);
+        weighted_depth = 0;
+
+        struct range
+        {
+            std::size_t lhs;
+            std::size_t rhs;
+            std::uint32_t parent;
+            bool is_left_child;
+            std::size_t depth;
+        };
+
+        // ranges of a preorder walk, the left one is taken first; a loop instead of
+        // recursion, since very skewed weights make the tree as deep as it is long
+        std::vector<range> stack;
+        stack.push_back({0, count, none, false, 1});
+        while (!stack.empty())
+        {
+            const range current = stack.back();
+            stack.pop_back();
+            if (current.lhs == current.rhs)
+            {
+                continue;
+            }
+
+            std::size_t root = current.lhs + (current.rhs - current.lhs) / 2;
+            const weight_type total = prefix[current.rhs] - prefix[current.lhs];
+            if (total > 0)
+            {
+                // the first key whose interval reaches the middle, both sides keep at most half
+                const weight_type middle = prefix[current.lhs] + total / 2;
+                const auto reached = std::lower_bound(prefix.begin() + current.lhs + 1,
+                                                      prefix.begin() + current.rhs + 1, middle);
+                root = static_cast<std::size_t>(reached - prefix.begin()) - 1;
+            }
+
+            const auto index = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back({std::move(weights[root].first), none, none, static_cast<std::uint32_t>(root)});
+            in_order[root] = index;
+            weighted_depth += weights[root].second * static_cast<double>(current.depth);
+
+            if (current.parent != none)
+            {
+                (current.is_left_child ? nodes[current.parent].left : nodes[current.parent].right) = index;
+            }
+
+            stack.push_back({root + 1, current.rhs, index, false, current.depth + 1});
+            stack.push_back({current.lhs, root, index, true, current.depth + 1});
+        }
+
+        if (prefix[count] > 0)
+        {
+            weighted_depth /= prefix[count];
+        }
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator weighted_static<Key, Compare>::begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator weighted_static<Key, Compare>::cbegin() const
+    {
+        return begin();
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator weighted_static<Key, Compare>::end() const
+    {
+        return const_iterator(this, size());
+    }
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator weighted_static<Key, Compare>::cend() const
+    {
+        return end();
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool weighted_static<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t weighted_static<Key, Compare>::size() const noexcept
+    {
+        return nodes.size();
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename weighted_static<Key, Compare>::const_iterator
+    weighted_static<Key, Compare>::find(const key_type& value) const
+    {
+        const std::uint32_t index = search(value);
+        return index != none ? const_iterator(this, nodes[index].position) : end();
+    }
+
+    template <typename Key, typename Compare>
+    bool weighted_static<Key, Compare>::contains(const key_type& value) const
+    {
+        return search(value) != none;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t weighted_static<Key, Compare>::depth(const key_type& value) const
+    {
+        std::size_t depth = 1;
+        std::uint32_t index = nodes.empty() ? none : 0;
+        while (index != none)
+        {
+            const node& current = nodes[index];
+            if (key_cmp(value, current.key))
+            {
+                index = current.left;
+            }
+            else if (key_cmp(current.key, value))
+            {
+                index = current.right;
+            }
+            else
+            {
+                return depth;
+            }
+            depth++;
+        }
+        return 0;
+    }
+
+    template <typename Key, typename Compare>
+    double weighted_static<Key, Compare>::expected_depth() const noexcept
+    {
+        return weighted_depth;
+    }
+
+    template <typename Key, typename Compare>
+    bool weighted_static<Key, Compare>::is_search_tree() const
+    {
+        if (nodes.empty())
+        {
+            return in_order.empty();
+        }
+
+        // in-order walk from the root has to meet the nodes in key order
+        std::vector<std::uint32_t> stack;
+        std::size_t visited = 0;
+        std::uint32_t index = 0;
+        while (index != none || !stack.empty())
+        {
+            while (index != none)
+            {
+                if (index >= nodes.size() || stack.size() >= nodes.size())
+                {
+                    return false;
+                }
+                stack.push_back(index);
+                index = nodes[index].left;
+            }
+            index = stack.back();
+            stack.pop_back();
+
+            if (visited >= nodes.size() || in_order[visited] != index || nodes[index].position != visited)
+            {
+                return false;
+            }
+            if (visited > 0 && !key_cmp(nodes[in_order[visited - 1]].key, nodes[index].key))
+            {
+                return false;
+            }
+
+            visited++;
+            index = nodes[index].right;
+        }
+        return visited == nodes.size();
+    }
+
+    template <typename Key, typename Compare>
+    std::uint32_t weighted_static<Key, Compare>::search(const key_type& value) const
+    {
+        std::uint32_t index = nodes.empty() ? none : 0;
+        while (index != none)
+        {
+            const node& current = nodes[index];
+            if (key_cmp(value, current.key))
+            {
+                index = current.left;
+            }
+            else if (key_cmp(current.key, value))
+            {
+                index = current.right;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return index;
+    }
+
+} // namespace tree
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <type_traits>
+
+#include "intrinsics.hpp"
+
+namespace tree::detail
+{
+    /////////////////////////////
+    //   WORK-STEALING DEQUE   //
+    /////////////////////////////
+
+    // Chase-Lev deque of pointers. The owner pushes and pops at the bottom like a stack, any
+    // other thread steals from the top, so the owner keeps working on the most recent, smallest
+    // task while thieves take the oldest, largest one. Only the last element is ever contended.
+    //
+    // The ring has a power of two slots and doubles when full. Outgrown rings are kept until the
+    // deque goes, as a thief may still be reading one. Every access to the indices is
+    // sequentially consistent, the plain fences of the original are lost on thread sanitizers.
+    template <typename T>
+    class work_stealing_deque
+    {
+        struct ring
+        {
+            explicit ring(std::int64_t capacity)
+                : capacity{capacity},
+                  slots{new std::atomic<T*>[static_cast<std::size_t>(capacity)]}
+            { }
+
+            T* load(std::int64_t index) const noexcept
+            {
+                return slots[static_cast<std::size_t>(index & (capacity - 1))].load(std::memory_order_relaxed);
+            }
+
+            void store(std::int64_t index, T* value) noexcept
+            {
+                slots[static_cast<std::size_t>(index & (capacity - 1))].store(value, std::memory_order_relaxed);
+            }
+
+            const std::int64_t capacity;
+            std::unique_ptr<std::atomic<T*>[]> slots;
+        };
+
+    public:
+        explicit work_stealing_deque(std::int64_t capacity = 64)
+        {
+            rings.push_back(std::make_unique<ring>(capacity));
+            current.store(rings.back().get(), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator = (const work_stealing_deque&) = delete;
+
+        // owner only
+        void push(T* value)
+        {
+            const std::int64_t b = bottom.load(std::memory_order_relaxed);
+            const std::int64_t t = top.load(std::memory_order_acquire);
+            ring* slots = current.load(std::memory_order_relaxed);
+
+            if (b - t >= slots->capacity)
+            {
+                slots = grow(slots, t, b);
+            }
+
+            slots->store(b, value);
+            bottom.store(b + 1, std::memory_order_seq_cst);
+        }
+
+        // owner only; nullptr if the deque is empty or a thief took the last element
+        T* pop() noexcept
+        {
+            const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            ring* slots = current.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_seq_cst);
+
+            std::int64_t t = top.load(std::memory_order_seq_cst);
+            if (t > b)
+            {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* value = slots->load(b);
+            if (t == b)
+            {
+                // the last element, a thief may be after it too
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    value = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return value;
+        }
+
+        // any thread; nullptr if the deque is empty or another thread won the race
+        T* steal() noexcept
+        {
+            std::int64_t t = top.load(std::memory_order_seq_cst);
+            const std::int64_t b = bottom.load(std::memory_order_seq_cst);
+            if (t >= b)
+            {
+                return nullptr;
+            }
+
+            T* value = current.load(std::memory_order_acquire)->load(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return value;
+        }
+
+        // a hint, exact only for the owner
+        bool empty() const noexcept
+        {
+            return bottom.load(std::memory_order_seq_cst) <= top.load(std::memory_order_seq_cst);
+        }
+
+    private:
+        ring* grow(ring* slots, std::int64_t t, std::int64_t b)
+        {
+            rings.push_back(std::make_unique<ring>(2 * slots->capacity));
+            ring* grown = rings.back().get();
+            for (std::int64_t index = t; index < b; index++)
+            {
+                grown->store(index, slots->load(index));
+            }
+            current.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+    private:
+        alignas(cache_line_size) std::atomic<std::int64_t> top{0};
+        alignas(cache_line_size) std::atomic<std::int64_t> bottom{0};
+        std::atomic<ring*> current{nullptr};
+
+        // owner only, the current ring and every one it outgrew
+        std::vector<std::unique_ptr<ring>> rings;
+    };
+
+    ///////////////
+    //   TASKS   //
+    ///////////////
+
+    // a task as the executor sees it, owned by whoever submits it
+    class pool_task
+    {
+    public:
+        virtual void execute() noexcept = 0;
+
+    protected:
+        ~pool_task() = default;
+    };
+
+    // the value or the exception a function ended with, handed over to the thread that joins it
+    template <typename Result>
+    class task_result
+    {
+    public:
+        template <typename Function>
+        void compute(Function& function) noexcept
+        {
+            try
+            {
+                if constexpr (std::is_void_v<Result>)
+                {
+                    function();
+                }
+                else
+                {
+                    value.emplace(function());
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+
+        Result get()
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            if constexpr (!std::is_void_v<Result>)
+            {
+                return std::move(*value);
+            }
+        }
+
+    private:
+        struct nothing { };
+
+        std::optional<std::conditional_t<std::is_void_v<Result>, nothing, Result>> value;
+        std::exception_ptr error;
+    };
+
+    // the left half of a fork, joined by spinning on the flag
+    template <typename Function>
+    class forked_task final : public pool_task
+    {
+    public:
+        using result_type = std::invoke_result_t<Function&>;
+
+        explicit forked_task(Function& function) noexcept
+            : function{function}
+        { }
+
+        void execute() noexcept override
+        {
+            result.compute(function);
+            is_done.store(true, std::memory_order_release);
+        }
+
+        bool done() const noexcept
+        {
+            return is_done.load(std::memory_order_acquire);
+        }
+
+        result_type get()
+        {
+            return result.get();
+        }
+
+    private:
+        Function& function;
+        task_result<result_type> result;
+        std::atomic<bool> is_done{false};
+    };
+
+} // namespace tree::detail
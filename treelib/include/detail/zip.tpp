@@ -0,0 +1,360 @@
+#pragma once
+
+namespace tree
+{
+    template <typename Key, typename Compare>
+    zip<Key, Compare>::zip() = default;
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>::zip(const std::initializer_list<key_type>& data)
+    {
+        for (const auto& element : data)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>::zip(std::initializer_list<key_type>&& data)
+    {
+        for (auto&& element : data)
+        {
+            this->insert(std::move(element));
+        }
+    }
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>::zip(const self_type& other)
+    {
+        for (const auto& element : other)
+        {
+            this->insert(element);
+        }
+    }
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>::zip(self_type&& other) noexcept
+    {
+        std::swap(this->head, other.head);
+        std::swap(this->m_size, other.m_size);
+    }
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>::~zip()
+    {
+        this->clear();
+    }
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>& zip<Key, Compare>::operator = (const self_type& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            for (const auto& element : other)
+            {
+                this->insert(element);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Compare>
+    zip<Key, Compare>& zip<Key, Compare>::operator = (self_type&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(this->head, other.head);
+            std::swap(this->m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    ///////////////////
+    //   ITERATORS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::iterator zip<Key, Compare>::begin()
+    {
+        return iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::const_iterator zip<Key, Compare>::begin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::const_iterator zip<Key, Compare>::cbegin() const
+    {
+        return const_iterator(head);
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::iterator zip<Key, Compare>::end()
+    {
+        return iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::const_iterator zip<Key, Compare>::end() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::const_iterator zip<Key, Compare>::cend() const
+    {
+        return const_iterator(head, std::make_optional<node_ptr>(nullptr));
+    }
+
+    //////////////////
+    //   CAPACITY   //
+    //////////////////
+
+    template <typename Key, typename Compare>
+    bool zip<Key, Compare>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <typename Key, typename Compare>
+    std::size_t zip<Key, Compare>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    ///////////////////
+    //   MODIFIERS   //
+    ///////////////////
+
+    template <typename Key, typename Compare>
+    void zip<Key, Compare>::clear() noexcept
+    {
+        destroy(head);
+        head = nullptr;
+        m_size = 0;
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::node_ptr zip<Key, Compare>::insert(key_type key)
+    {
+        const std::uint8_t rank = get_random_rank();
+
+        // step 1: descend while the nodes outrank the new one
+        node_ptr* link = &head;
+        node_ptr current = head;
+        while (current != nullptr &&
+               (rank < current->rank || (rank == current->rank && key_cmp(current->value, key))))
+        {
+            if (key_cmp(key, current->value))
+            {
+                link = &current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                link = &current->right;
+            }
+            else
+            {
+                return current;
+            }
+            current = *link;
+        }
+
+        // the rest of the search path is what gets unzipped, the key may be on it
+        for (node_ptr below = current; below != nullptr;)
+        {
+            if (key_cmp(key, below->value))
+            {
+                below = below->left;
+            }
+            else if (key_cmp(below->value, key))
+            {
+                below = below->right;
+            }
+            else
+            {
+                return below;
+            }
+        }
+
+        auto node = new node_type(std::move(key), rank);
+        *link = node;
+        m_size++;
+
+        // step 2: unzip, nodes of the path less than the key form the left spine
+        // of the new node's left subtree, the greater ones the right spine of its right subtree
+        node_ptr* lhs_link = &node->left;
+        node_ptr* rhs_link = &node->right;
+        while (current != nullptr)
+        {
+            if (key_cmp(current->value, node->value))
+            {
+                *lhs_link = current;
+                lhs_link = &current->right;
+                current = current->right;
+            }
+            else
+            {
+                *rhs_link = current;
+                rhs_link = &current->left;
+                current = current->left;
+            }
+        }
+        *lhs_link = nullptr;
+        *rhs_link = nullptr;
+
+        return node;
+    }
+
+    template <typename Key, typename Compare>
+    void zip<Key, Compare>::erase(const key_type& key)
+    {
+        node_ptr* link = &head;
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(key, current->value))
+            {
+                link = &current->left;
+            }
+            else if (key_cmp(current->value, key))
+            {
+                link = &current->right;
+            }
+            else
+            {
+                break;
+            }
+            current = *link;
+        }
+
+        if (current == nullptr)
+        {
+            return;
+        }
+
+        // zip the right spine of the left subtree with the left spine of the right one,
+        // taking the higher rank first and the left side on ties
+        node_ptr lhs = current->left;
+        node_ptr rhs = current->right;
+        while (lhs != nullptr && rhs != nullptr)
+        {
+            if (lhs->rank >= rhs->rank)
+            {
+                *link = lhs;
+                link = &lhs->right;
+                lhs = lhs->right;
+            }
+            else
+            {
+                *link = rhs;
+                link = &rhs->left;
+                rhs = rhs->left;
+            }
+        }
+        *link = lhs != nullptr ? lhs : rhs;
+
+        delete current;
+        m_size--;
+    }
+
+    /////////////////
+    //   LOOK UP   //
+    /////////////////
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::iterator zip<Key, Compare>::find(const key_type& value)
+    {
+        return iterator(head, find_node(value));
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::const_iterator zip<Key, Compare>::find(const key_type& value) const
+    {
+        return const_iterator(head, find_node(value));
+    }
+
+    template <typename Key, typename Compare>
+    static_set<Key, Compare> zip<Key, Compare>::freeze() const
+    {
+        return static_set<key_type, key_compare>(begin(), end());
+    }
+
+    template <typename Key, typename Compare>
+    [[nodiscard]] bool zip<Key, Compare>::is_zip() const noexcept
+    {
+        return check(head, nullptr, nullptr);
+    }
+
+    template <typename Key, typename Compare>
+    typename zip<Key, Compare>::node_ptr zip<Key, Compare>::find_node(const key_type& value) const
+    {
+        node_ptr current = head;
+        while (current != nullptr)
+        {
+            if (key_cmp(value, current->value))
+            {
+                current = current->left;
+            }
+            else if (key_cmp(current->value, value))
+            {
+                current = current->right;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return current;
+    }
+
+    template <typename Key, typename Compare>
+    std::uint8_t zip<Key, Compare>::get_random_rank()
+    {
+        return static_cast<std::uint8_t>(detail::count_trailing_ones(gen()));
+    }
+
+    template <typename Key, typename Compare>
+    bool zip<Key, Compare>::check(node_ptr subtree, const key_type* lower, const key_type* upper) const noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return true;
+        }
+
+        const key_type& key = subtree->value;
+        if ((lower != nullptr && !key_cmp(*lower, key)) || (upper != nullptr && !key_cmp(key, *upper)))
+        {
+            return false;
+        }
+
+        if (subtree->left != nullptr && subtree->left->rank >= subtree->rank)
+        {
+            return false;
+        }
+        if (subtree->right != nullptr && subtree->right->rank > subtree->rank)
+        {
+            return false;
+        }
+
+        return check(subtree->left, lower, &key) && check(subtree->right, &key, upper);
+    }
+
+    template <typename Key, typename Compare>
+    void zip<Key, Compare>::destroy(node_ptr subtree) noexcept
+    {
+        if (subtree == nullptr)
+        {
+            return;
+        }
+
+        destroy(subtree->left);
+        destroy(subtree->right);
+        delete subtree;
+    }
+
+} // namespace tree
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "detail/work_stealing.hpp"
+
+namespace tree
+{
+    // Work-stealing executor for the fork-join parallelism of bulk operations. Every worker
+    // owns a Chase-Lev deque: a fork pushes its left half there and runs the right half at
+    // once, so a worker stays on its own part of a tree while idle workers steal the largest
+    // pending halves. A join whose half was stolen keeps stealing until the thief is done
+    // instead of blocking. Idle workers spin for a while and then sleep until work shows up.
+    //
+    // Threads that are not workers of the pool hand their job over and block until it is
+    // done. Exceptions thrown by a task reach the thread that joins it. The pool has to
+    // outlive every job it runs.
+    class thread_pool
+    {
+        struct alignas(detail::cache_line_size) worker
+        {
+            detail::work_stealing_deque<detail::pool_task> deque;
+            std::thread thread;
+        };
+
+        // a job from outside, the submitter sleeps until it is done
+        template <typename Function>
+        class root_task final : public detail::pool_task
+        {
+        public:
+            using result_type = std::invoke_result_t<Function&>;
+
+            root_task(Function& function, thread_pool& pool) noexcept
+                : function{function}, pool{pool}
+            { }
+
+            void execute() noexcept override
+            {
+                result.compute(function);
+
+                // the submitter may destroy the task as soon as it sees the flag
+                std::lock_guard lock(pool.completion_mutex);
+                is_done = true;
+                pool.completion.notify_all();
+            }
+
+            result_type wait()
+            {
+                std::unique_lock lock(pool.completion_mutex);
+                pool.completion.wait(lock, [this]() { return is_done; });
+                lock.unlock();
+                return result.get();
+            }
+
+        private:
+            Function& function;
+            thread_pool& pool;
+            detail::task_result<result_type> result;
+            bool is_done = false;
+        };
+
+    public:
+        explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+        {
+            const std::size_t count = std::max<std::size_t>(threads, 1);
+
+            workers.reserve(count);
+            for (std::size_t index = 0; index < count; index++)
+            {
+                workers.push_back(std::make_unique<worker>());
+            }
+            for (std::size_t index = 0; index < count; index++)
+            {
+                workers[index]->thread = std::thread([this, index]() { work(index); });
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator = (const thread_pool&) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard lock(sleep_mutex);
+                is_stopping.store(true);
+            }
+            wake.notify_all();
+
+            for (auto& current : workers)
+            {
+                current->thread.join();
+            }
+        }
+
+        // one pool for the whole program with a worker per core, started on first use
+        static thread_pool& shared()
+        {
+            static thread_pool pool;
+            return pool;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return workers.size();
+        }
+
+        // true on the workers of this pool
+        bool is_worker() const noexcept
+        {
+            return current_pool == this;
+        }
+
+        // runs the function on a worker and returns what it returns
+        template <typename Function>
+        std::invoke_result_t<Function&> run(Function&& function)
+        {
+            if (is_worker())
+            {
+                return function();
+            }
+
+            root_task<std::remove_reference_t<Function>> task(function, *this);
+            {
+                std::lock_guard lock(injection_mutex);
+                injected.push_back(&task);
+                injected_count.fetch_add(1);
+            }
+            notify();
+            return task.wait();
+        }
+
+        // Runs both tasks, possibly in parallel, and returns both results as a pair or nothing
+        // if both return nothing. Called from outside, the fork moves onto a worker first.
+        template <typename LhsTask, typename RhsTask>
+        auto fork_join(LhsTask&& lhs_task, RhsTask&& rhs_task)
+        {
+            static_assert(std::is_void_v<std::invoke_result_t<LhsTask&>> ==
+                          std::is_void_v<std::invoke_result_t<RhsTask&>>,
+                          "either both tasks or none of them return a value");
+
+            if (!is_worker())
+            {
+                return run([&]() { return fork_join_here(lhs_task, rhs_task); });
+            }
+            return fork_join_here(lhs_task, rhs_task);
+        }
+
+    private:
+        // searches before a worker goes to sleep
+        static constexpr std::size_t idle_spins = 64;
+
+        // fork_join on the worker that calls it
+        template <typename LhsTask, typename RhsTask>
+        auto fork_join_here(LhsTask& lhs_task, RhsTask& rhs_task)
+        {
+            using lhs_type = std::invoke_result_t<LhsTask&>;
+            using rhs_type = std::invoke_result_t<RhsTask&>;
+
+            worker& self = *workers[current_index];
+            detail::forked_task<LhsTask> lhs(lhs_task);
+            self.deque.push(&lhs);
+            notify();
+
+            detail::task_result<rhs_type> rhs;
+            rhs.compute(rhs_task);
+
+            // everything pushed since was popped by the nested joins, so lhs is at the bottom
+            // unless a thief took it, and then nothing older is left below it either
+            if (self.deque.pop() == &lhs)
+            {
+                lhs.execute();
+            }
+            else
+            {
+                while (!lhs.done())
+                {
+                    if (detail::pool_task* task = steal(current_index); task != nullptr)
+                    {
+                        task->execute();
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            if constexpr (std::is_void_v<lhs_type>)
+            {
+                lhs.get();
+                rhs.get();
+            }
+            else
+            {
+                auto lhs_result = lhs.get();
+                return std::make_pair(std::move(lhs_result), rhs.get());
+            }
+        }
+
+        void work(std::size_t index)
+        {
+            current_pool = this;
+            current_index = index;
+
+            while (true)
+            {
+                detail::pool_task* task = find_task(index);
+                for (std::size_t spin = 0; task == nullptr && spin < idle_spins; spin++)
+                {
+                    std::this_thread::yield();
+                    task = find_task(index);
+                }
+
+                if (task != nullptr)
+                {
+                    task->execute();
+                }
+                else if (!sleep())
+                {
+                    return;
+                }
+            }
+        }
+
+        detail::pool_task* find_task(std::size_t index)
+        {
+            if (detail::pool_task* task = workers[index]->deque.pop(); task != nullptr)
+            {
+                return task;
+            }
+
+            if (injected_count.load() != 0)
+            {
+                std::lock_guard lock(injection_mutex);
+                if (!injected.empty())
+                {
+                    detail::pool_task* task = injected.front();
+                    injected.pop_front();
+                    injected_count.fetch_sub(1);
+                    return task;
+                }
+            }
+
+            return steal(index);
+        }
+
+        // one pass over the other workers, starting from the next one
+        detail::pool_task* steal(std::size_t index) noexcept
+        {
+            for (std::size_t offset = 1; offset < workers.size(); offset++)
+            {
+                const std::size_t victim = (index + offset) % workers.size();
+                if (detail::pool_task* task = workers[victim]->deque.steal(); task != nullptr)
+                {
+                    return task;
+                }
+            }
+            return nullptr;
+        }
+
+        bool has_work() const noexcept
+        {
+            if (injected_count.load() != 0)
+            {
+                return true;
+            }
+            return std::any_of(workers.begin(), workers.end(), [](const auto& current)
+            {
+                return !current->deque.empty();
+            });
+        }
+
+        // false once the pool is stopping
+        bool sleep()
+        {
+            std::unique_lock lock(sleep_mutex);
+
+            // announced before the last look, so a push after it sees the sleeper
+            sleeping.fetch_add(1);
+            if (!is_stopping.load() && !has_work())
+            {
+                const std::uint64_t signal = wake_signal;
+                wake.wait(lock, [&]() { return wake_signal != signal || is_stopping.load(); });
+            }
+            sleeping.fetch_sub(1);
+
+            return !is_stopping.load();
+        }
+
+        void notify()
+        {
+            if (sleeping.load() != 0)
+            {
+                {
+                    std::lock_guard lock(sleep_mutex);
+                    wake_signal++;
+                }
+                wake.notify_one();
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<worker>> workers;
+
+        std::mutex injection_mutex;
+        std::deque<detail::pool_task*> injected;
+        std::atomic<std::size_t> injected_count{0};
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        std::uint64_t wake_signal = 0;
+        std::atomic<std::size_t> sleeping{0};
+        std::atomic<bool> is_stopping{false};
+
+        std::mutex completion_mutex;
+        std::condition_variable completion;
+
+        inline static thread_local thread_pool* current_pool = nullptr;
+        inline static thread_local std::size_t current_index = 0;
+    };
+
+    ////////////////////////////
+    //   EXECUTION POLICIES   //
+    ////////////////////////////
+
+    // runs a bulk operation on the calling thread
+    struct sequenced_policy
+    { };
+
+    // runs a bulk operation on a work-stealing pool, the shared one unless told otherwise
+    class parallel_policy
+    {
+    public:
+        constexpr parallel_policy() noexcept = default;
+
+        // the same policy on the given pool
+        constexpr parallel_policy on(thread_pool& pool) const noexcept
+        {
+            parallel_policy policy;
+            policy.pool = &pool;
+            return policy;
+        }
+
+        thread_pool& executor() const
+        {
+            return pool != nullptr ? *pool : thread_pool::shared();
+        }
+
+    private:
+        thread_pool* pool = nullptr;
+    };
+
+    inline constexpr sequenced_policy seq{};
+    inline constexpr parallel_policy par{};
+
+    template <typename T>
+    inline constexpr bool is_execution_policy_v = std::is_same_v<std::decay_t<T>, sequenced_policy> ||
+                                                  std::is_same_v<std::decay_t<T>, parallel_policy>;
+
+} // namespace tree
+
+namespace tree::detail
+{
+    // the pool a bulk operation forks on, none for a sequential one
+    inline thread_pool* executor_of(const sequenced_policy&) noexcept
+    {
+        return nullptr;
+    }
+
+    inline thread_pool* executor_of(const parallel_policy& policy)
+    {
+        return &policy.executor();
+    }
+
+    // runs both tasks on the pool if there is one, one after the other otherwise;
+    // returns what thread_pool::fork_join would
+    template <typename LhsTask, typename RhsTask>
+    auto fork_join(thread_pool* executor, LhsTask&& lhs_task, RhsTask&& rhs_task)
+    {
+        if (executor != nullptr)
+        {
+            return executor->fork_join(lhs_task, rhs_task);
+        }
+
+        if constexpr (std::is_void_v<std::invoke_result_t<LhsTask&>>)
+        {
+            lhs_task();
+            rhs_task();
+        }
+        else
+        {
+            auto lhs = lhs_task();
+            auto rhs = rhs_task();
+            return std::make_pair(std::move(lhs), std::move(rhs));
+        }
+    }
+
+} // namespace tree::detail
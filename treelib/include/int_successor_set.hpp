@@ -0,0 +1,143 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <initializer_list>
+
+#include "detail/veb.hpp"
+#include "static_set.hpp"
+
+namespace tree
+{
+    // Set of integers from the universe [0, 2^Bits), laid out as a van Emde Boas tree over
+    // bitmap leaves of 2^12 values: insert, erase, contains, successor and predecessor take
+    // O(log Bits) steps of a few bit operations each, independent of the number of keys.
+    // Fits dense ids best; sparse keys pay for a table of 2^(Bits/2) clusters at the top.
+    template <unsigned Bits = 32>
+    class int_successor_set
+    {
+        static_assert(Bits >= 1 && Bits <= 32, "the universe must fit into 32 bits");
+
+    public:
+        using key_type = std::uint32_t;
+        using key_compare = std::less<key_type>;
+        using self_type = tree::int_successor_set<Bits>;
+
+        static constexpr std::uint64_t universe_size = std::uint64_t(1) << Bits;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            const_iterator(const self_type* owner, std::uint64_t value);
+
+            const value_type& operator * () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            const_iterator& operator -- ();
+            const_iterator operator -- (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            const self_type* owner;
+            std::uint64_t value; // detail::veb_none at the end
+            key_type key;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+    public:
+        int_successor_set();
+
+        int_successor_set(const std::initializer_list<key_type>& data);
+        int_successor_set(std::initializer_list<key_type>&& data);
+
+        int_successor_set(const self_type& other);
+        int_successor_set(self_type&& other) noexcept;
+
+        ~int_successor_set() = default;
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        // false if the key was already there, throws std::out_of_range for keys outside the universe
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(key_type key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(key_type value);
+        const_iterator find(key_type value) const;
+
+        // first key not less than the value
+        const_iterator lower_bound(key_type value) const;
+
+        bool contains(key_type value) const noexcept;
+
+        // smallest key greater than the value
+        std::optional<key_type> successor(key_type value) const noexcept;
+
+        // largest key less than the value
+        std::optional<key_type> predecessor(key_type value) const noexcept;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        // summaries match the clusters, cluster bounds match min and max, and the keys add up to size()
+        bool is_veb() const noexcept;
+
+    private:
+        static bool in_universe(key_type value) noexcept;
+
+    private:
+        detail::veb_set<Bits> set;
+        std::size_t m_size = 0;
+    };
+
+} // namespace tree
+
+#include "detail/int_successor_set.tpp"
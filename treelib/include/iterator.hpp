@@ -1,5 +1,9 @@
 #pragma once
 
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
 #include <stack>
 #include <optional>
 
@@ -8,16 +12,21 @@
 namespace tree
 {
     template <typename Node>
-    class NodeIterator : public std::iterator<std::bidirectional_iterator_tag, Node>
+    class NodeIterator
     {
     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
         using value_type = typename Node::value_type;
+        // const-qualified when iterating over const nodes
+        using reference = decltype((std::declval<Node*>()->value));
+        using pointer = std::remove_reference_t<reference>*;
         using self_type = NodeIterator<Node>;
 
     public:
         explicit NodeIterator(Node* head, std::optional<Node*> until = {});
 
-        value_type& operator * ();
+        reference operator * ();
         const value_type& operator * () const;
 
         self_type& operator ++ ();
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <exception>
+#include <optional>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "iterator.hpp"
+#include "static_set.hpp"
+
+#define RB_TREE_DEBUG_ROTATIONS 0
+
+namespace tree
+{
+    // Red-black tree without parent pointers: the path from the root is cached
+    // during the descent, fix-ups do at most two rotations per insert and three per erase.
+    template <typename Key, typename Compare = std::less<Key>>
+    class rb
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeRB<key_type>;
+        using node_ptr = node_type*;
+        using iterator = tree::NodeIterator<node_type>;
+        using const_iterator = tree::NodeIterator<const node_type>;
+
+    public:
+        rb();
+
+        rb(const std::initializer_list<key_type>& data);
+        rb(std::initializer_list<key_type>&& data);
+
+        rb(const rb<key_type, key_compare>& other);
+        rb(rb<key_type, key_compare>&& other) noexcept;
+
+        ~rb();
+
+        rb<key_type, key_compare>& operator = (const rb<key_type, key_compare>& other);
+        rb<key_type, key_compare>& operator = (rb<key_type, key_compare>&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        node_ptr insert(key_type key);
+
+        void erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        bool is_ordered(node_ptr subtree) const noexcept;
+
+        bool is_rb(node_ptr subtree = nullptr) const noexcept;
+
+        // black height of the subtree, -1 if it has a red-red edge or unequal black heights
+        int check_black_height(node_ptr subtree) const noexcept;
+
+    private:
+        ///////////////////
+        //   BALANCING   //
+        ///////////////////
+
+        void fix_insert(node_ptr node);
+
+        void fix_erase(node_ptr node, bool is_left_child);
+
+        [[nodiscard]] node_ptr rotate_left(node_ptr subtree) noexcept;
+
+        [[nodiscard]] node_ptr rotate_right(node_ptr subtree) noexcept;
+
+        void replace_child(node_ptr parent, node_ptr old_child, node_ptr new_child) noexcept;
+
+        static bool is_red(node_ptr node) noexcept;
+
+        void destroy(node_ptr subtree) noexcept;
+
+    private:
+        node_ptr head = nullptr;
+        std::size_t m_size = 0;
+        key_compare key_cmp = { };
+
+        // ancestors of the node being fixed, the root first
+        std::vector<node_ptr> path_cache;
+    };
+
+} // namespace tree
+
+#include "detail/rb.tpp"
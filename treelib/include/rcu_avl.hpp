@@ -0,0 +1,209 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "detail/epoch.hpp"
+#include "iterator.hpp"
+
+namespace tree
+{
+    // AVL tree for read-mostly sharing: readers never lock or write shared memory apart from
+    // their epoch slot, and see a consistent version of the tree. A writer never changes a node
+    // that readers can reach: insert and erase copy the nodes along the search path (and those a
+    // rotation moves), change the copies, publish the new root with one atomic store and retire
+    // the replaced nodes through epoch-based reclamation. Writers are serialized by a mutex.
+    //
+    // Iterators and snapshots pin the epoch while they live, so hold them briefly. clear() is
+    // thread-safe; copying, moving and assignment are not.
+    template <typename Key, typename Compare = std::less<Key>>
+    class rcu_avl
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeAVL<key_type>;
+        using node_ptr = node_type*;
+        using self_type = tree::rcu_avl<key_type, key_compare>;
+
+    private:
+        using guard_type = detail::epoch_domain::guard;
+
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            // the end iterator
+            const_iterator();
+            const_iterator(std::shared_ptr<guard_type> guard, NodeIterator<const node_type> position);
+
+            const value_type& operator * () const;
+            const value_type* operator -> () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            std::shared_ptr<guard_type> guard;
+            NodeIterator<const node_type> position;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+        // one version of the tree, unchanged by later writes for as long as the snapshot lives
+        class snapshot
+        {
+        public:
+            const_iterator begin() const;
+            const_iterator end() const;
+
+            const_iterator find(const key_type& value) const;
+
+            bool contains(const key_type& value) const;
+
+            bool empty() const noexcept;
+
+        private:
+            friend class rcu_avl;
+
+            snapshot(const self_type* owner, std::shared_ptr<guard_type> guard, const node_type* root);
+
+        private:
+            const self_type* owner;
+            std::shared_ptr<guard_type> guard;
+            const node_type* root;
+        };
+
+    public:
+        rcu_avl();
+
+        rcu_avl(const std::initializer_list<key_type>& data);
+        rcu_avl(std::initializer_list<key_type>&& data);
+
+        rcu_avl(const self_type& other);
+        rcu_avl(self_type&& other) noexcept;
+
+        ~rcu_avl();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        // iterates over the version current at the call
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+
+        // exact when no write is in flight
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear();
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        snapshot read() const;
+
+        const_iterator find(const key_type& value) const;
+
+        // lock-free and without allocations
+        bool contains(const key_type& value) const;
+
+        // keys are ordered and balance factors match the heights in the current version;
+        // only meaningful while no other thread writes
+        bool is_avl() const;
+
+    private:
+        //////////////////////
+        //   PATH COPYING   //
+        //////////////////////
+
+        // the new subtree with the key, nullptr if it was there; grew tells if it got higher
+        node_ptr insert_copy(node_ptr subtree, key_type& key, bool& grew);
+
+        // the new subtree without the key, the old one if it was not there
+        node_ptr erase_copy(node_ptr subtree, const key_type& key, bool& shrank, bool& found);
+
+        // the new subtree without its minimum, which is returned in min_node
+        node_ptr erase_min_copy(node_ptr subtree, bool& shrank, node_ptr& min_node);
+
+        // fixes a fresh node whose child on the other side than its balance shrank
+        node_ptr fix_after_erase(node_ptr subtree, bool& shrank);
+
+        // a fresh node with balance lhs_2 or rhs_2 whose heavy child (and its inner child
+        // for a double rotation) are fresh as well; shrank tells if the height went down
+        static node_ptr rotate(node_ptr subtree, bool& shrank) noexcept;
+
+        // a private copy of a published node, which is retired after the next publish
+        node_ptr clone(node_ptr node);
+
+        void publish(node_ptr root);
+
+        static node_ptr build(const std::vector<key_type>& keys, std::size_t first, std::size_t last, int& height);
+
+        // height of the subtree, -1 if it breaks the order or the balance factors
+        int check(const node_type* subtree, const key_type* lower, const key_type* upper) const;
+
+        const node_type* search(const node_type* root, const key_type& value) const;
+
+        static void destroy(node_ptr subtree) noexcept;
+
+        static void destroy_node(void* node) noexcept;
+
+    private:
+        std::atomic<node_ptr> head{nullptr};
+        std::atomic<std::size_t> m_size{0};
+        key_compare key_cmp = { };
+
+        // writer side: serializes writes and collects the nodes the current write replaced
+        std::mutex writer_mutex;
+        std::vector<node_ptr> replaced;
+
+        mutable detail::epoch_domain epochs;
+    };
+
+} // namespace tree
+
+#include "detail/rcu_avl.tpp"
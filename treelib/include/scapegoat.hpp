@@ -0,0 +1,136 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <ratio>
+#include <cmath>
+#include <exception>
+#include <optional>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "iterator.hpp"
+#include "static_set.hpp"
+
+#define SCAPEGOAT_TREE_DEBUG_REBUILDS 0
+
+namespace tree
+{
+    // Scapegoat tree on the plain key + two pointers node: no balance data is stored,
+    // an insert deeper than log_{1/Alpha}(size) rebuilds the subtree of its first
+    // Alpha-unbalanced ancestor, and the whole tree is rebuilt once erases shrink it
+    // below Alpha of its size after the last full rebuild. Rebuilds rotate in place.
+    template <typename Key, typename Compare = std::less<Key>, typename Alpha = std::ratio<2, 3>>
+    class scapegoat
+    {
+        static_assert(std::ratio_greater_v<Alpha, std::ratio<1, 2>> && std::ratio_less_v<Alpha, std::ratio<1>>,
+                      "Alpha must be in (1/2, 1)");
+
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using alpha = Alpha;
+        using self_type = tree::scapegoat<key_type, key_compare, alpha>;
+        using node_type = tree::detail::Node<key_type>;
+        using node_ptr = node_type*;
+        using iterator = tree::NodeIterator<node_type>;
+        using const_iterator = tree::NodeIterator<const node_type>;
+
+    public:
+        scapegoat();
+
+        scapegoat(const std::initializer_list<key_type>& data);
+        scapegoat(std::initializer_list<key_type>&& data);
+
+        scapegoat(const self_type& other);
+        scapegoat(self_type&& other) noexcept;
+
+        ~scapegoat();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        node_ptr insert(key_type key);
+
+        void erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        bool is_ordered(node_ptr subtree) const noexcept;
+
+        // ordered and no deeper than the rebuilds allow
+        bool is_scapegoat() const noexcept;
+
+        std::size_t height(node_ptr subtree) const noexcept;
+
+    private:
+        ///////////////////
+        //   BALANCING   //
+        ///////////////////
+
+        // deepest allowed depth of a node in a tree of the given size, floor(log_{1/Alpha}(size))
+        static std::size_t max_depth(std::size_t size) noexcept;
+
+        // rebuilds the subtree hanging off the link into a perfectly balanced one
+        static void rebuild(node_ptr& link, std::size_t size) noexcept;
+
+        // Day-Stout-Warren: right rotations turn the subtree into a sorted right vine...
+        static void flatten(node_ptr& link) noexcept;
+
+        // ...and rounds of left rotations along the vine fold it back into a complete tree
+        static void compress(node_ptr& link, std::size_t count) noexcept;
+
+        static std::size_t subtree_size(node_ptr subtree) noexcept;
+
+        node_ptr& link_to(std::size_t depth) noexcept;
+
+        void destroy(node_ptr subtree) noexcept;
+
+    private:
+        node_ptr head = nullptr;
+        std::size_t m_size = 0;
+        std::size_t max_size = 0; // largest size since the last full rebuild
+        key_compare key_cmp = { };
+
+        // ancestors of the node being inserted, the root first
+        std::vector<node_ptr> path_cache;
+    };
+
+} // namespace tree
+
+#include "detail/scapegoat.tpp"
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <type_traits>
+#include <initializer_list>
+
+#include "detail/node_pool.hpp"
+#include "detail/intrinsics.hpp"
+
+namespace tree
+{
+    // One writer and any number of readers on an avl or a cartesian tree through a seqlock.
+    // The writer changes the tree with its ordinary insert and erase, between two increments of
+    // a sequence counter that is odd while a change is in progress. Readers write no shared
+    // memory at all: they read the counter, walk the tree without a lock and start over if the
+    // counter was odd or has moved since, so they never slow the writer down and a read that
+    // overlaps no change costs two more loads than a plain find.
+    //
+    // A reader may still walk through a node the writer has just erased, so the tree takes its
+    // nodes from a type-stable pool, where erased nodes wait to be reused as nodes: a torn walk
+    // reads stale keys and links, never freed memory, and is thrown away. Every few steps the
+    // walk checks the counter, so it cannot go around a cycle of links that changed under it.
+    // Keys are copied out of the nodes, so they must be trivially copyable, and Compare must
+    // accept any value a torn read produces.
+    //
+    // This relies on a tolerated data race: the writer changes keys and links with the plain
+    // stores of the tree's own insert and erase, while readers load the links as atomics and
+    // copy the keys plainly. Whatever a racing read returns fails the validation and is
+    // thrown away, but the race is still undefined behaviour by the letter of the standard,
+    // and ThreadSanitizer reports it; concurrent use is kept out of its runs, see
+    // TREELIB_THREAD_SANITIZER.
+    //
+    // Lookups return copies of keys instead of iterators. Writers are serialized by a mutex.
+    // The set owns its lock, so it is neither copyable nor movable.
+    template <typename Tree>
+    class seqlocked
+    {
+    public:
+        using tree_type = Tree;
+        using key_type = typename tree_type::key_type;
+        using key_compare = typename tree_type::key_compare;
+        using node_type = typename tree_type::node_type;
+        using node_ptr = typename tree_type::node_ptr;
+        using self_type = tree::seqlocked<tree_type>;
+
+        static_assert(std::is_trivially_copyable_v<key_type>,
+                      "readers copy keys out of nodes the writer may be changing");
+
+    public:
+        seqlocked();
+
+        seqlocked(const std::initializer_list<key_type>& data);
+        seqlocked(std::initializer_list<key_type>&& data);
+
+        seqlocked(const self_type& other) = delete;
+        seqlocked(self_type&& other) = delete;
+
+        self_type& operator = (const self_type& other) = delete;
+        self_type& operator = (self_type&& other) = delete;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear();
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        std::optional<key_type> find(const key_type& value) const;
+
+        // the least key not less than the value
+        std::optional<key_type> lower_bound(const key_type& value) const;
+
+        bool contains(const key_type& value) const;
+
+        // every key in order, as of one moment; a writer that changes the tree faster
+        // than one walk over it keeps this retrying
+        std::vector<key_type> keys() const;
+
+    private:
+        // steps of a walk between two checks of the counter
+        static constexpr std::size_t check_interval = 64;
+
+        // keeps the counter odd while alive, even if the tree throws
+        class write_guard
+        {
+        public:
+            explicit write_guard(std::atomic<std::uint64_t>& sequence) noexcept;
+            ~write_guard();
+
+            write_guard(const write_guard&) = delete;
+            write_guard& operator = (const write_guard&) = delete;
+
+        private:
+            std::atomic<std::uint64_t>& sequence;
+        };
+
+        /////////////////
+        //   READING   //
+        /////////////////
+
+        // the even counter a read starts from, once a change in progress is over
+        std::uint64_t read_begin() const noexcept;
+
+        // true if no change started since the read began
+        bool read_validate(std::uint64_t start) const noexcept;
+
+        // false if the walk has to start over
+        bool attempt_lower_bound(const key_type& value, std::uint64_t start,
+                                 std::optional<key_type>& bound) const;
+
+        bool attempt_keys(std::uint64_t start, std::vector<key_type>& result) const;
+
+    private:
+        // declared before the tree, which returns its nodes to the pool when it goes
+        detail::node_pool<node_type> pool;
+        tree_type tree;
+
+        alignas(detail::cache_line_size) std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::size_t> m_size{0};
+
+        std::mutex writer_mutex;
+
+        key_compare key_cmp = { };
+    };
+
+} // namespace tree
+
+#include "detail/seqlocked.tpp"
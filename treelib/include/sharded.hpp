@@ -0,0 +1,218 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <random>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+#include "detail/intrinsics.hpp"
+#include "detail/epoch.hpp"
+
+namespace tree
+{
+    // Ordered set shared between threads, built from any sequential Tree: the key space is cut
+    // into Shards ranges, each with its own tree and mutex, so operations on different ranges
+    // do not wait for each other. Lookups lock their shard as well, since avl and splay
+    // change the tree even when they only read it.
+    //
+    // The boundaries are an immutable array published through an atomic pointer, replaced
+    // by rebalance() while it holds every shard lock and freed through epoch-based reclamation.
+    // An operation reads the boundaries, locks the shard they name and checks that they
+    // are still current. rebalance() moves the boundaries to the quantiles of the keys; an
+    // insert calls it when its shard has grown past twice the average of the last rebalance.
+    //
+    // Iteration is ordered across shards and weakly consistent: an iterator copies one shard
+    // at a time and resumes after the last key it returned, so it sees every key present
+    // for the whole iteration exactly once, even across a rebalance. Tree needs insert, erase,
+    // find, end, size, clear and ordered iteration. The set owns its locks, so it is neither
+    // copyable nor movable.
+    template <typename Tree, std::size_t Shards = 16>
+    class sharded
+    {
+        static_assert(Shards > 0, "at least one shard is needed");
+
+    public:
+        using tree_type = Tree;
+        using key_type = typename tree_type::key_type;
+        using key_compare = typename tree_type::key_compare;
+        using self_type = tree::sharded<tree_type, Shards>;
+
+        static constexpr std::size_t shards_count = Shards;
+
+        // a shard is not rebalanced below this size
+        static constexpr std::size_t min_shard_size = 1024;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            // the end iterator
+            const_iterator() = default;
+
+            const value_type& operator * () const;
+            const value_type* operator -> () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            friend class sharded;
+
+            const_iterator(const self_type* owner, std::vector<key_type> chunk,
+                           std::size_t next_shard, std::uint64_t version);
+
+        private:
+            const self_type* owner = nullptr;
+
+            // keys of one shard copied under its lock, the current one at position
+            std::vector<key_type> chunk;
+            std::size_t position = 0;
+
+            // where the next chunk comes from while the boundaries keep this version
+            std::size_t next_shard = 0;
+            std::uint64_t version = 0;
+        };
+
+        // keys cannot be modified in place without breaking the order
+        using iterator = const_iterator;
+
+    public:
+        sharded();
+
+        sharded(const std::initializer_list<key_type>& data);
+        sharded(std::initializer_list<key_type>&& data);
+
+        sharded(const self_type& other) = delete;
+        sharded(self_type&& other) = delete;
+
+        ~sharded();
+
+        self_type& operator = (const self_type& other) = delete;
+        self_type& operator = (self_type&& other) = delete;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const;
+
+        // exact when no operation is in flight
+        std::size_t size() const;
+
+        // keys in the shard, for watching the balance
+        std::size_t shard_size(std::size_t index) const;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear();
+
+        // false if the key was already there
+        bool insert(key_type key);
+
+        // false if the key was not there
+        bool erase(const key_type& key);
+
+        // moves the boundaries so that every shard holds the same number of keys;
+        // locks all shards, O(n log n)
+        void rebalance();
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        // iteration goes on from the key, end() if it is absent
+        const_iterator find(const key_type& value) const;
+
+        bool contains(const key_type& value) const;
+
+        // every shard is ordered and holds only keys of its range;
+        // only meaningful while no other thread modifies the set
+        bool is_sharded() const;
+
+    private:
+        struct boundaries
+        {
+            // the first key of every shard but the first, may be fewer than Shards - 1
+            std::vector<key_type> keys;
+            std::uint64_t version = 0;
+        };
+
+        struct alignas(detail::cache_line_size) shard
+        {
+            std::mutex mutex;
+            tree_type tree;
+        };
+
+        using guard_type = detail::epoch_domain::guard;
+
+        // runs the operation on the shard of the key under its lock
+        template <typename Operation>
+        decltype(auto) with_shard(const key_type& key, Operation operation) const;
+
+        std::size_t shard_of(const boundaries& current, const key_type& key) const;
+
+        // the keys of the first nonempty shard that follow after, all keys of it if after is null;
+        // empty once the shards are exhausted
+        std::vector<key_type> next_chunk(const key_type* after,
+                                         std::size_t& next_shard,
+                                         std::uint64_t& version) const;
+
+        // once one rebalance runs, the others skip theirs
+        void try_rebalance();
+
+        // expects rebalance_mutex and every shard lock to be held
+        void rebalance_locked();
+
+        void publish(boundaries* fresh);
+
+        static void destroy_boundaries(void* pointer) noexcept;
+
+    private:
+        mutable std::array<shard, Shards> shards;
+
+        std::atomic<const boundaries*> current_boundaries;
+        std::mutex rebalance_mutex;
+
+        // shuffles the keys a rebalance puts back, guarded by rebalance_mutex
+        std::mt19937 gen = std::mt19937((std::random_device{})());
+
+        // an insert that makes its shard larger calls rebalance()
+        std::atomic<std::size_t> split_threshold{2 * min_shard_size};
+
+        key_compare key_cmp = { };
+
+        mutable detail::epoch_domain epochs;
+    };
+
+} // namespace tree
+
+#include "detail/sharded.tpp"
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <type_traits>
+
+#include "detail/intrinsics.hpp"
+#include "detail/simd.hpp"
+
+namespace tree
+{
+    // Immutable set of signed 32- or 64-bit integers stored as a static k-ary search tree:
+    // every node is a cache line of separators compared against the key in one SIMD step.
+    // The instruction set (AVX2, SSE4.2 or scalar) is chosen at runtime.
+    template <typename Key>
+    class simd_static_set
+    {
+        static_assert(std::is_integral_v<Key> && std::is_signed_v<Key> &&
+                      (sizeof(Key) == 4 || sizeof(Key) == 8),
+                      "simd_static_set supports signed 32- and 64-bit integer keys only");
+
+    public:
+        using key_type = Key;
+        using const_iterator = const key_type*;
+        using iterator = const_iterator;
+        using isa_type = tree::detail::simd_isa;
+
+        static constexpr std::size_t block_size = detail::cache_line_size / sizeof(key_type);
+
+    public:
+        simd_static_set();
+
+        // [first, last) must be sorted ascending and hold no duplicates,
+        // which is the case for in-order traversal of any of the trees
+        template <typename InputIt>
+        simd_static_set(InputIt first, InputIt last, isa_type isa = detail::supported_simd_isa());
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        isa_type isa() const noexcept;
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        const_iterator find(key_type value) const;
+
+        const_iterator lower_bound(key_type value) const;
+
+        bool contains(key_type value) const;
+
+        // number of keys less than the value
+        std::size_t rank(key_type value) const;
+
+        // ranks[i] = rank(values[i]), lookups are interleaved to overlap their cache misses
+        void batch_rank(const key_type* values, std::size_t count, std::size_t* ranks) const;
+
+        // found[i] = contains(values[i])
+        void batch_contains(const key_type* values, std::size_t count, bool* found) const;
+
+    private:
+        struct alignas(detail::cache_line_size) block
+        {
+            key_type keys[block_size];
+        };
+        static_assert(sizeof(block) == detail::cache_line_size, "blocks must be laid out back to back");
+
+        std::size_t search(key_type value) const;
+
+        detail::kary_layout<key_type> layout() const noexcept;
+
+    private:
+        // layer 0 (the sorted keys) comes first, the root block last
+        std::vector<block> blocks;
+        std::vector<std::size_t> offsets;
+        std::size_t m_size = 0;
+        isa_type m_isa = isa_type::scalar;
+    };
+
+} // namespace tree
+
+#include "detail/simd_static_set.tpp"
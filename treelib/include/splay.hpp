@@ -2,6 +2,8 @@
 
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 #include <exception>
@@ -12,6 +14,9 @@
 
 #include "detail/node.hpp"
 #include "iterator.hpp"
+#include "execution.hpp"
+#include "detail/parallel.hpp"
+#include "static_set.hpp"
 
 namespace tree
 {
@@ -21,7 +26,7 @@ namespace tree
 	public:
 		using key_type = Key;
 		using key_compare = Compare;
-		using node_type = tree::detail::Node<key_type>;
+		using node_type = tree::detail::NodeSplay<key_type>;
 		using node_ptr = node_type *;
         using iterator = tree::NodeIterator<node_type>;
         using const_iterator = tree::NodeIterator<const node_type>;
@@ -37,6 +42,18 @@ namespace tree
 
 		~splay();
 
+		// The distinct keys of [first, last) in any order, the first of equal ones kept. They are
+		// sorted and deduplicated, then linked into a perfectly balanced tree in O(n); under the
+		// parallel policy all of it runs on the pool, disjoint subtrees on different workers.
+		template <typename InputIt, typename ExecutionPolicy = sequenced_policy>
+		static splay<key_type, key_compare> from_unsorted(InputIt first, InputIt last,
+		                                                  const ExecutionPolicy& policy = seq);
+
+		// A copy of the same shape node for node, rather than the keys inserted one by one; under
+		// the parallel policy the subtrees near the root are copied on different workers.
+		template <typename ExecutionPolicy = sequenced_policy>
+		splay<key_type, key_compare> clone(const ExecutionPolicy& policy = seq) const;
+
 		iterator begin();
 		const_iterator begin() const;
 		const_iterator cbegin() const;
@@ -45,6 +62,19 @@ namespace tree
 		const_iterator end() const;
 		const_iterator cend() const;
 
+		// Calls function(key) on every key, in order under the sequential policy. Under the
+		// parallel one the subtrees near the root go to different workers, idle ones stealing
+		// from busy ones, so the order is unspecified and the calls are concurrent. A splayed
+		// tree may be far from balanced, the stealing evens the work out.
+		template <typename Function, typename ExecutionPolicy = sequenced_policy>
+		void for_each(Function function, const ExecutionPolicy& policy = seq) const;
+
+		// Folds the keys in order: every part starts from identity, accumulate(value, key) takes
+		// its keys in and combine(lhs, rhs) joins neighbouring parts, so combine has to be
+		// associative with identity neutral. The parts are split like for for_each.
+		template <typename T, typename Accumulate, typename Combine, typename ExecutionPolicy = sequenced_policy>
+		T reduce(T identity, Accumulate accumulate, Combine combine, const ExecutionPolicy& policy = seq) const;
+
 		bool empty() const noexcept;
 		std::size_t size() const noexcept;
 
@@ -57,6 +87,22 @@ namespace tree
 		iterator find(const key_type& value);
 		const_iterator find(const key_type& value) const;
 
+		// immutable snapshot of the current keys for read-only lookups
+		static_set<key_type, key_compare> freeze() const;
+
+		// per-node counters of the finds that hit a key, off by default; switching on resets them
+		void set_access_counting(bool enabled);
+
+		// keys in order with their counted finds, the weights for a weighted_static
+		std::vector<std::pair<key_type, std::size_t>> access_weights() const;
+
+		// number of nodes from the root down to the key, 0 if it is absent; does not splay
+		std::size_t depth(const key_type& value) const;
+
+		// the node with the key, nullptr if it is absent; neither splays nor counts the access,
+		// so any number of threads may call it while nothing modifies the tree
+		const node_type* lookup(const key_type& value) const;
+
 	private:
 
 		node_ptr find_place(const key_type& value, bool last_nonzero = true) const;
@@ -69,10 +115,15 @@ namespace tree
 
 		void splay_operation(node_ptr v);
 
+		// a perfectly balanced tree of the sorted keys in [first, last), moved out of them
+		static node_ptr build_sorted(std::vector<key_type>& keys, std::size_t first, std::size_t last,
+		                             thread_pool* executor);
+
 	private:
 		node_ptr head = nullptr;
 		std::size_t m_size = 0;
 		key_compare key_cmp = { };
+		bool count_accesses = false;
 
 		mutable std::vector<bool> cmp_cache;
 		mutable std::stack<node_ptr> path_cache;
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+#include "detail/intrinsics.hpp"
+
+namespace tree
+{
+    // Immutable sorted set stored as an implicit binary search tree in
+    // Eytzinger (BFS) order: the root is at index 1, children of k are 2k and 2k + 1.
+    // Usually obtained with freeze() from one of the mutable trees.
+    template <typename Key, typename Compare = std::less<Key>>
+    class static_set
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using self_type = tree::static_set<key_type, key_compare>;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            const_iterator(const self_type* owner, std::size_t index);
+
+            const value_type& operator * () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            const_iterator& operator -- ();
+            const_iterator operator -- (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+            // position of the key in the Eytzinger array, 0 for end()
+            std::size_t get_index() const noexcept;
+
+        private:
+            const self_type* owner;
+            std::size_t index;
+        };
+
+        using iterator = const_iterator;
+
+    public:
+        static_set();
+
+        // [first, last) must be sorted by Compare and hold no duplicates,
+        // which is the case for in-order traversal of any of the trees
+        template <typename InputIt>
+        static_set(InputIt first, InputIt last);
+
+        // arbitrary order, duplicates are dropped
+        static_set(std::initializer_list<key_type> data);
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        const_iterator find(const key_type& value) const;
+
+        const_iterator lower_bound(const key_type& value) const;
+
+        bool contains(const key_type& value) const;
+
+        // number of keys less than the value
+        std::size_t rank(const key_type& value) const;
+
+    private:
+        std::size_t search(const key_type& value) const;
+
+        std::size_t first_index() const noexcept;
+        std::size_t last_index() const noexcept;
+        std::size_t next_index(std::size_t index) const noexcept;
+        std::size_t prev_index(std::size_t index) const noexcept;
+
+        // in-order position of the key at the index, which is not 0
+        std::size_t rank_of(std::size_t index) const noexcept;
+
+        template <typename InputIt>
+        void assign_sorted(InputIt first, std::size_t count);
+
+        // descend this many levels below the one being compared with a single prefetch:
+        // the 2^levels descendants of a node are adjacent and fill one cache line
+        static constexpr std::size_t prefetch_levels()
+        {
+            std::size_t levels = 0;
+            while ((std::size_t{2} << levels) * sizeof(key_type) <= detail::cache_line_size)
+            {
+                levels++;
+            }
+            return levels == 0 ? 1 : levels;
+        }
+
+    private:
+        // data[0] is a never-accessed sentinel so that the root sits at index 1
+        std::vector<key_type> data;
+        std::size_t m_size = 0;
+        key_compare key_cmp = { };
+    };
+
+} // namespace tree
+
+#include "detail/static_set.tpp"
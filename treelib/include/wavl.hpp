@@ -0,0 +1,131 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <exception>
+#include <optional>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "iterator.hpp"
+#include "static_set.hpp"
+
+namespace tree
+{
+    // Weak AVL tree (Haeupler, Sen, Tarjan): every node has a rank, children differ from it
+    // by 1 or 2 and leaves are 1,1. Without erases it is exactly an AVL tree, an insert does
+    // at most two rotations and an erase at most two as well (one single or double rotation),
+    // the rest of both fix-ups is O(1) amortised promotions and demotions. Only the two rank
+    // differences of a node are stored, the path from the root is cached as in rb.
+    template <typename Key, typename Compare = std::less<Key>>
+    class wavl
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeWAVL<key_type>;
+        using node_ptr = node_type*;
+        using iterator = tree::NodeIterator<node_type>;
+        using const_iterator = tree::NodeIterator<const node_type>;
+        using self_type = tree::wavl<key_type, key_compare>;
+
+    public:
+        wavl();
+
+        wavl(const std::initializer_list<key_type>& data);
+        wavl(std::initializer_list<key_type>&& data);
+
+        wavl(const self_type& other);
+        wavl(self_type&& other) noexcept;
+
+        ~wavl();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        node_ptr insert(key_type key);
+
+        void erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        // keys are ordered, rank differences add up along every path and leaves are 1,1
+        bool is_wavl() const noexcept;
+
+    private:
+        ///////////////////
+        //   BALANCING   //
+        ///////////////////
+
+        // the child on the given side is a 0-child of path_cache.back()
+        void fix_insert(bool is_left_child);
+
+        // the child on the given side is a 3-child of path_cache.back()
+        void fix_erase(bool is_left_child);
+
+        // the child on the given side takes the place of the subtree
+        [[nodiscard]] static node_ptr rotate(node_ptr subtree, bool is_left_child) noexcept;
+
+        void replace_child(node_ptr parent, node_ptr old_child, node_ptr new_child) noexcept;
+
+        static node_ptr& child(node_ptr node, bool is_left_child) noexcept;
+
+        static bool is_two_child(node_ptr parent, bool is_left_child) noexcept;
+
+        static void set_two_child(node_ptr parent, bool is_left_child, bool is_two) noexcept;
+
+        node_ptr find_node(const key_type& value) const;
+
+        // rank of the subtree, -2 if it breaks the order or the rank rule
+        int check(node_ptr subtree, const key_type* lower, const key_type* upper) const noexcept;
+
+        void destroy(node_ptr subtree) noexcept;
+
+    private:
+        node_ptr head = nullptr;
+        std::size_t m_size = 0;
+        key_compare key_cmp = { };
+
+        // ancestors of the node being fixed, the root first
+        std::vector<node_ptr> path_cache;
+    };
+
+} // namespace tree
+
+#include "detail/wavl.tpp"
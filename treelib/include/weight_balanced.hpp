@@ -0,0 +1,180 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <exception>
+#include <optional>
+#include <initializer_list>
+
+#include "detail/node.hpp"
+#include "iterator.hpp"
+#include "execution.hpp"
+#include "static_set.hpp"
+
+namespace tree
+{
+    // Weight-balanced tree (BB[alpha] with the integer parameters delta = 3, gamma = 2):
+    // every node stores the size of its subtree, which is the balance metric and also
+    // gives select and rank in O(log n). Everything is built on join, so split, join and
+    // the bulk set operations are O(m log(n / m + 1)) and split the work into independent halves.
+    template <typename Key, typename Compare = std::less<Key>>
+    class weight_balanced
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeWB<key_type>;
+        using node_ptr = node_type*;
+        using iterator = tree::NodeIterator<node_type>;
+        using const_iterator = tree::NodeIterator<const node_type>;
+        using self_type = tree::weight_balanced<key_type, key_compare>;
+
+    public:
+        weight_balanced();
+
+        weight_balanced(const std::initializer_list<key_type>& data);
+        weight_balanced(std::initializer_list<key_type>&& data);
+
+        weight_balanced(const self_type& other);
+        weight_balanced(self_type&& other) noexcept;
+
+        ~weight_balanced();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        node_ptr insert(key_type key);
+
+        void erase(const key_type& key);
+
+        // keeps the keys less than the given one, the rest is moved to the returned tree
+        [[nodiscard]] self_type split(const key_type& key);
+
+        // appends the keys of other, which must all be greater than the keys of this tree
+        void join(self_type&& other);
+
+        // Set operations with other, whose nodes are reused or freed, so it ends up empty.
+        // Independent subproblems run in parallel under the parallel policy.
+        void unite(self_type&& other, const sequenced_policy& policy = seq);
+        void unite(self_type&& other, const parallel_policy& policy);
+        void intersect(self_type&& other, const sequenced_policy& policy = seq);
+        void intersect(self_type&& other, const parallel_policy& policy);
+        void subtract(self_type&& other, const sequenced_policy& policy = seq);
+        void subtract(self_type&& other, const parallel_policy& policy);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // the key with the given position in the sorted order, end() if it is out of range
+        iterator select(std::size_t index);
+        const_iterator select(std::size_t index) const;
+
+        // number of keys less than the value
+        std::size_t rank(const key_type& value) const;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        bool is_ordered(node_ptr subtree) const noexcept;
+
+        // sizes are consistent and the weights of all siblings are within delta of each other
+        bool is_weight_balanced(node_ptr subtree = nullptr) const noexcept;
+
+    private:
+        ///////////////////
+        //   BALANCING   //
+        ///////////////////
+
+        struct split_result
+        {
+            node_ptr lhs;
+            node_ptr found;
+            node_ptr rhs;
+        };
+
+        static std::size_t size_of(node_ptr subtree) noexcept;
+
+        // weight of a subtree is its size + 1
+        static bool is_balanced(std::size_t lhs_size, std::size_t rhs_size) noexcept;
+
+        static node_ptr update(node_ptr subtree) noexcept;
+
+        // restores the balance of a node whose subtrees changed by a bounded amount
+        [[nodiscard]] static node_ptr balance(node_ptr subtree) noexcept;
+
+        [[nodiscard]] static node_ptr rotate_left(node_ptr subtree) noexcept;
+
+        [[nodiscard]] static node_ptr rotate_right(node_ptr subtree) noexcept;
+
+        // lhs < middle < rhs, middle is a detached node
+        [[nodiscard]] static node_ptr link(node_ptr lhs, node_ptr middle, node_ptr rhs) noexcept;
+
+        // lhs < rhs
+        [[nodiscard]] static node_ptr join_nodes(node_ptr lhs, node_ptr rhs) noexcept;
+
+        [[nodiscard]] static node_ptr insert_min(node_ptr subtree, node_ptr node) noexcept;
+        [[nodiscard]] static node_ptr insert_max(node_ptr subtree, node_ptr node) noexcept;
+
+        // detaches the minimum of a non-empty subtree into node
+        [[nodiscard]] static node_ptr remove_min(node_ptr subtree, node_ptr& node) noexcept;
+
+        [[nodiscard]] split_result split_nodes(node_ptr subtree, const key_type& key) const;
+
+        [[nodiscard]] node_ptr insert_node(node_ptr subtree, node_ptr& node);
+
+        [[nodiscard]] node_ptr erase_node(node_ptr subtree, const key_type& key);
+
+        // fork on the executor if there is one and the work is worth it
+        [[nodiscard]] node_ptr unite_nodes(node_ptr lhs, node_ptr rhs, thread_pool* executor) const;
+        [[nodiscard]] node_ptr intersect_nodes(node_ptr lhs, node_ptr rhs, thread_pool* executor) const;
+        [[nodiscard]] node_ptr subtract_nodes(node_ptr lhs, node_ptr rhs, thread_pool* executor) const;
+
+        node_ptr select_node(std::size_t index) const noexcept;
+
+        static void destroy(node_ptr subtree) noexcept;
+
+    private:
+        static constexpr std::size_t delta = 3;
+        static constexpr std::size_t gamma = 2;
+
+        // smaller subproblems are not worth a task
+        static constexpr std::size_t parallel_cutoff = 4096;
+
+        node_ptr head = nullptr;
+        key_compare key_cmp = { };
+    };
+
+} // namespace tree
+
+#include "detail/weight_balanced.tpp"
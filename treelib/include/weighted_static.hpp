@@ -0,0 +1,131 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <initializer_list>
+
+namespace tree
+{
+    // Immutable search tree shaped by access weights with Mehlhorn's bisection rule: the root
+    // of every key range is the key whose weight interval holds the middle of the range's total
+    // weight, so a key of weight w sits at depth at most log2(W / w) + 1 of the total W and the
+    // expected depth is within a constant of the optimal static tree. Keys of zero weight are
+    // split by count instead. Built in O(n log n) from (key, weight) pairs, for instance
+    // the access_weights() of a splay or an avl with access counting on. The nodes are
+    // stored in preorder, so the heavy top of the tree shares a few cache lines.
+    template <typename Key, typename Compare = std::less<Key>>
+    class weighted_static
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using weight_type = double;
+        using self_type = tree::weighted_static<key_type, key_compare>;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = key_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+        public:
+            const_iterator(const self_type* owner, std::size_t position);
+
+            const value_type& operator * () const;
+
+            const_iterator& operator ++ ();
+            const_iterator operator ++ (int);
+
+            const_iterator& operator -- ();
+            const_iterator operator -- (int);
+
+            bool operator == (const const_iterator& other) const;
+            bool operator != (const const_iterator& other) const;
+
+        private:
+            const self_type* owner;
+            std::size_t position; // in key order, size() for end()
+        };
+
+        using iterator = const_iterator;
+
+    public:
+        weighted_static();
+
+        // (key, weight) pairs in any order, weights of equal keys add up;
+        // throws std::invalid_argument on a negative weight
+        template <typename InputIt>
+        weighted_static(InputIt first, InputIt last);
+
+        weighted_static(std::initializer_list<std::pair<key_type, weight_type>> data);
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        const_iterator find(const key_type& value) const;
+
+        bool contains(const key_type& value) const;
+
+        // number of nodes from the root down to the key, 0 if it is absent
+        std::size_t depth(const key_type& value) const;
+
+        // average depth of the keys weighted by the weights the tree was built from
+        double expected_depth() const noexcept;
+
+        // keys are ordered and every node is reached exactly once from the root
+        bool is_search_tree() const;
+
+    private:
+        static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+        struct node
+        {
+            key_type key;
+            std::uint32_t left;
+            std::uint32_t right;
+            std::uint32_t position;
+        };
+
+        void build(std::vector<std::pair<key_type, weight_type>> weights);
+
+        std::uint32_t search(const key_type& value) const;
+
+    private:
+        // preorder, the root first
+        std::vector<node> nodes;
+        // node of every key in key order
+        std::vector<std::uint32_t> in_order;
+        double weighted_depth = 0;
+        key_compare key_cmp = { };
+    };
+
+} // namespace tree
+
+#include "detail/weighted_static.tpp"
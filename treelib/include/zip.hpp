@@ -0,0 +1,112 @@
+#pragma once
+
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <exception>
+#include <optional>
+#include <initializer_list>
+#include <random>
+
+#include "detail/node.hpp"
+#include "detail/intrinsics.hpp"
+#include "iterator.hpp"
+#include "static_set.hpp"
+
+namespace tree
+{
+    // Zip tree (Tarjan, Levy, Timmel): a treap whose priorities are geometric ranks,
+    // heap-ordered with ties going to the smaller key, so the shape has the same distribution
+    // as a skip list. Insert unzips the search path below the new node into its two subtrees
+    // and erase zips the right spine of the left subtree with the left spine of the right one,
+    // both in loops without recursion or rotations.
+    template <typename Key, typename Compare = std::less<Key>>
+    class zip
+    {
+    public:
+        using key_type = Key;
+        using key_compare = Compare;
+        using node_type = tree::detail::NodeZip<key_type>;
+        using node_ptr = node_type*;
+        using iterator = tree::NodeIterator<node_type>;
+        using const_iterator = tree::NodeIterator<const node_type>;
+        using self_type = tree::zip<key_type, key_compare>;
+
+    public:
+        zip();
+
+        zip(const std::initializer_list<key_type>& data);
+        zip(std::initializer_list<key_type>&& data);
+
+        zip(const self_type& other);
+        zip(self_type&& other) noexcept;
+
+        ~zip();
+
+        self_type& operator = (const self_type& other);
+        self_type& operator = (self_type&& other) noexcept;
+
+        ///////////////////
+        //   ITERATORS   //
+        ///////////////////
+
+        iterator begin();
+        const_iterator begin() const;
+        const_iterator cbegin() const;
+
+        iterator end();
+        const_iterator end() const;
+        const_iterator cend() const;
+
+        //////////////////
+        //   CAPACITY   //
+        //////////////////
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+
+        ///////////////////
+        //   MODIFIERS   //
+        ///////////////////
+
+        void clear() noexcept;
+
+        node_ptr insert(key_type key);
+
+        void erase(const key_type& key);
+
+        /////////////////
+        //   LOOK UP   //
+        /////////////////
+
+        iterator find(const key_type& value);
+        const_iterator find(const key_type& value) const;
+
+        // immutable snapshot of the current keys for read-only lookups
+        static_set<key_type, key_compare> freeze() const;
+
+        // keys are ordered, a left child has a smaller rank and a right child no greater one
+        bool is_zip() const noexcept;
+
+    private:
+        node_ptr find_node(const key_type& value) const;
+
+        // number of heads before the first tail of a fair coin
+        std::uint8_t get_random_rank();
+
+        bool check(node_ptr subtree, const key_type* lower, const key_type* upper) const noexcept;
+
+        void destroy(node_ptr subtree) noexcept;
+
+    private:
+        node_ptr head = nullptr;
+        std::size_t m_size = 0;
+        key_compare key_cmp = { };
+
+        std::mt19937_64 gen = std::mt19937_64((std::random_device{})());
+    };
+
+} // namespace tree
+
+#include "detail/zip.tpp"
@@ -1,5 +1,31 @@
 #include "detail/node.hpp"
 
+#include "detail/intrinsics.hpp"
+
+#include "detail/epoch.hpp"
+
+#include "detail/node_pool.hpp"
+
+#include "detail/batch.hpp"
+
+#include "detail/work_stealing.hpp"
+
+#include "execution.hpp"
+
+#include "detail/parallel.hpp"
+
+#include "static_set.hpp"
+#include "detail/static_set.tpp"
+
+#include "detail/simd.hpp"
+
+#include "detail/radix.hpp"
+
+#include "detail/veb.hpp"
+
+#include "simd_static_set.hpp"
+#include "detail/simd_static_set.tpp"
+
 #include "iterator.hpp"
 #include "detail/iterator.tpp"
 
@@ -11,3 +37,51 @@
 
 #include "cartesian.hpp"
 #include "detail/cartesian.tpp"
+
+#include "btree.hpp"
+#include "detail/btree.tpp"
+
+#include "rb.hpp"
+#include "detail/rb.tpp"
+
+#include "scapegoat.hpp"
+#include "detail/scapegoat.tpp"
+
+#include "weight_balanced.hpp"
+#include "detail/weight_balanced.tpp"
+
+#include "concurrent_skiplist.hpp"
+#include "detail/concurrent_skiplist.tpp"
+
+#include "art.hpp"
+#include "detail/art.tpp"
+
+#include "int_successor_set.hpp"
+#include "detail/int_successor_set.tpp"
+
+#include "zip.hpp"
+#include "detail/zip.tpp"
+
+#include "wavl.hpp"
+#include "detail/wavl.tpp"
+
+#include "weighted_static.hpp"
+#include "detail/weighted_static.tpp"
+
+#include "sharded.hpp"
+#include "detail/sharded.tpp"
+
+#include "rcu_avl.hpp"
+#include "detail/rcu_avl.tpp"
+
+#include "concurrent_avl.hpp"
+#include "detail/concurrent_avl.tpp"
+
+#include "combining.hpp"
+#include "detail/combining.tpp"
+
+#include "seqlocked.hpp"
+#include "detail/seqlocked.tpp"
+
+#include "concurrent_splay.hpp"
+#include "detail/concurrent_splay.tpp"
\ No newline at end of file
@@ -3,6 +3,24 @@
 #include "avl.hpp"
 #include "splay.hpp"
 #include "cartesian.hpp"
+#include "simd_static_set.hpp"
+#include "btree.hpp"
+#include "rb.hpp"
+#include "scapegoat.hpp"
+#include "weight_balanced.hpp"
+#include "concurrent_skiplist.hpp"
+#include "art.hpp"
+#include "int_successor_set.hpp"
+#include "zip.hpp"
+#include "wavl.hpp"
+#include "weighted_static.hpp"
+#include "sharded.hpp"
+#include "rcu_avl.hpp"
+#include "concurrent_avl.hpp"
+#include "combining.hpp"
+#include "seqlocked.hpp"
+#include "concurrent_splay.hpp"
+#include "execution.hpp"
 
 namespace tree::testing
 {
@@ -44,4 +62,214 @@ namespace tree::testing
         }
     }
 
+    template <typename T, std::size_t NodeBytes>
+    void compare_traverse_btree(tree::btree<T, std::less<T>, NodeBytes>& btree, const std::set<T>& rb_tree)
+    {
+        REQUIRE(btree.size() == rb_tree.size());
+        REQUIRE(btree.is_btree());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto btree_element : btree)
+        {
+            REQUIRE(btree_element == *rb_it++);
+        }
+    }
+
+    template <typename T>
+    void compare_traverse_rbtree(tree::rb<T>& rbtree, const std::set<T>& rb_tree)
+    {
+        REQUIRE(rbtree.size() == rb_tree.size());
+        REQUIRE(rbtree.is_rb());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto rbtree_element : rbtree)
+        {
+            REQUIRE(rbtree_element == *rb_it++);
+        }
+    }
+
+    template <typename T, typename Alpha>
+    void compare_traverse_scapegoat(tree::scapegoat<T, std::less<T>, Alpha>& scapegoat_tree, const std::set<T>& rb_tree)
+    {
+        REQUIRE(scapegoat_tree.size() == rb_tree.size());
+        REQUIRE(scapegoat_tree.is_scapegoat());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto scapegoat_element : scapegoat_tree)
+        {
+            REQUIRE(scapegoat_element == *rb_it++);
+        }
+    }
+
+    template <typename T>
+    void compare_traverse_weight_balanced(tree::weight_balanced<T>& wb_tree, const std::set<T>& rb_tree)
+    {
+        REQUIRE(wb_tree.size() == rb_tree.size());
+        REQUIRE(wb_tree.is_weight_balanced());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto wb_element : wb_tree)
+        {
+            REQUIRE(wb_element == *rb_it++);
+        }
+    }
+
+    template <typename T>
+    void compare_traverse_skiplist(tree::concurrent_skiplist<T>& skiplist, const std::set<T>& rb_tree)
+    {
+        REQUIRE(skiplist.size() == rb_tree.size());
+        REQUIRE(skiplist.is_skiplist());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto skiplist_element : skiplist)
+        {
+            REQUIRE(skiplist_element == *rb_it++);
+        }
+    }
+
+    template <typename T>
+    void compare_traverse_art(tree::art<T>& art, const std::set<T>& rb_tree)
+    {
+        REQUIRE(art.size() == rb_tree.size());
+        REQUIRE(art.is_art());
+
+        auto rb_it = rb_tree.cbegin();
+        for (const auto& art_element : art)
+        {
+            REQUIRE(art_element == *rb_it++);
+        }
+    }
+
+    template <unsigned Bits>
+    void compare_traverse_int_successor_set(tree::int_successor_set<Bits>& set,
+                                            const std::set<std::uint32_t>& rb_tree)
+    {
+        REQUIRE(set.size() == rb_tree.size());
+        REQUIRE(set.is_veb());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto set_element : set)
+        {
+            REQUIRE(set_element == *rb_it++);
+        }
+
+        auto rb_rit = rb_tree.crbegin();
+        for (auto it = set.end(); it != set.begin();)
+        {
+            REQUIRE(*--it == *rb_rit++);
+        }
+    }
+
+    template <typename T>
+    void compare_traverse_zip(tree::zip<T>& zip, const std::set<T>& rb_tree)
+    {
+        REQUIRE(zip.size() == rb_tree.size());
+        REQUIRE(zip.is_zip());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto zip_element : zip)
+        {
+            REQUIRE(zip_element == *rb_it++);
+        }
+    }
+
+
+    template <typename T>
+    void compare_traverse_wavl(tree::wavl<T>& wavl, const std::set<T>& rb_tree)
+    {
+        REQUIRE(wavl.size() == rb_tree.size());
+        REQUIRE(wavl.is_wavl());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto wavl_element : wavl)
+        {
+            REQUIRE(wavl_element == *rb_it++);
+        }
+    }
+
+    // rebalances first, so that the stress runs move keys across shards far below the size
+    // at which an insert would rebalance
+    template <typename Tree, std::size_t Shards = 16>
+    void compare_traverse_sharded(tree::sharded<Tree, Shards>& sharded, const std::set<typename Tree::key_type>& rb_tree)
+    {
+        sharded.rebalance();
+
+        REQUIRE(sharded.size() == rb_tree.size());
+        REQUIRE(sharded.is_sharded());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto sharded_element : sharded)
+        {
+            REQUIRE(sharded_element == *rb_it++);
+        }
+        REQUIRE(rb_it == rb_tree.cend());
+    }
+
+    template <typename T>
+    void compare_traverse_rcu_avl(tree::rcu_avl<T>& rcu_avl, const std::set<T>& rb_tree)
+    {
+        REQUIRE(rcu_avl.size() == rb_tree.size());
+        REQUIRE(rcu_avl.is_avl());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto rcu_element : rcu_avl)
+        {
+            REQUIRE(rcu_element == *rb_it++);
+        }
+        REQUIRE(rb_it == rb_tree.cend());
+    }
+
+    template <typename T>
+    void compare_traverse_concurrent_avl(tree::concurrent_avl<T>& concurrent_avl, const std::set<T>& rb_tree)
+    {
+        REQUIRE(concurrent_avl.size() == rb_tree.size());
+        REQUIRE(concurrent_avl.is_avl());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto concurrent_element : concurrent_avl)
+        {
+            REQUIRE(concurrent_element == *rb_it++);
+        }
+        REQUIRE(rb_it == rb_tree.cend());
+    }
+
+    template <typename Tree, std::size_t Slots = 64>
+    void compare_traverse_combining(tree::combining<Tree, Slots>& combining, const std::set<typename Tree::key_type>& rb_tree)
+    {
+        REQUIRE(combining.size() == rb_tree.size());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto combining_element : combining.keys())
+        {
+            REQUIRE(combining_element == *rb_it++);
+        }
+        REQUIRE(rb_it == rb_tree.cend());
+    }
+
+    template <typename Tree>
+    void compare_traverse_seqlocked(tree::seqlocked<Tree>& seqlocked, const std::set<typename Tree::key_type>& rb_tree)
+    {
+        REQUIRE(seqlocked.size() == rb_tree.size());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto seqlocked_element : seqlocked.keys())
+        {
+            REQUIRE(seqlocked_element == *rb_it++);
+        }
+        REQUIRE(rb_it == rb_tree.cend());
+    }
+
+    template <typename Key, typename Compare>
+    void compare_traverse_concurrent_splay(tree::concurrent_splay<Key, Compare>& concurrent_splay, const std::set<Key>& rb_tree)
+    {
+        REQUIRE(concurrent_splay.size() == rb_tree.size());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto splay_element : concurrent_splay.keys())
+        {
+            REQUIRE(splay_element == *rb_it++);
+        }
+        REQUIRE(rb_it == rb_tree.cend());
+    }
+
 } // namespace tree::testing
\ No newline at end of file
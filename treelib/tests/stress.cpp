@@ -46,6 +46,125 @@ TEST_CASE("stress mixed, avl", "[avl-rb]")
     tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
 }
 
+TEST_CASE("stress test, relaxed, avl", "[avl-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+    std::uniform_int_distribution<> operation_dist(0, 3);
+    std::uniform_int_distribution<std::size_t> budget_dist(1, 16);
+
+    tree::avl<int> avl_tree;
+    std::set<int> rb_tree;
+    for (std::size_t burst = 0; burst < 100; burst++)
+    {
+        // a burst of writes with the balance left to rebalance_step
+        avl_tree.set_relaxed(true);
+        for (std::size_t i = 0; i < 200; i++)
+        {
+            const auto key = key_dist(gen);
+            if (operation_dist(gen) == 0)
+            {
+                avl_tree.erase(key);
+                rb_tree.erase(key);
+            }
+            else
+            {
+                avl_tree.insert(key);
+                rb_tree.insert(key);
+            }
+
+            bool found_in_lhs = avl_tree.find(key) != avl_tree.end();
+            REQUIRE(found_in_lhs == (rb_tree.count(key) == 1));
+        }
+
+        REQUIRE(avl_tree.size() == rb_tree.size());
+        auto rb_it = rb_tree.cbegin();
+        for (auto element : avl_tree)
+        {
+            REQUIRE(element == *rb_it++);
+        }
+
+        // repaired in small steps, or all at once by leaving the relaxed mode
+        if (burst % 2 == 0)
+        {
+            while (!avl_tree.rebalance_step(budget_dist(gen)))
+            { }
+        }
+        avl_tree.set_relaxed(false);
+        tree::testing::compare_traverse<int>(avl_tree, rb_tree);
+
+        for (std::size_t i = 0; i < 100; i++)
+        {
+            const auto key = key_dist(gen);
+            avl_tree.erase(key);
+            rb_tree.erase(key);
+        }
+        tree::testing::compare_traverse<int>(avl_tree, rb_tree);
+    }
+}
+
+TEST_CASE("stress test, relaxed sorted run, avl", "[avl-rb]")
+{
+    // increasing keys in relaxed mode build a path, repairing it joins trees of very different heights
+    tree::avl<int> avl_tree;
+    std::set<int> rb_tree;
+    avl_tree.set_relaxed(true);
+    for (int key = 0; key < 2000; key++)
+    {
+        avl_tree.insert(key);
+        rb_tree.insert(key);
+    }
+    avl_tree.set_relaxed(false);
+    tree::testing::compare_traverse<int>(avl_tree, rb_tree);
+
+    avl_tree.set_relaxed(true);
+    for (int key = 0; key < 2000; key += 2)
+    {
+        avl_tree.erase(key);
+        rb_tree.erase(key);
+    }
+    for (int key = 4000; key > 2000; key--)
+    {
+        avl_tree.insert(key);
+        rb_tree.insert(key);
+    }
+    while (!avl_tree.rebalance_step(7))
+    { }
+    tree::testing::compare_traverse<int>(avl_tree, rb_tree);
+}
+
+TEST_CASE("stress test, apply batch, avl", "[avl-rb]")
+{
+    auto cmp = &tree::testing::compare_traverse<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::thread_pool pool(4);
+
+    tree::testing::stress_apply_batch<tree::avl<int>>(cmp, seed, tree::seq);
+    tree::testing::stress_apply_batch<tree::avl<int>>(cmp, seed, tree::par.on(pool));
+}
+
+TEST_CASE("stress test, from unsorted, avl", "[avl-rb]")
+{
+    auto cmp = &tree::testing::compare_traverse<int>;
+    auto seed = tree::testing::get_seed();
+    tree::thread_pool pool(4);
+
+    tree::testing::stress_from_unsorted<tree::avl<int>>(cmp, seed, tree::seq);
+    tree::testing::stress_from_unsorted<tree::avl<int>>(cmp, seed, tree::par.on(pool));
+}
+
+TEST_CASE("stress test, traversal, avl", "[avl-rb]")
+{
+    auto cmp = &tree::testing::compare_traverse<int>;
+    auto seed = tree::testing::get_seed();
+    tree::thread_pool pool(4);
+
+    tree::testing::stress_traversal<tree::avl<int>>(cmp, seed, tree::seq);
+    tree::testing::stress_traversal<tree::avl<int>>(cmp, seed, tree::par.on(pool));
+}
+
 TEST_CASE("stress test, insert, splay", "[splay-rb]")
 {
 	using TreeLHS = tree::splay<int>;
@@ -90,6 +209,26 @@ TEST_CASE("stress mixed, splay", "[splay-rb]")
 	tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
 }
 
+TEST_CASE("stress test, from unsorted, splay", "[splay-rb]")
+{
+	auto cmp = &tree::testing::compare_traverse_splay<int>;
+	auto seed = tree::testing::get_seed();
+	tree::thread_pool pool(4);
+
+	tree::testing::stress_from_unsorted<tree::splay<int>>(cmp, seed, tree::seq);
+	tree::testing::stress_from_unsorted<tree::splay<int>>(cmp, seed, tree::par.on(pool));
+}
+
+TEST_CASE("stress test, traversal, splay", "[splay-rb]")
+{
+	auto cmp = &tree::testing::compare_traverse_splay<int>;
+	auto seed = tree::testing::get_seed();
+	tree::thread_pool pool(4);
+
+	tree::testing::stress_traversal<tree::splay<int>>(cmp, seed, tree::seq);
+	tree::testing::stress_traversal<tree::splay<int>>(cmp, seed, tree::par.on(pool));
+}
+
 ///////////////////////////////
 //   CARTESIAN - RED-BLACK   //
 ///////////////////////////////
@@ -132,4 +271,2229 @@ TEST_CASE("stress mixed, cartesian", "[cartesian-rb]")
     auto seed = tree::testing::get_seed();
 
     tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, frequency biased, cartesian", "[cartesian-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+    std::uniform_int_distribution<> operation_dist(0, 3);
+    // a few hot keys take most of the finds, enough of them to pass several decays
+    std::geometric_distribution<> hot_dist(0.05);
+
+    tree::cartesian<int> cartesian_tree;
+    std::set<int> rb_tree;
+    for (int key = -1000; key <= 1000; key += 3)
+    {
+        cartesian_tree.insert(key);
+        rb_tree.insert(key);
+    }
+    cartesian_tree.set_frequency_biased(true);
+
+    for (std::size_t round = 0; round < 50; round++)
+    {
+        for (std::size_t i = 0; i < 1000; i++)
+        {
+            const auto operation = operation_dist(gen);
+            if (operation == 0)
+            {
+                const auto key = key_dist(gen);
+                cartesian_tree.insert(key);
+                rb_tree.insert(key);
+            }
+            else if (operation == 1)
+            {
+                const auto key = key_dist(gen);
+                cartesian_tree.erase(key);
+                rb_tree.erase(key);
+            }
+            else
+            {
+                const auto key = hot_dist(gen) * 3;
+                bool found_in_lhs = cartesian_tree.find(key) != cartesian_tree.end();
+                REQUIRE(found_in_lhs == (rb_tree.count(key) == 1));
+            }
+        }
+        tree::testing::compare_traverse_cartesian<int>(cartesian_tree, rb_tree);
+    }
+
+    // a key hit far more often than any other ends up at the root
+    cartesian_tree.set_frequency_biased(true);
+    cartesian_tree.insert(7);
+    rb_tree.insert(7);
+    for (std::size_t i = 0; i < 64; i++)
+    {
+        cartesian_tree.find(7);
+    }
+    REQUIRE(cartesian_tree.depth(7) == 1);
+
+    cartesian_tree.set_frequency_biased(false);
+    REQUIRE(!cartesian_tree.is_frequency_biased());
+    tree::testing::compare_traverse_cartesian<int>(cartesian_tree, rb_tree);
+}
+
+TEST_CASE("stress test, priority search, cartesian", "[cartesian-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+    // a narrow range of priorities, so that equal ones are common
+    std::uniform_int_distribution<> priority_dist(0, 50);
+    std::uniform_int_distribution<> operation_dist(0, 2);
+
+    tree::cartesian<int> cartesian_tree;
+    std::map<int, int> priorities;
+    for (std::size_t i = 0; i < 20000; i++)
+    {
+        const auto key = key_dist(gen);
+        if (operation_dist(gen) == 0)
+        {
+            cartesian_tree.erase(key);
+            priorities.erase(key);
+        }
+        else
+        {
+            const auto priority = priority_dist(gen);
+            cartesian_tree.insert(key, priority);
+            priorities.emplace(key, priority);
+        }
+
+        const auto lower = key_dist(gen);
+        const auto upper = lower + key_dist(gen) / 4 + 250;
+        const auto threshold = priority_dist(gen);
+
+        std::optional<std::pair<int, int>> expected_max;
+        std::vector<int> expected_keys;
+        for (auto it = priorities.lower_bound(lower); it != priorities.end() && it->first <= upper; ++it)
+        {
+            if (!expected_max || it->second > expected_max->second)
+            {
+                expected_max = *it;
+            }
+            if (it->second >= threshold)
+            {
+                expected_keys.push_back(it->first);
+            }
+        }
+
+        // among equal priorities any key of the range may be on top
+        const auto max = cartesian_tree.max_priority(lower, upper);
+        REQUIRE(max.has_value() == expected_max.has_value());
+        if (max)
+        {
+            REQUIRE(max->second == expected_max->second);
+            REQUIRE(priorities.at(max->first) == max->second);
+            REQUIRE(lower <= max->first);
+            REQUIRE(max->first <= upper);
+        }
+
+        REQUIRE(cartesian_tree.priority_at_least(lower, upper, threshold) == expected_keys);
+
+        const auto priority = cartesian_tree.priority_of(key);
+        REQUIRE(priority.has_value() == (priorities.count(key) == 1));
+        if (priority)
+        {
+            REQUIRE(*priority == priorities.at(key));
+        }
+    }
+
+    REQUIRE(cartesian_tree.size() == priorities.size());
+    REQUIRE(cartesian_tree.is_cartesian());
+}
+
+TEST_CASE("stress test, from unsorted, cartesian", "[cartesian-rb]")
+{
+    auto cmp = &tree::testing::compare_traverse_cartesian<int>;
+    auto seed = tree::testing::get_seed();
+    tree::thread_pool pool(4);
+
+    tree::testing::stress_from_unsorted<tree::cartesian<int>>(cmp, seed, tree::seq);
+    tree::testing::stress_from_unsorted<tree::cartesian<int>>(cmp, seed, tree::par.on(pool));
+}
+
+TEST_CASE("stress test, traversal, cartesian", "[cartesian-rb]")
+{
+    auto cmp = &tree::testing::compare_traverse_cartesian<int>;
+    auto seed = tree::testing::get_seed();
+    tree::thread_pool pool(4);
+
+    tree::testing::stress_traversal<tree::cartesian<int>>(cmp, seed, tree::seq);
+    tree::testing::stress_traversal<tree::cartesian<int>>(cmp, seed, tree::par.on(pool));
+}
+
+/////////////////////////////////////
+//   FROZEN SNAPSHOT - RED-BLACK   //
+/////////////////////////////////////
+
+TEST_CASE("stress test, apply batch, cartesian", "[cartesian-rb]")
+{
+    auto cmp = &tree::testing::compare_traverse_cartesian<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::thread_pool pool(4);
+
+    tree::testing::stress_apply_batch<tree::cartesian<int>>(cmp, seed, tree::seq);
+    tree::testing::stress_apply_batch<tree::cartesian<int>>(cmp, seed, tree::par.on(pool));
+}
+
+TEST_CASE("stress test, freeze, avl", "[static-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_freeze<tree::avl<int>>(seed);
+}
+
+TEST_CASE("stress test, freeze, splay", "[static-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_freeze<tree::splay<int>>(seed);
+}
+
+TEST_CASE("stress test, freeze, cartesian", "[static-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_freeze<tree::cartesian<int>>(seed);
+}
+
+/////////////////////////////////////
+//   SIMD STATIC SET - RED-BLACK   //
+/////////////////////////////////////
+
+TEST_CASE("stress test, simd static set, int", "[simd-rb]")
+{
+    using tree::detail::simd_isa;
+    auto seed = tree::testing::get_seed();
+
+    for (auto isa : {simd_isa::scalar, simd_isa::sse, simd_isa::avx2})
+    {
+        tree::testing::stress_simd_static<tree::simd_static_set<int>>(seed, isa);
+    }
+}
+
+TEST_CASE("stress test, simd static set, int64", "[simd-rb]")
+{
+    using tree::detail::simd_isa;
+    auto seed = tree::testing::get_seed();
+
+    for (auto isa : {simd_isa::scalar, simd_isa::sse, simd_isa::avx2})
+    {
+        tree::testing::stress_simd_static<tree::simd_static_set<std::int64_t>>(seed, isa);
+    }
+}
+
+////////////////////////////
+//   B-TREE - RED-BLACK   //
+////////////////////////////
+
+TEST_CASE("stress test, insert, btree", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 256>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, btree", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 256>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, btree", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 256>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, btree", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 256>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, insert, btree, small nodes", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int, std::less<int>, 32>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 32>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, btree, small nodes", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int, std::less<int>, 32>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 32>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, btree, small nodes", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int, std::less<int>, 32>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 32>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, btree, small nodes", "[btree-rb]")
+{
+    using TreeLHS = tree::btree<int, std::less<int>, 32>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_btree<int, 32>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, bulk load, btree, small nodes", "[btree-rb]")
+{
+    using Tree = tree::btree<int, std::less<int>, 32>;
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    for (std::size_t size = 0; size < 300; size++)
+    {
+        std::set<int> rb_tree;
+        while (rb_tree.size() < size)
+        {
+            rb_tree.insert(key_dist(gen));
+        }
+
+        Tree btree;
+        btree.bulk_load(rb_tree.begin(), rb_tree.end());
+        tree::testing::compare_traverse_btree<int, 32>(btree, rb_tree);
+
+        while (!rb_tree.empty())
+        {
+            const auto key = key_dist(gen);
+            btree.erase(key);
+            rb_tree.erase(key);
+            tree::testing::compare_traverse_btree<int, 32>(btree, rb_tree);
+
+            if (!rb_tree.empty())
+            {
+                const auto first = *rb_tree.begin();
+                btree.erase(first);
+                rb_tree.erase(first);
+                tree::testing::compare_traverse_btree<int, 32>(btree, rb_tree);
+            }
+        }
+    }
+}
+
+/////////////////////////////
+//   RB TREE - RED-BLACK   //
+/////////////////////////////
+
+TEST_CASE("stress test, insert, rb tree", "[rbtree-rb]")
+{
+    using TreeLHS = tree::rb<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rbtree<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, rb tree", "[rbtree-rb]")
+{
+    using TreeLHS = tree::rb<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rbtree<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, rb tree", "[rbtree-rb]")
+{
+    using TreeLHS = tree::rb<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rbtree<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, rb tree", "[rbtree-rb]")
+{
+    using TreeLHS = tree::rb<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rbtree<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+///////////////////////////////
+//   SCAPEGOAT - RED-BLACK   //
+///////////////////////////////
+
+TEST_CASE("stress test, insert, scapegoat", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<2, 3>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, scapegoat", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<2, 3>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, scapegoat", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<2, 3>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, scapegoat", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<2, 3>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, insert, scapegoat, alpha 0.9", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int, std::less<int>, std::ratio<9, 10>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<9, 10>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, scapegoat, alpha 0.9", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int, std::less<int>, std::ratio<9, 10>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<9, 10>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, scapegoat, alpha 0.9", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int, std::less<int>, std::ratio<9, 10>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<9, 10>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, scapegoat, alpha 0.9", "[scapegoat-rb]")
+{
+    using TreeLHS = tree::scapegoat<int, std::less<int>, std::ratio<9, 10>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_scapegoat<int, std::ratio<9, 10>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+/////////////////////////////////////
+//   WEIGHT-BALANCED - RED-BLACK   //
+/////////////////////////////////////
+
+TEST_CASE("stress test, insert, weight balanced", "[wb-rb]")
+{
+    using TreeLHS = tree::weight_balanced<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, weight balanced", "[wb-rb]")
+{
+    using TreeLHS = tree::weight_balanced<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, weight balanced", "[wb-rb]")
+{
+    using TreeLHS = tree::weight_balanced<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, weight balanced", "[wb-rb]")
+{
+    using TreeLHS = tree::weight_balanced<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, select and rank, weight balanced", "[wb-rb]")
+{
+    using Tree = tree::weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    Tree wb_tree;
+    std::set<int> rb_tree;
+    for (std::size_t i = 0; i < 1000; i++)
+    {
+        const auto key = key_dist(gen);
+        wb_tree.insert(key);
+        rb_tree.insert(key);
+
+        const auto value = key_dist(gen);
+        const auto expected_rank = std::distance(rb_tree.begin(), rb_tree.lower_bound(value));
+        REQUIRE(wb_tree.rank(value) == static_cast<std::size_t>(expected_rank));
+    }
+
+    std::size_t index = 0;
+    for (auto key : rb_tree)
+    {
+        REQUIRE(*wb_tree.select(index) == key);
+        REQUIRE(wb_tree.rank(key) == index);
+        index++;
+    }
+    const bool is_out_of_range = wb_tree.select(index) == wb_tree.end();
+    REQUIRE(is_out_of_range);
+}
+
+TEST_CASE("stress test, split and join, weight balanced", "[wb-rb]")
+{
+    using Tree = tree::weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    for (std::size_t size = 0; size < 300; size++)
+    {
+        Tree wb_tree;
+        std::set<int> rb_tree;
+        while (rb_tree.size() < size)
+        {
+            const auto key = key_dist(gen);
+            wb_tree.insert(key);
+            rb_tree.insert(key);
+        }
+
+        const auto key = key_dist(gen);
+        Tree greater = wb_tree.split(key);
+
+        std::set<int> rb_greater(rb_tree.lower_bound(key), rb_tree.end());
+        std::set<int> rb_less(rb_tree.begin(), rb_tree.lower_bound(key));
+        tree::testing::compare_traverse_weight_balanced<int>(wb_tree, rb_less);
+        tree::testing::compare_traverse_weight_balanced<int>(greater, rb_greater);
+
+        wb_tree.join(std::move(greater));
+        REQUIRE(greater.empty());
+        tree::testing::compare_traverse_weight_balanced<int>(wb_tree, rb_tree);
+    }
+}
+
+TEST_CASE("stress test, set operations, weight balanced", "[wb-rb]")
+{
+    using Tree = tree::weight_balanced<int>;
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    tree::thread_pool pool(4);
+
+    // large enough sizes to take the parallel path, with varying overlap
+    for (int range : {100, 10'000, 100'000})
+    {
+        auto check_with = [&](const auto& policy)
+        {
+            std::uniform_int_distribution<> key_dist(0, range);
+
+            auto make_sets = [&](std::size_t count, Tree& wb_tree, std::set<int>& rb_tree)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    const auto key = key_dist(gen);
+                    wb_tree.insert(key);
+                    rb_tree.insert(key);
+                }
+            };
+
+            Tree lhs, rhs, lhs_copy, rhs_copy;
+            std::set<int> rb_lhs, rb_rhs;
+            make_sets(20'000, lhs, rb_lhs);
+            make_sets(5'000, rhs, rb_rhs);
+
+            std::set<int> expected;
+
+            lhs_copy = lhs;
+            rhs_copy = rhs;
+            lhs_copy.unite(std::move(rhs_copy), policy);
+            expected.clear();
+            std::set_union(rb_lhs.begin(), rb_lhs.end(), rb_rhs.begin(), rb_rhs.end(),
+                           std::inserter(expected, expected.end()));
+            tree::testing::compare_traverse_weight_balanced<int>(lhs_copy, expected);
+            REQUIRE(rhs_copy.empty());
+
+            lhs_copy = lhs;
+            rhs_copy = rhs;
+            lhs_copy.intersect(std::move(rhs_copy), policy);
+            expected.clear();
+            std::set_intersection(rb_lhs.begin(), rb_lhs.end(), rb_rhs.begin(), rb_rhs.end(),
+                                  std::inserter(expected, expected.end()));
+            tree::testing::compare_traverse_weight_balanced<int>(lhs_copy, expected);
+
+            lhs_copy = lhs;
+            rhs_copy = rhs;
+            lhs_copy.subtract(std::move(rhs_copy), policy);
+            expected.clear();
+            std::set_difference(rb_lhs.begin(), rb_lhs.end(), rb_rhs.begin(), rb_rhs.end(),
+                                std::inserter(expected, expected.end()));
+            tree::testing::compare_traverse_weight_balanced<int>(lhs_copy, expected);
+        };
+
+        check_with(tree::seq);
+        check_with(tree::par.on(pool));
+    }
+}
+
+///////////////////////////////
+//   SKIP LIST - RED-BLACK   //
+///////////////////////////////
+
+TEST_CASE("stress test, insert, concurrent skiplist", "[skiplist-rb]")
+{
+    using TreeLHS = tree::concurrent_skiplist<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_skiplist<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, concurrent skiplist", "[skiplist-rb]")
+{
+    using TreeLHS = tree::concurrent_skiplist<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_skiplist<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, concurrent skiplist", "[skiplist-rb]")
+{
+    using TreeLHS = tree::concurrent_skiplist<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_skiplist<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, concurrent skiplist", "[skiplist-rb]")
+{
+    using TreeLHS = tree::concurrent_skiplist<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_skiplist<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, lower bound, concurrent skiplist", "[skiplist-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    tree::concurrent_skiplist<int> skiplist;
+    std::set<int> rb_tree;
+    for (std::size_t i = 0; i < 10'000; i++)
+    {
+        const auto key = key_dist(gen);
+        if (i % 3 == 2)
+        {
+            REQUIRE(skiplist.erase(key) == (rb_tree.erase(key) == 1));
+        }
+        else
+        {
+            REQUIRE(skiplist.insert(key) == rb_tree.insert(key).second);
+        }
+
+        const auto value = key_dist(gen);
+        auto lhs_it = skiplist.lower_bound(value);
+        auto rhs_it = rb_tree.lower_bound(value);
+
+        const bool lhs_found = lhs_it != skiplist.end();
+        REQUIRE(lhs_found == (rhs_it != rb_tree.end()));
+        if (lhs_found)
+        {
+            REQUIRE(*lhs_it == *rhs_it);
+        }
+        REQUIRE(skiplist.contains(value) == (rb_tree.count(value) == 1));
+    }
+}
+
+TEST_CASE("stress test, multiple threads, concurrent skiplist", "[skiplist-rb]")
+{
+    constexpr int threads_count = 4;
+    constexpr int keys_per_thread = 20'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::concurrent_skiplist<int> skiplist;
+
+    // every thread owns the keys equal to its index modulo threads_count: it inserts them all,
+    // erases the odd ones and keeps looking up keys of the other threads in the meantime
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, threads_count * keys_per_thread);
+
+        for (int i = 0; i < keys_per_thread; i++)
+        {
+            skiplist.insert(i * threads_count + index);
+            skiplist.contains(key_dist(gen));
+        }
+        for (int i = 1; i < keys_per_thread; i += 2)
+        {
+            skiplist.erase(i * threads_count + index);
+
+            // a copy pins on its own, so it stays valid once the original is gone
+            auto it = skiplist.lower_bound(key_dist(gen));
+            auto copy = it;
+            it = skiplist.end();
+            if (copy != skiplist.end())
+            {
+                ++copy;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<int> rb_tree;
+    for (int index = 0; index < threads_count; index++)
+    {
+        for (int i = 0; i < keys_per_thread; i += 2)
+        {
+            rb_tree.insert(i * threads_count + index);
+        }
+    }
+
+    tree::testing::compare_traverse_skiplist<int>(skiplist, rb_tree);
+}
+
+TEST_CASE("stress test, contended keys, concurrent skiplist", "[skiplist-rb]")
+{
+    constexpr int threads_count = 4;
+    constexpr int operations_per_thread = 50'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::concurrent_skiplist<int> skiplist;
+
+    // all threads fight over the same few keys, each key's net effect is counted
+    std::vector<std::atomic<int>> balance(64);
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, static_cast<int>(balance.size()) - 1);
+
+        for (int i = 0; i < operations_per_thread; i++)
+        {
+            const auto key = key_dist(gen);
+            if (gen() % 2 == 0)
+            {
+                if (skiplist.insert(key))
+                {
+                    balance[key]++;
+                }
+            }
+            else if (skiplist.erase(key))
+            {
+                balance[key]--;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<int> rb_tree;
+    for (std::size_t key = 0; key < balance.size(); key++)
+    {
+        REQUIRE((balance[key] == 0 || balance[key] == 1));
+        if (balance[key] == 1)
+        {
+            rb_tree.insert(static_cast<int>(key));
+        }
+    }
+
+    tree::testing::compare_traverse_skiplist<int>(skiplist, rb_tree);
+}
+
+////////////////////////////////
+//   RADIX TREE - RED-BLACK   //
+////////////////////////////////
+
+TEST_CASE("stress test, insert, art", "[art-rb]")
+{
+    using TreeLHS = tree::art<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_art<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, art", "[art-rb]")
+{
+    using TreeLHS = tree::art<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_art<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, art", "[art-rb]")
+{
+    using TreeLHS = tree::art<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_art<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, art", "[art-rb]")
+{
+    using TreeLHS = tree::art<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_art<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, dense keys, art", "[art-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+
+    // consecutive keys fill the last byte, so nodes grow up to 256 children and shrink back
+    tree::art<std::uint64_t> art;
+    std::set<std::uint64_t> rb_tree;
+    for (std::uint64_t key = 0; key < 4096; key++)
+    {
+        art.insert(key);
+        rb_tree.insert(key);
+    }
+    tree::testing::compare_traverse_art<std::uint64_t>(art, rb_tree);
+
+    std::vector<std::uint64_t> keys(rb_tree.begin(), rb_tree.end());
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        art.erase(keys[i]);
+        rb_tree.erase(keys[i]);
+        if (i % 256 == 0)
+        {
+            tree::testing::compare_traverse_art<std::uint64_t>(art, rb_tree);
+        }
+    }
+    tree::testing::compare_traverse_art<std::uint64_t>(art, rb_tree);
+}
+
+TEST_CASE("stress test, lower bound, art", "[art-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    tree::art<int> art;
+    std::set<int> rb_tree;
+    for (std::size_t i = 0; i < 10'000; i++)
+    {
+        const auto key = key_dist(gen);
+        if (i % 3 == 2)
+        {
+            art.erase(key);
+            rb_tree.erase(key);
+        }
+        else
+        {
+            art.insert(key);
+            rb_tree.insert(key);
+        }
+
+        const auto value = key_dist(gen);
+        auto lhs_it = art.lower_bound(value);
+        auto rhs_it = rb_tree.lower_bound(value);
+
+        const bool lhs_found = lhs_it != art.end();
+        REQUIRE(lhs_found == (rhs_it != rb_tree.end()));
+        if (lhs_found)
+        {
+            REQUIRE(*lhs_it == *rhs_it);
+        }
+    }
+    tree::testing::compare_traverse_art<int>(art, rb_tree);
+}
+
+TEST_CASE("stress test, string keys, art", "[art-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> length_dist(0, 12);
+    std::uniform_int_distribution<> char_dist('a', 'd');
+    std::uniform_int_distribution<> stem_dist(0, 3);
+
+    // few letters and shared stems give long common prefixes, keys that are prefixes
+    // of others, and prefixes longer than the part kept in the nodes
+    const std::string stems[] = {"", "a", "interoperability", "internationalization"};
+    auto get_random_key = [&]()
+    {
+        std::string key = stems[stem_dist(gen)];
+        const auto length = length_dist(gen);
+        for (int i = 0; i < length; i++)
+        {
+            key.push_back(static_cast<char>(char_dist(gen)));
+        }
+        return key;
+    };
+
+    tree::art<std::string> art;
+    std::set<std::string> rb_tree;
+    for (std::size_t i = 0; i < 20'000; i++)
+    {
+        const auto key = get_random_key();
+        if (i % 3 == 2)
+        {
+            art.erase(key);
+            rb_tree.erase(key);
+        }
+        else
+        {
+            art.insert(key);
+            rb_tree.insert(key);
+        }
+
+        const auto value = get_random_key();
+        REQUIRE((art.find(value) != art.end()) == (rb_tree.count(value) == 1));
+
+        auto lhs_it = art.lower_bound(value);
+        auto rhs_it = rb_tree.lower_bound(value);
+        const bool lhs_found = lhs_it != art.end();
+        REQUIRE(lhs_found == (rhs_it != rb_tree.end()));
+        if (lhs_found)
+        {
+            REQUIRE(*lhs_it == *rhs_it);
+        }
+
+        if (i % 1000 == 0)
+        {
+            tree::testing::compare_traverse_art<std::string>(art, rb_tree);
+        }
+    }
+    tree::testing::compare_traverse_art<std::string>(art, rb_tree);
+}
+
+///////////////////////////////////////////
+//   INTEGER SUCCESSOR SET - RED-BLACK   //
+///////////////////////////////////////////
+
+TEST_CASE("stress test, dense keys, int successor set", "[veb-rb]")
+{
+    using SetLHS = tree::int_successor_set<32>;
+    auto cmp = &tree::testing::compare_traverse_int_successor_set<32>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_successor<SetLHS>(cmp, seed, 2000);
+}
+
+TEST_CASE("stress test, sparse keys, int successor set", "[veb-rb]")
+{
+    using SetLHS = tree::int_successor_set<32>;
+    auto cmp = &tree::testing::compare_traverse_int_successor_set<32>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_successor<SetLHS>(cmp, seed, std::numeric_limits<std::uint32_t>::max());
+}
+
+TEST_CASE("stress test, small universes, int successor set", "[veb-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    // a single bitmap leaf, and a node whose clusters are packed by rank
+    tree::testing::stress_successor<tree::int_successor_set<10>>(
+            &tree::testing::compare_traverse_int_successor_set<10>, seed, (1u << 10) - 1);
+    tree::testing::stress_successor<tree::int_successor_set<20>>(
+            &tree::testing::compare_traverse_int_successor_set<20>, seed, (1u << 20) - 1);
+    tree::testing::stress_successor<tree::int_successor_set<20>>(
+            &tree::testing::compare_traverse_int_successor_set<20>, seed, 5000);
+
+    tree::int_successor_set<10> set;
+    REQUIRE_THROWS_AS(set.insert(1u << 10), std::out_of_range);
+    REQUIRE_FALSE(set.erase(1u << 10));
+    REQUIRE_FALSE(set.contains(1u << 10));
+}
+
+/////////////////////////
+//   ZIP - RED-BLACK   //
+/////////////////////////
+
+TEST_CASE("stress test, insert, zip", "[zip-rb]")
+{
+    using TreeLHS = tree::zip<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_zip<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, zip", "[zip-rb]")
+{
+    using TreeLHS = tree::zip<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_zip<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, zip", "[zip-rb]")
+{
+    using TreeLHS = tree::zip<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_zip<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, zip", "[zip-rb]")
+{
+    using TreeLHS = tree::zip<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_zip<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+//////////////////////////
+//   WAVL - RED-BLACK   //
+//////////////////////////
+
+TEST_CASE("stress test, insert, wavl", "[wavl-rb]")
+{
+    using TreeLHS = tree::wavl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_wavl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, wavl", "[wavl-rb]")
+{
+    using TreeLHS = tree::wavl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_wavl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, wavl", "[wavl-rb]")
+{
+    using TreeLHS = tree::wavl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_wavl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, wavl", "[wavl-rb]")
+{
+    using TreeLHS = tree::wavl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_wavl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+/////////////////////////////////////
+//   WEIGHTED STATIC - RED-BLACK   //
+/////////////////////////////////////
+
+TEST_CASE("stress test, random weights, weighted static", "[weighted-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+    std::uniform_int_distribution<> weight_dist(0, 3);
+    std::exponential_distribution<> heavy_dist(0.01);
+
+    for (std::size_t iter = 0; iter < 100; iter++)
+    {
+        // duplicates add up, a quarter of the keys is never accessed
+        std::vector<std::pair<int, double>> weights;
+        std::set<int> rb_tree;
+        for (std::size_t i = 0; i < 500; i++)
+        {
+            const auto key = key_dist(gen);
+            weights.emplace_back(key, weight_dist(gen) == 0 ? 0.0 : heavy_dist(gen));
+            rb_tree.insert(key);
+        }
+
+        const tree::weighted_static<int> weighted(weights.begin(), weights.end());
+        REQUIRE(weighted.size() == rb_tree.size());
+        REQUIRE(weighted.is_search_tree());
+
+        auto rb_it = rb_tree.cbegin();
+        for (auto weighted_element : weighted)
+        {
+            REQUIRE(weighted_element == *rb_it++);
+        }
+
+        auto rb_rit = rb_tree.crbegin();
+        for (auto it = weighted.end(); it != weighted.begin();)
+        {
+            REQUIRE(*--it == *rb_rit++);
+        }
+
+        for (std::size_t find = 0; find < 500; find++)
+        {
+            const auto key = key_dist(gen);
+            REQUIRE(weighted.contains(key) == (rb_tree.count(key) == 1));
+            REQUIRE((weighted.depth(key) != 0) == (rb_tree.count(key) == 1));
+        }
+    }
+
+    const tree::weighted_static<int> empty;
+    REQUIRE(empty.is_search_tree());
+    REQUIRE(empty.find(0) == empty.end());
+
+    REQUIRE_THROWS_AS((tree::weighted_static<int>{{1, 1.0}, {2, -1.0}}), std::invalid_argument);
+}
+
+TEST_CASE("stress test, access weights, avl", "[weighted-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_access_weights<tree::avl<int>, tree::weighted_static<int>>(seed);
+}
+
+TEST_CASE("stress test, access weights, splay", "[weighted-rb]")
+{
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_access_weights<tree::splay<int>, tree::weighted_static<int>>(seed);
+}
+
+TEST_CASE("weighted static is shallower than avl on skewed weights", "[weighted-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+
+    // Zipf weights 1 / rank over shuffled keys
+    std::vector<int> keys(10'000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), gen);
+
+    tree::avl<int> avl_tree;
+    std::vector<std::pair<int, double>> weights;
+    for (std::size_t rank = 0; rank < keys.size(); rank++)
+    {
+        avl_tree.insert(keys[rank]);
+        weights.emplace_back(keys[rank], 1.0 / static_cast<double>(rank + 1));
+    }
+
+    const tree::weighted_static<int> weighted(weights.begin(), weights.end());
+
+    double total = 0;
+    double avl_depth = 0;
+    for (const auto& [key, weight] : weights)
+    {
+        total += weight;
+        avl_depth += weight * static_cast<double>(avl_tree.depth(key));
+    }
+    avl_depth /= total;
+
+    REQUIRE(weighted.expected_depth() < avl_depth);
+}
+
+/////////////////////////////
+//   SHARDED - RED-BLACK   //
+/////////////////////////////
+
+TEST_CASE("stress test, insert, sharded", "[sharded-rb]")
+{
+    using TreeLHS = tree::sharded<tree::avl<int>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_sharded<tree::avl<int>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, sharded", "[sharded-rb]")
+{
+    using TreeLHS = tree::sharded<tree::splay<int>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_sharded<tree::splay<int>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, sharded", "[sharded-rb]")
+{
+    using TreeLHS = tree::sharded<tree::cartesian<int>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_sharded<tree::cartesian<int>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, sharded", "[sharded-rb]")
+{
+    using TreeLHS = tree::sharded<tree::avl<int>, 4>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_sharded<tree::avl<int>, 4>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed, -1000, 1000, 20);
+}
+
+TEST_CASE("stress test, skewed inserts, sharded", "[sharded-rb]")
+{
+    // increasing keys all land in the last shard until an insert rebalances
+    tree::sharded<tree::avl<int>> sharded;
+    std::set<int> rb_tree;
+    for (int key = 0; key < 50'000; key++)
+    {
+        sharded.insert(key);
+        rb_tree.insert(key);
+    }
+
+    REQUIRE(sharded.is_sharded());
+    for (std::size_t index = 0; index < sharded.shards_count; index++)
+    {
+        REQUIRE(sharded.shard_size(index) <= 2 * rb_tree.size() / sharded.shards_count);
+    }
+
+    auto it = sharded.find(500);
+    REQUIRE(it != sharded.end());
+    for (int key = 500; key < 600; key++)
+    {
+        REQUIRE(*it++ == key);
+    }
+    bool is_missing_found = sharded.find(-1) != sharded.end();
+    REQUIRE(!is_missing_found);
+
+    tree::testing::compare_traverse_sharded(sharded, rb_tree);
+}
+
+TEST_CASE("stress test, multiple threads, sharded", "[sharded-rb]")
+{
+    constexpr int threads_count = 4;
+    constexpr int keys_per_thread = 10'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::sharded<tree::splay<int>> sharded;
+    std::atomic<bool> is_done{false};
+
+    // as for the skip list, every thread owns the keys equal to its index modulo threads_count;
+    // the keys arrive in increasing order, so inserts keep rebalancing under the readers
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, threads_count * keys_per_thread);
+
+        for (int i = 0; i < keys_per_thread; i++)
+        {
+            sharded.insert(i * threads_count + index);
+            sharded.contains(key_dist(gen));
+        }
+        for (int i = 1; i < keys_per_thread; i += 2)
+        {
+            sharded.erase(i * threads_count + index);
+            sharded.contains(key_dist(gen));
+        }
+    };
+
+    // the keys of a weakly consistent iteration still come in increasing order
+    bool is_increasing = true;
+    std::thread reader([&]()
+    {
+        for (int pass = 0; pass < 50 && !is_done.load(); pass++)
+        {
+            std::optional<int> previous;
+            for (const auto& key : sharded)
+            {
+                is_increasing = is_increasing && (!previous || *previous < key);
+                previous = key;
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    is_done.store(true);
+    reader.join();
+    REQUIRE(is_increasing);
+
+    std::set<int> rb_tree;
+    for (int index = 0; index < threads_count; index++)
+    {
+        for (int i = 0; i < keys_per_thread; i += 2)
+        {
+            rb_tree.insert(i * threads_count + index);
+        }
+    }
+
+    tree::testing::compare_traverse_sharded(sharded, rb_tree);
+}
+
+/////////////////////////////
+//   RCU AVL - RED-BLACK   //
+/////////////////////////////
+
+TEST_CASE("stress test, insert, rcu avl", "[rcu-rb]")
+{
+    using TreeLHS = tree::rcu_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rcu_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, rcu avl", "[rcu-rb]")
+{
+    using TreeLHS = tree::rcu_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rcu_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, rcu avl", "[rcu-rb]")
+{
+    using TreeLHS = tree::rcu_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rcu_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, rcu avl", "[rcu-rb]")
+{
+    using TreeLHS = tree::rcu_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_rcu_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed, -1000, 1000, 20);
+}
+
+TEST_CASE("stress test, copy, rcu avl", "[rcu-rb]")
+{
+    tree::rcu_avl<int> rcu_avl;
+    std::set<int> rb_tree;
+    for (int key = 0; key < 1000; key += 3)
+    {
+        rcu_avl.insert(key);
+        rb_tree.insert(key);
+    }
+
+    // the copy is built balanced from the sorted keys
+    tree::rcu_avl<int> copy(rcu_avl);
+    tree::testing::compare_traverse_rcu_avl(copy, rb_tree);
+
+    copy.erase(3);
+    tree::testing::compare_traverse_rcu_avl(rcu_avl, rb_tree);
+
+    rcu_avl = std::move(copy);
+    rb_tree.erase(3);
+    tree::testing::compare_traverse_rcu_avl(rcu_avl, rb_tree);
+}
+
+TEST_CASE("stress test, readers with a writer, rcu avl", "[rcu-rb]")
+{
+    constexpr int readers_count = 3;
+    constexpr int keys_count = 2'000;
+    auto seed = tree::testing::get_seed();
+
+    // even keys stay for the whole test, the writer toggles the odd ones
+    tree::rcu_avl<int> rcu_avl;
+    for (int key = 0; key < keys_count; key += 2)
+    {
+        rcu_avl.insert(key);
+    }
+
+    std::atomic<bool> is_done{false};
+    std::thread writer([&]()
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> key_dist(0, keys_count / 2 - 1);
+        for (int i = 0; i < 20'000; i++)
+        {
+            const int key = 2 * key_dist(gen) + 1;
+            if (!rcu_avl.insert(key))
+            {
+                rcu_avl.erase(key);
+            }
+        }
+        is_done.store(true);
+    });
+
+    // a snapshot does not change under the writer: two walks over it agree, and lookups
+    // on it see exactly the keys of the walk
+    std::atomic<bool> is_consistent{true};
+    auto reader = [&]()
+    {
+        for (int pass = 0; pass < 200 && !is_done.load(); pass++)
+        {
+            const auto snapshot = rcu_avl.read();
+            const std::vector<int> first(snapshot.begin(), snapshot.end());
+            const std::vector<int> second(snapshot.begin(), snapshot.end());
+
+            bool is_valid = first == second && std::is_sorted(first.begin(), first.end());
+            for (int key = 0; key < keys_count && is_valid; key++)
+            {
+                const bool in_walk = std::binary_search(first.begin(), first.end(), key);
+                is_valid = snapshot.contains(key) == in_walk && (key % 2 == 1 || in_walk);
+            }
+            if (!is_valid)
+            {
+                is_consistent.store(false);
+            }
+            std::this_thread::yield();
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int index = 0; index < readers_count; index++)
+    {
+        readers.emplace_back(reader);
+    }
+    for (auto& thread : readers)
+    {
+        thread.join();
+    }
+    writer.join();
+    REQUIRE(is_consistent.load());
+    REQUIRE(rcu_avl.is_avl());
+
+    rcu_avl.clear();
+    REQUIRE(rcu_avl.empty());
+    REQUIRE(rcu_avl.begin() == rcu_avl.end());
+}
+
+////////////////////////////////////
+//   CONCURRENT AVL - RED-BLACK   //
+////////////////////////////////////
+
+TEST_CASE("stress test, insert, concurrent avl", "[concurrent-avl-rb]")
+{
+    using TreeLHS = tree::concurrent_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_concurrent_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, concurrent avl", "[concurrent-avl-rb]")
+{
+    using TreeLHS = tree::concurrent_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_concurrent_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, find, concurrent avl", "[concurrent-avl-rb]")
+{
+    using TreeLHS = tree::concurrent_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_concurrent_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_find<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, concurrent avl", "[concurrent-avl-rb]")
+{
+    using TreeLHS = tree::concurrent_avl<int>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_concurrent_avl<int>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_mixed<TreeLHS, TreeRHS>(cmp, seed, -1000, 1000, 20);
+}
+
+TEST_CASE("stress test, multiple threads, concurrent avl", "[concurrent-avl-rb]")
+{
+    constexpr int threads_count = 4;
+    constexpr int keys_per_thread = 20'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::concurrent_avl<int> concurrent_avl;
+
+    // as for the skip list, every thread owns the keys equal to its index modulo threads_count
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, threads_count * keys_per_thread);
+
+        for (int i = 0; i < keys_per_thread; i++)
+        {
+            concurrent_avl.insert(i * threads_count + index);
+            concurrent_avl.contains(key_dist(gen));
+        }
+        for (int i = 1; i < keys_per_thread; i += 2)
+        {
+            concurrent_avl.erase(i * threads_count + index);
+            concurrent_avl.find(key_dist(gen));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<int> rb_tree;
+    for (int index = 0; index < threads_count; index++)
+    {
+        for (int i = 0; i < keys_per_thread; i += 2)
+        {
+            rb_tree.insert(i * threads_count + index);
+        }
+    }
+
+    // every thread repaired the heights on its way up, so the tree is strictly balanced again
+    tree::testing::compare_traverse_concurrent_avl<int>(concurrent_avl, rb_tree);
+}
+
+TEST_CASE("stress test, contended keys, concurrent avl", "[concurrent-avl-rb]")
+{
+    constexpr int threads_count = 4;
+    constexpr int operations_per_thread = 50'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::concurrent_avl<int> concurrent_avl;
+
+    // all threads fight over the same few keys, each key's net effect is counted
+    std::vector<std::atomic<int>> balance(64);
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, static_cast<int>(balance.size()) - 1);
+
+        for (int i = 0; i < operations_per_thread; i++)
+        {
+            const auto key = key_dist(gen);
+            if (gen() % 2 == 0)
+            {
+                if (concurrent_avl.insert(key))
+                {
+                    balance[key]++;
+                }
+            }
+            else if (concurrent_avl.erase(key))
+            {
+                balance[key]--;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<int> rb_tree;
+    for (int key = 0; key < static_cast<int>(balance.size()); key++)
+    {
+        REQUIRE((balance[key] == 0 || balance[key] == 1));
+        if (balance[key] == 1)
+        {
+            rb_tree.insert(key);
+        }
+    }
+
+    tree::testing::compare_traverse_concurrent_avl<int>(concurrent_avl, rb_tree);
+}
+
+///////////////////////////////
+//   COMBINING - RED-BLACK   //
+///////////////////////////////
+
+TEST_CASE("stress test, insert, combining", "[combining-rb]")
+{
+    using TreeLHS = tree::combining<tree::avl<int>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_combining<tree::avl<int>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_insert<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress test, erase, combining", "[combining-rb]")
+{
+    using TreeLHS = tree::combining<tree::cartesian<int>>;
+    using TreeRHS = std::set<int>;
+    auto cmp = &tree::testing::compare_traverse_combining<tree::cartesian<int>>;
+    auto seed = tree::testing::get_seed();
+
+    tree::testing::stress_erase<TreeLHS, TreeRHS>(cmp, seed);
+}
+
+TEST_CASE("stress mixed, combining", "[combining-rb]")
+{
+    // no iterators to compare, the results of the operations are checked instead
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    tree::combining<tree::splay<int>, 4> combining;
+    std::set<int> rb_tree;
+    for (int i = 0; i < 100'000; i++)
+    {
+        const int key = key_dist(gen);
+        switch (gen() % 3)
+        {
+            case 0:
+                REQUIRE(combining.insert(key) == rb_tree.insert(key).second);
+                break;
+            case 1:
+                REQUIRE(combining.erase(key) == (rb_tree.erase(key) == 1));
+                break;
+            default:
+                REQUIRE(combining.contains(key) == (rb_tree.count(key) == 1));
+                break;
+        }
+    }
+
+    tree::testing::compare_traverse_combining(combining, rb_tree);
+}
+
+TEST_CASE("stress test, multiple threads, combining", "[combining-rb]")
+{
+    constexpr int threads_count = 4;
+    constexpr int keys_per_thread = 20'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::combining<tree::avl<int>> combining;
+
+    // as for the skip list, every thread owns the keys equal to its index modulo threads_count
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, threads_count * keys_per_thread);
+
+        for (int i = 0; i < keys_per_thread; i++)
+        {
+            combining.insert(i * threads_count + index);
+            combining.contains(key_dist(gen));
+        }
+        for (int i = 1; i < keys_per_thread; i += 2)
+        {
+            combining.erase(i * threads_count + index);
+            combining.contains(key_dist(gen));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<int> rb_tree;
+    for (int index = 0; index < threads_count; index++)
+    {
+        for (int i = 0; i < keys_per_thread; i += 2)
+        {
+            rb_tree.insert(i * threads_count + index);
+        }
+    }
+
+    REQUIRE(combining.combined_batches() <= combining.combined_operations());
+    tree::testing::compare_traverse_combining(combining, rb_tree);
+}
+
+TEST_CASE("stress test, contended keys, combining", "[combining-rb]")
+{
+    // more threads than records, so some of them go around the combiner
+    constexpr int threads_count = 6;
+    constexpr int operations_per_thread = 20'000;
+    auto seed = tree::testing::get_seed();
+
+    tree::combining<tree::cartesian<int>, 4> combining;
+
+    // all threads fight over the same few keys, each key's net effect is counted
+    std::vector<std::atomic<int>> balance(64);
+    auto worker = [&](int index)
+    {
+        std::mt19937 gen(seed + index);
+        std::uniform_int_distribution<> key_dist(0, static_cast<int>(balance.size()) - 1);
+
+        for (int i = 0; i < operations_per_thread; i++)
+        {
+            const auto key = key_dist(gen);
+            if (gen() % 2 == 0)
+            {
+                if (combining.insert(key))
+                {
+                    balance[key]++;
+                }
+            }
+            else if (combining.erase(key))
+            {
+                balance[key]--;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int index = 0; index < threads_count; index++)
+    {
+        threads.emplace_back(worker, index);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<int> rb_tree;
+    for (int key = 0; key < static_cast<int>(balance.size()); key++)
+    {
+        REQUIRE((balance[key] == 0 || balance[key] == 1));
+        if (balance[key] == 1)
+        {
+            rb_tree.insert(key);
+        }
+    }
+
+    tree::testing::compare_traverse_combining(combining, rb_tree);
+}
+
+///////////////////////////////
+//   SEQLOCKED - RED-BLACK   //
+///////////////////////////////
+
+TEST_CASE("stress mixed, seqlocked avl", "[seqlocked-rb]")
+{
+    // no iterators to compare, the results of the operations are checked instead
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    tree::seqlocked<tree::avl<int>> seqlocked;
+    std::set<int> rb_tree;
+    for (int i = 0; i < 100'000; i++)
+    {
+        const int key = key_dist(gen);
+        switch (gen() % 4)
+        {
+            case 0:
+                REQUIRE(seqlocked.insert(key) == rb_tree.insert(key).second);
+                break;
+            case 1:
+                REQUIRE(seqlocked.erase(key) == (rb_tree.erase(key) == 1));
+                break;
+            case 2:
+                REQUIRE(seqlocked.contains(key) == (rb_tree.count(key) == 1));
+                break;
+            default:
+            {
+                const auto bound = rb_tree.lower_bound(key);
+                REQUIRE(seqlocked.lower_bound(key) == (bound == rb_tree.end() ? std::nullopt
+                                                                                : std::optional<int>(*bound)));
+                break;
+            }
+        }
+    }
+
+    tree::testing::compare_traverse_seqlocked(seqlocked, rb_tree);
+
+    seqlocked.clear();
+    REQUIRE(seqlocked.empty());
+    REQUIRE(seqlocked.keys().empty());
+}
+
+TEST_CASE("stress mixed, seqlocked cartesian", "[seqlocked-rb]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    tree::seqlocked<tree::cartesian<int>> seqlocked{5, -5, 0};
+    std::set<int> rb_tree{5, -5, 0};
+    for (int i = 0; i < 100'000; i++)
+    {
+        const int key = key_dist(gen);
+        switch (gen() % 4)
+        {
+            case 0:
+                REQUIRE(seqlocked.insert(key) == rb_tree.insert(key).second);
+                break;
+            case 1:
+                REQUIRE(seqlocked.erase(key) == (rb_tree.erase(key) == 1));
+                break;
+            case 2:
+                REQUIRE(seqlocked.find(key) == (rb_tree.count(key) == 1 ? std::optional<int>(key)
+                                                                        : std::nullopt));
+                break;
+            default:
+            {
+                const auto bound = rb_tree.lower_bound(key);
+                REQUIRE(seqlocked.lower_bound(key) == (bound == rb_tree.end() ? std::nullopt
+                                                                                : std::optional<int>(*bound)));
+                break;
+            }
+        }
+    }
+
+    tree::testing::compare_traverse_seqlocked(seqlocked, rb_tree);
+}
+
+// the readers race with the writer by design, see seqlocked.hpp
+#if !TREELIB_THREAD_SANITIZER
+TEST_CASE("stress test, readers with a writer, seqlocked", "[seqlocked-rb]")
+{
+    constexpr int readers_count = 3;
+    constexpr int keys_count = 2'000;
+    auto seed = tree::testing::get_seed();
+
+    // even keys stay for the whole test, the writer toggles the odd ones, so erased
+    // nodes are reused by the next inserts while the readers may still be on them
+    auto torture = [&](auto& seqlocked)
+    {
+        for (int key = 0; key < keys_count; key += 2)
+        {
+            seqlocked.insert(key);
+        }
+
+        const auto initial = seqlocked.keys();
+        std::set<int> rb_tree(initial.begin(), initial.end());
+        std::atomic<bool> is_done{false};
+        std::thread writer([&]()
+        {
+            std::mt19937 gen(seed);
+            std::uniform_int_distribution<> key_dist(0, keys_count / 2 - 1);
+            for (int i = 0; i < 50'000; i++)
+            {
+                const int key = 2 * key_dist(gen) + 1;
+                if (seqlocked.insert(key))
+                {
+                    rb_tree.insert(key);
+                }
+                else
+                {
+                    seqlocked.erase(key);
+                    rb_tree.erase(key);
+                }
+            }
+            is_done.store(true);
+        });
+
+        // every read is as of one moment: even keys are always found, the bound of an odd
+        // key is the key or the even one after it, and a walk is sorted with every even key
+        std::atomic<bool> is_consistent{true};
+        auto reader = [&](int index)
+        {
+            std::mt19937 gen(seed + index + 1);
+            std::uniform_int_distribution<> key_dist(0, keys_count / 2 - 1);
+            for (int i = 0; !is_done.load(); i++)
+            {
+                const int even = 2 * key_dist(gen);
+                const int odd = even + 1;
+                const auto bound = seqlocked.lower_bound(odd);
+
+                bool is_valid = seqlocked.contains(even) && seqlocked.find(even) == std::optional<int>(even);
+                is_valid = is_valid && (bound.has_value() ? *bound == odd || *bound == odd + 1
+                                                          : odd + 1 == keys_count);
+                if (i % 256 == 0)
+                {
+                    const auto keys = seqlocked.keys();
+                    is_valid = is_valid && std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<>()) == keys.end();
+                    is_valid = is_valid && std::count_if(keys.begin(), keys.end(), [](int key) { return key % 2 == 0; })
+                                           == keys_count / 2;
+                }
+                if (!is_valid)
+                {
+                    is_consistent.store(false);
+                }
+            }
+        };
+
+        std::vector<std::thread> readers;
+        for (int index = 0; index < readers_count; index++)
+        {
+            readers.emplace_back(reader, index);
+        }
+        writer.join();
+        for (auto& thread : readers)
+        {
+            thread.join();
+        }
+        REQUIRE(is_consistent.load());
+
+        tree::testing::compare_traverse_seqlocked(seqlocked, rb_tree);
+    };
+
+    tree::seqlocked<tree::avl<int>> seqlocked_avl;
+    torture(seqlocked_avl);
+
+    tree::seqlocked<tree::cartesian<int>> seqlocked_cartesian;
+    torture(seqlocked_cartesian);
+}
+#endif
+
+//////////////////////////////////////
+//   CONCURRENT SPLAY - RED-BLACK   //
+//////////////////////////////////////
+
+TEST_CASE("stress mixed, concurrent splay", "[concurrent-splay-rb]")
+{
+    // no iterators to compare, the results of the operations are checked instead
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> key_dist(-1000, 1000);
+
+    tree::concurrent_splay<int> concurrent_splay{7, -7, 0};
+    std::set<int> rb_tree{7, -7, 0};
+    for (int i = 0; i < 100'000; i++)
+    {
+        const int key = key_dist(gen);
+        switch (gen() % 4)
+        {
+            case 0:
+                REQUIRE(concurrent_splay.insert(key) == rb_tree.insert(key).second);
+                break;
+            case 1:
+                REQUIRE(concurrent_splay.erase(key) == (rb_tree.erase(key) == 1));
+                break;
+            case 2:
+                REQUIRE(concurrent_splay.contains(key) == (rb_tree.count(key) == 1));
+                break;
+            default:
+                REQUIRE(concurrent_splay.find(key) == (rb_tree.count(key) == 1 ? std::optional<int>(key)
+                                                                               : std::nullopt));
+                break;
+        }
+    }
+
+    tree::testing::compare_traverse_concurrent_splay(concurrent_splay, rb_tree);
+
+    concurrent_splay.clear();
+    REQUIRE(concurrent_splay.empty());
+}
+
+TEST_CASE("stress test, deferred splays, concurrent splay", "[concurrent-splay-rb]")
+{
+    using ConcurrentSplay = tree::concurrent_splay<int>;
+    auto seed = tree::testing::get_seed();
+
+    std::vector<int> keys(1'000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+
+    ConcurrentSplay concurrent_splay;
+    for (auto key : keys)
+    {
+        concurrent_splay.insert(key);
+    }
+
+    // lookups alone do not move the key
+    const int hot = keys.front();
+    const std::size_t depth_before = concurrent_splay.depth(hot);
+    REQUIRE(concurrent_splay.contains(hot));
+    REQUIRE(concurrent_splay.depth(hot) == depth_before);
+
+    // the logged splay is applied on request
+    concurrent_splay.maintain();
+    REQUIRE(concurrent_splay.depth(hot) == 1);
+    REQUIRE(concurrent_splay.deferred_splays() == 1);
+
+    // a full buffer runs the maintenance step on its own
+    const int other = keys.back();
+    for (std::size_t i = 0; i < ConcurrentSplay::buffer_size; i++)
+    {
+        REQUIRE(concurrent_splay.contains(other));
+    }
+    REQUIRE(concurrent_splay.depth(other) == 1);
+    REQUIRE(concurrent_splay.maintenance_steps() == 2);
+
+    // a key erased after its lookup is logged leaves the tree as it is
+    REQUIRE(concurrent_splay.contains(hot));
+    REQUIRE(concurrent_splay.erase(hot));
+    concurrent_splay.maintain();
+    REQUIRE(concurrent_splay.depth(hot) == 0);
+    REQUIRE(concurrent_splay.size() == keys.size() - 1);
+}
+
+TEST_CASE("stress test, readers with a writer, concurrent splay", "[concurrent-splay-rb]")
+{
+    constexpr int readers_count = 3;
+    constexpr int keys_count = 2'000;
+    auto seed = tree::testing::get_seed();
+
+    // even keys stay for the whole test, the writer toggles the odd ones
+    tree::concurrent_splay<int> concurrent_splay;
+    for (int key = 0; key < keys_count; key += 2)
+    {
+        concurrent_splay.insert(key);
+    }
+
+    std::set<int> rb_tree;
+    for (auto key : concurrent_splay.keys())
+    {
+        rb_tree.insert(key);
+    }
+
+    std::atomic<bool> is_done{false};
+    std::thread writer([&]()
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> key_dist(0, keys_count / 2 - 1);
+        for (int i = 0; i < 20'000; i++)
+        {
+            const int key = 2 * key_dist(gen) + 1;
+            if (concurrent_splay.insert(key))
+            {
+                rb_tree.insert(key);
+            }
+            else
+            {
+                concurrent_splay.erase(key);
+                rb_tree.erase(key);
+            }
+        }
+        is_done.store(true);
+    });
+
+    // readers fill their buffers and run maintenance steps between the writes
+    std::atomic<bool> is_consistent{true};
+    auto reader = [&](int index)
+    {
+        std::mt19937 gen(seed + index + 1);
+        std::uniform_int_distribution<> key_dist(0, keys_count / 2 - 1);
+        while (!is_done.load())
+        {
+            const int even = 2 * key_dist(gen);
+            if (concurrent_splay.find(even) != std::optional<int>(even))
+            {
+                is_consistent.store(false);
+            }
+            concurrent_splay.contains(even + 1);
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int index = 0; index < readers_count; index++)
+    {
+        readers.emplace_back(reader, index);
+    }
+    writer.join();
+    for (auto& thread : readers)
+    {
+        thread.join();
+    }
+
+    REQUIRE(is_consistent.load());
+    tree::testing::compare_traverse_concurrent_splay(concurrent_splay, rb_tree);
+}
+
+/////////////////////
+//   THREAD POOL   //
+/////////////////////
+
+TEST_CASE("stress test, fork join, thread pool", "[thread-pool]")
+{
+    auto seed = tree::testing::get_seed();
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> value_dist(-1000, 1000);
+
+    std::vector<long long> values(100'000);
+    for (auto& value : values)
+    {
+        value = value_dist(gen);
+    }
+    const long long expected = std::accumulate(values.begin(), values.end(), 0LL);
+
+    // small leaves, so that forks nest deep and get stolen
+    std::function<long long(tree::thread_pool&, std::size_t, std::size_t)> sum;
+    sum = [&](tree::thread_pool& pool, std::size_t first, std::size_t last)
+    {
+        if (last - first <= 64)
+        {
+            return std::accumulate(values.begin() + first, values.begin() + last, 0LL);
+        }
+        const std::size_t middle = first + (last - first) / 2;
+        const auto halves = pool.fork_join([&]() { return sum(pool, first, middle); },
+                                           [&]() { return sum(pool, middle, last); });
+        return halves.first + halves.second;
+    };
+
+    for (std::size_t threads : {1, 2, 4})
+    {
+        tree::thread_pool pool(threads);
+        REQUIRE(pool.size() == threads);
+        REQUIRE(!pool.is_worker());
+        REQUIRE(sum(pool, 0, values.size()) == expected);
+
+        // tasks that return nothing, forked on the pool or run one after the other
+        for (tree::thread_pool* executor : {&pool, static_cast<tree::thread_pool*>(nullptr)})
+        {
+            std::atomic<std::size_t> leaves{0};
+            std::function<void(std::size_t)> count;
+            count = [&](std::size_t depth)
+            {
+                if (depth == 0)
+                {
+                    leaves++;
+                    return;
+                }
+                tree::detail::fork_join(executor, [&]() { count(depth - 1); }, [&]() { count(depth - 1); });
+            };
+            count(12);
+            REQUIRE(leaves.load() == 4096);
+        }
+
+        // an exception of either half reaches the caller, and the pool goes on
+        REQUIRE_THROWS_AS(pool.fork_join([]() -> int { throw std::runtime_error("lhs"); },
+                                         []() { return 0; }), std::runtime_error);
+        REQUIRE_THROWS_AS(pool.fork_join([]() { return 0; },
+                                         []() -> int { throw std::runtime_error("rhs"); }), std::runtime_error);
+        REQUIRE(pool.run([&]() { return pool.is_worker(); }));
+    }
+
+    // jobs from several threads at once, on a dedicated pool and on the shared one
+    tree::thread_pool pool(3);
+    std::atomic<bool> is_consistent{true};
+    std::vector<std::thread> submitters;
+    for (int index = 0; index < 4; index++)
+    {
+        submitters.emplace_back([&, index]()
+        {
+            tree::thread_pool& target = index % 2 == 0 ? pool : tree::thread_pool::shared();
+            for (int round = 0; round < 20; round++)
+            {
+                if (sum(target, 0, values.size()) != expected)
+                {
+                    is_consistent.store(false);
+                }
+            }
+        });
+    }
+    for (auto& thread : submitters)
+    {
+        thread.join();
+    }
+    REQUIRE(is_consistent.load());
 }
\ No newline at end of file
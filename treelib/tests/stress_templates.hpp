@@ -6,9 +6,22 @@
 #include <iostream>
 #include <memory>
 #include <set>
+#include <map>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
 
 #include "seed.hpp"
 #include "operations.hpp"
+#include "detail/batch.hpp"
+#include "execution.hpp"
 
 namespace tree::testing
 {
@@ -243,4 +256,484 @@ namespace tree::testing
         }
     }
 
+    template <typename Tree>
+    void stress_freeze(unsigned int seed,
+                       int key_lhs = -1000, int key_rhs = 1000,
+                       std::size_t number_of_iterations = 100,
+                       std::size_t operations_per_iteration = 100
+    )
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> key_dist(key_lhs, key_rhs);
+        auto get_random_key = [&]() { return key_dist(gen); };
+
+        Tree tree;
+        std::set<int> rb_tree;
+
+        for (std::size_t iter = 0; iter < number_of_iterations; iter++)
+        {
+            for (std::size_t ins = 0; ins < operations_per_iteration; ins++)
+            {
+                const auto key = get_random_key();
+                tree.insert(key);
+                rb_tree.insert(key);
+            }
+
+            const auto frozen = tree.freeze();
+            REQUIRE(frozen.size() == rb_tree.size());
+
+            auto rb_it = rb_tree.cbegin();
+            for (auto frozen_element : frozen)
+            {
+                REQUIRE(frozen_element == *rb_it++);
+            }
+
+            for (std::size_t find = 0; find < operations_per_iteration; find++)
+            {
+                const auto key = get_random_key();
+
+                const bool found_in_frozen = (frozen.find(key) != frozen.end());
+                const bool found_in_rb = (rb_tree.find(key) != rb_tree.end());
+                REQUIRE(found_in_frozen == found_in_rb);
+
+                const auto frozen_bound = frozen.lower_bound(key);
+                const auto rb_bound = rb_tree.lower_bound(key);
+                REQUIRE((frozen_bound == frozen.end()) == (rb_bound == rb_tree.end()));
+                if (rb_bound != rb_tree.end())
+                {
+                    REQUIRE(*frozen_bound == *rb_bound);
+                }
+
+                const auto rb_rank = static_cast<std::size_t>(std::distance(rb_tree.begin(), rb_bound));
+                REQUIRE(frozen.rank(key) == rb_rank);
+            }
+        }
+    }
+
+    template <typename StaticSet>
+    void stress_simd_static(unsigned int seed,
+                            typename StaticSet::isa_type isa,
+                            std::size_t number_of_iterations = 20,
+                            std::size_t max_size = 5000,
+                            std::size_t finds_per_iteration = 1000
+    )
+    {
+        using Key = typename StaticSet::key_type;
+
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<std::size_t> size_dist(0, max_size);
+        std::uniform_int_distribution<Key> key_dist(std::numeric_limits<Key>::min(),
+                                                    std::numeric_limits<Key>::max());
+
+        for (std::size_t iter = 0; iter < number_of_iterations; iter++)
+        {
+            // a narrow range makes hits likely, extremes check the padding of the last block
+            const Key range = static_cast<Key>(2 * max_size);
+            std::uniform_int_distribution<Key> narrow_dist(-range, range);
+
+            std::set<Key> rb_tree = {std::numeric_limits<Key>::max()};
+            const std::size_t size = size_dist(gen);
+            while (rb_tree.size() < size)
+            {
+                rb_tree.insert(iter % 2 == 0 ? narrow_dist(gen) : key_dist(gen));
+            }
+
+            const StaticSet frozen(rb_tree.begin(), rb_tree.end(), isa);
+            REQUIRE(frozen.size() == rb_tree.size());
+            REQUIRE(std::equal(frozen.begin(), frozen.end(), rb_tree.begin(), rb_tree.end()));
+
+            std::vector<Key> keys;
+            for (std::size_t find = 0; find < finds_per_iteration; find++)
+            {
+                keys.push_back(find % 2 == 0 ? narrow_dist(gen) : key_dist(gen));
+            }
+            keys.push_back(std::numeric_limits<Key>::min());
+            keys.push_back(std::numeric_limits<Key>::max());
+
+            std::vector<std::size_t> ranks(keys.size());
+            frozen.batch_rank(keys.data(), keys.size(), ranks.data());
+
+            for (std::size_t i = 0; i < keys.size(); i++)
+            {
+                const Key key = keys[i];
+                const auto rb_bound = rb_tree.lower_bound(key);
+                const auto rb_rank = static_cast<std::size_t>(std::distance(rb_tree.begin(), rb_bound));
+
+                REQUIRE(frozen.rank(key) == rb_rank);
+                REQUIRE(ranks[i] == rb_rank);
+                REQUIRE(frozen.contains(key) == (rb_tree.count(key) == 1));
+            }
+        }
+    }
+
+    // random inserts and erases of keys up to key_max, checking every query against std::set
+    template <typename Set, typename Comparator>
+    void stress_successor(Comparator cmp_sets,
+                          unsigned int seed,
+                          std::uint32_t key_max,
+                          std::size_t number_of_iterations = 20,
+                          std::size_t operations_per_iteration = 1000
+    )
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<std::uint32_t> key_dist(0, key_max);
+        std::uniform_int_distribution<> operation_dist(0, 99);
+
+        Set set;
+        std::set<std::uint32_t> rb_tree;
+
+        for (std::size_t iter = 0; iter < number_of_iterations; iter++)
+        {
+            for (std::size_t op = 0; op < operations_per_iteration; op++)
+            {
+                const auto key = key_dist(gen);
+                switch (get_operation(operation_dist(gen)))
+                {
+                    case eOperation::insert:
+                    {
+                        REQUIRE(set.insert(key) == rb_tree.insert(key).second);
+                        break;
+                    }
+                    case eOperation::erase:
+                    {
+                        REQUIRE(set.erase(key) == (rb_tree.erase(key) == 1));
+                        break;
+                    }
+                    case eOperation::find:
+                    {
+                        REQUIRE(set.contains(key) == (rb_tree.count(key) == 1));
+                        REQUIRE((set.find(key) != set.end()) == (rb_tree.find(key) != rb_tree.end()));
+                        break;
+                    }
+                }
+
+                const auto value = key_dist(gen);
+
+                const auto rb_next = rb_tree.upper_bound(value);
+                const auto next = set.successor(value);
+                REQUIRE(next.has_value() == (rb_next != rb_tree.end()));
+                if (next.has_value())
+                {
+                    REQUIRE(*next == *rb_next);
+                }
+
+                const auto rb_bound = rb_tree.lower_bound(value);
+                const auto previous = set.predecessor(value);
+                REQUIRE(previous.has_value() == (rb_bound != rb_tree.begin()));
+                if (previous.has_value())
+                {
+                    REQUIRE(*previous == *std::prev(rb_bound));
+                }
+
+                const auto bound = set.lower_bound(value);
+                const bool bound_found = bound != set.end();
+                REQUIRE(bound_found == (rb_bound != rb_tree.end()));
+                if (bound_found)
+                {
+                    REQUIRE(*bound == *rb_bound);
+                }
+            }
+
+            cmp_sets(set, rb_tree);
+
+            // half of the sets are emptied by erases, which also frees the clusters
+            if (iter % 2 == 0)
+            {
+                set.clear();
+                rb_tree.clear();
+            }
+            else
+            {
+                const std::vector<std::uint32_t> keys(rb_tree.begin(), rb_tree.end());
+                for (auto key : keys)
+                {
+                    REQUIRE(set.erase(key));
+                    rb_tree.erase(key);
+                }
+                cmp_sets(set, rb_tree);
+            }
+        }
+    }
+
+
+    // Skewed finds on a Tree with access counting on: its access_weights have to match the hits,
+    // and the Weighted tree built from them has to hold the keys with every key of weight w
+    // no deeper than log2(W / w) + 1.
+    template <typename Tree, typename Weighted>
+    void stress_access_weights(unsigned int seed,
+                               int key_count = 1000,
+                               std::size_t number_of_iterations = 20,
+                               std::size_t finds_per_iteration = 5000
+    )
+    {
+        std::mt19937 gen(seed);
+        std::geometric_distribution<> rank_dist(0.02);
+        std::uniform_int_distribution<> key_dist(0, 2 * key_count);
+
+        for (std::size_t iter = 0; iter < number_of_iterations; iter++)
+        {
+            Tree tree;
+            std::set<int> rb_tree;
+            while (rb_tree.size() < static_cast<std::size_t>(key_count))
+            {
+                const auto key = key_dist(gen);
+                tree.insert(key);
+                rb_tree.insert(key);
+            }
+
+            // hot keys spread over the whole key range
+            std::vector<int> by_rank(rb_tree.begin(), rb_tree.end());
+            std::shuffle(by_rank.begin(), by_rank.end(), gen);
+
+            // switching the counting on again starts from zero
+            tree.set_access_counting(true);
+            tree.find(by_rank.front());
+            tree.set_access_counting(true);
+
+            std::map<int, std::size_t> hits;
+            for (std::size_t find = 0; find < finds_per_iteration; find++)
+            {
+                const auto rank = std::min<std::size_t>(rank_dist(gen), by_rank.size() - 1);
+                const auto key = rank % 7 == 6 ? key_dist(gen) : by_rank[rank];
+
+                const bool found_in_tree = tree.find(key) != tree.end();
+                REQUIRE(found_in_tree == (rb_tree.count(key) == 1));
+                if (found_in_tree)
+                {
+                    hits[key]++;
+                }
+            }
+
+            const auto weights = tree.access_weights();
+            REQUIRE(weights.size() == rb_tree.size());
+            auto rb_it = rb_tree.cbegin();
+            for (const auto& [key, weight] : weights)
+            {
+                REQUIRE(key == *rb_it++);
+                REQUIRE(weight == (hits.count(key) == 1 ? hits[key] : 0));
+            }
+
+            const Weighted weighted(weights.begin(), weights.end());
+            REQUIRE(weighted.size() == rb_tree.size());
+            REQUIRE(weighted.is_search_tree());
+
+            rb_it = rb_tree.cbegin();
+            for (auto weighted_element : weighted)
+            {
+                REQUIRE(weighted_element == *rb_it++);
+            }
+
+            double total = 0;
+            for (const auto& [key, weight] : hits)
+            {
+                total += static_cast<double>(weight);
+            }
+
+            double weighted_depth = 0;
+            for (const auto& [key, weight] : weights)
+            {
+                const auto depth = weighted.depth(key);
+                REQUIRE(depth >= 1);
+                REQUIRE(weighted.contains(key));
+                if (weight > 0)
+                {
+                    REQUIRE(static_cast<double>(depth) <= std::log2(total / static_cast<double>(weight)) + 1 + 1e-9);
+                }
+                weighted_depth += static_cast<double>(weight * depth);
+            }
+            REQUIRE(std::abs(weighted.expected_depth() - weighted_depth / total) < 1e-9);
+
+            for (std::size_t find = 0; find < finds_per_iteration; find++)
+            {
+                const auto key = key_dist(gen);
+                const bool found_in_weighted = weighted.find(key) != weighted.end();
+                REQUIRE(found_in_weighted == (rb_tree.count(key) == 1));
+                if (found_in_weighted)
+                {
+                    REQUIRE(*weighted.find(key) == key);
+                }
+            }
+        }
+    }
+
+
+    template <typename Tree, typename Comparator, typename Policy>
+    void stress_apply_batch(Comparator cmp_trees,
+                            unsigned int seed,
+                            const Policy& policy,
+                            int key_lhs = -3000, int key_rhs = 3000,
+                            std::size_t number_of_iterations = 10,
+                            std::size_t batch_size = 4000
+    )
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> key_dist(key_lhs, key_rhs);
+        std::uniform_int_distribution<> kind_dist(0, 2);
+
+        Tree batched_tree;
+        std::set<int> rb_tree;
+        for (std::size_t iter = 0; iter < number_of_iterations; iter++)
+        {
+            // mostly inserts at first, mostly erases later, with repeated keys throughout
+            std::vector<tree::batch_operation<int>> batch;
+            batch.reserve(batch_size);
+            for (std::size_t op = 0; op < batch_size; op++)
+            {
+                const bool is_insert = (kind_dist(gen) == 0) == (iter >= number_of_iterations / 2);
+                batch.push_back({is_insert ? tree::batch_kind::insert : tree::batch_kind::erase, key_dist(gen)});
+            }
+
+            const auto results = batched_tree.apply_batch(batch, policy);
+            REQUIRE(results.size() == batch.size());
+            for (std::size_t op = 0; op < batch.size(); op++)
+            {
+                const bool changed = batch[op].kind == tree::batch_kind::insert
+                                     ? rb_tree.insert(batch[op].key).second
+                                     : rb_tree.erase(batch[op].key) == 1;
+                REQUIRE(results[op] == changed);
+            }
+
+            cmp_trees(batched_tree, rb_tree);
+        }
+
+        REQUIRE(batched_tree.apply_batch({}, policy).empty());
+        cmp_trees(batched_tree, rb_tree);
+    }
+
+
+    template <typename Tree, typename Comparator, typename Policy>
+    void stress_from_unsorted(Comparator cmp_trees,
+                              unsigned int seed,
+                              const Policy& policy
+    )
+    {
+        std::mt19937 gen(seed);
+
+        // up to a few times the grain of the parallel sort, with many duplicates or almost none
+        for (std::size_t size : {0, 1, 1000, 100'000})
+        {
+            for (int range : {100, 1'000'000})
+            {
+                std::uniform_int_distribution<> key_dist(-range, range);
+                std::vector<int> keys(size);
+                for (auto& key : keys)
+                {
+                    key = key_dist(gen);
+                }
+
+                Tree tree = Tree::from_unsorted(keys.begin(), keys.end(), policy);
+                std::set<int> rb_tree(keys.begin(), keys.end());
+                cmp_trees(tree, rb_tree);
+
+                // the tree goes on like any other
+                for (std::size_t op = 0; op < 1000; op++)
+                {
+                    const auto key = key_dist(gen);
+                    if (op % 2 == 0)
+                    {
+                        tree.insert(key);
+                        rb_tree.insert(key);
+                    }
+                    else
+                    {
+                        tree.erase(key);
+                        rb_tree.erase(key);
+                    }
+                }
+                cmp_trees(tree, rb_tree);
+            }
+        }
+    }
+
+
+    template <typename Tree, typename Comparator, typename Policy>
+    void stress_traversal(Comparator cmp_trees,
+                          unsigned int seed,
+                          const Policy& policy
+    )
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> key_dist(-1'000'000, 1'000'000);
+
+        // for_each goes in order only under the sequential policy
+        constexpr bool is_in_order = std::is_same_v<Policy, tree::sequenced_policy>;
+
+        // a polynomial hash of the keys in order with the power of the base it is at,
+        // associative but not commutative, so reduce has to keep the order
+        using hash = std::pair<std::uint64_t, std::uint64_t>;
+        const auto accumulate = [](hash value, int key)
+        {
+            return hash{value.first * 1'000'003 + static_cast<std::uint64_t>(key), value.second * 1'000'003};
+        };
+        const auto combine = [](hash lhs, hash rhs)
+        {
+            return hash{lhs.first * rhs.second + rhs.first, lhs.second * rhs.second};
+        };
+
+        // up to a few times the grain, grown by inserts and erases so that a splay tree is skewed
+        for (std::size_t size : {0, 1, 1000, 100'000})
+        {
+            Tree tree;
+            std::set<int> rb_tree;
+            for (std::size_t op = 0; op < size; op++)
+            {
+                const auto key = key_dist(gen);
+                if (op % 4 == 3 && !rb_tree.empty())
+                {
+                    const auto erased = *rb_tree.lower_bound(std::min(key, *rb_tree.rbegin()));
+                    tree.erase(erased);
+                    rb_tree.erase(erased);
+                }
+                else
+                {
+                    tree.insert(key);
+                    rb_tree.insert(key);
+                }
+            }
+            const std::vector<int> keys(rb_tree.begin(), rb_tree.end());
+
+            std::mutex mutex;
+            std::vector<int> visited;
+            tree.for_each([&](const int& key)
+            {
+                std::lock_guard lock(mutex);
+                visited.push_back(key);
+            }, policy);
+            if constexpr (!is_in_order)
+            {
+                std::sort(visited.begin(), visited.end());
+            }
+            REQUIRE(visited == keys);
+
+            const auto expected = std::accumulate(keys.begin(), keys.end(), hash{0, 1}, accumulate);
+            REQUIRE(tree.reduce(hash{0, 1}, accumulate, combine, policy) == expected);
+
+            // the same shape, and nodes of its own
+            Tree copy = tree.clone(policy);
+            cmp_trees(copy, rb_tree);
+            for (std::size_t index = 0; index < keys.size(); index += 97)
+            {
+                REQUIRE(copy.depth(keys[index]) == tree.depth(keys[index]));
+            }
+
+            std::set<int> rb_copy = rb_tree;
+            for (std::size_t op = 0; op < 1000; op++)
+            {
+                const auto key = key_dist(gen);
+                if (op % 2 == 0)
+                {
+                    copy.insert(key);
+                    rb_copy.insert(key);
+                }
+                else
+                {
+                    copy.erase(key);
+                    rb_copy.erase(key);
+                }
+            }
+            cmp_trees(copy, rb_copy);
+            cmp_trees(tree, rb_tree);
+        }
+    }
+
 } // namespace tree::testing